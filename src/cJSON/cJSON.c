@@ -49,6 +49,16 @@
 #include <locale.h>
 #endif
 
+/* SSE2 comes with every x86-64 CPU, AVX2 is picked at runtime */
+#if !defined(CJSON_DISABLE_SIMD) && (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__)
+#define CJSON_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(__clang__) || (__GNUC__ >= 5)
+#define CJSON_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
 #if defined(_MSC_VER)
 #pragma warning (pop)
 #endif
@@ -113,7 +123,7 @@ CJSON_PUBLIC(double) cJSON_GetNumberValue(const cJSON * const item)
         return (double) NAN;
     }
 
-    return item->valuedouble;
+    return cJSON_ValueDouble(item);
 }
 
 /* This is a safeguard to prevent copy-pasters from using incompatible C and header files */
@@ -185,6 +195,10 @@ static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
 
 static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc };
 
+static char *(CJSON_CDECL *intern_key)(const char *key) = NULL;
+
+static cJSON_IndexHooks index_hooks = { NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+
 static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
 {
     size_t length = 0;
@@ -235,6 +249,81 @@ CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
     }
 }
 
+CJSON_PUBLIC(void) cJSON_InitInternHook(char *(CJSON_CDECL *intern_fn)(const char *key))
+{
+    intern_key = intern_fn;
+}
+
+/* Swap the name owned by item for the shared copy, if the intern hook has one */
+static void intern_item_string(cJSON * const item)
+{
+    char *shared = NULL;
+
+    if ((intern_key == NULL) || (item->string == NULL) || (item->type & cJSON_StringIsConst))
+    {
+        return;
+    }
+
+    shared = intern_key(item->string);
+    if (shared != NULL)
+    {
+        global_hooks.deallocate(item->string);
+        item->string = shared;
+        item->type |= cJSON_StringIsConst;
+    }
+}
+
+#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
+    #pragma GCC diagnostic push
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wcast-qual"
+#endif
+/* helper function to cast away const */
+static void* cast_away_const(const void* string)
+{
+    return (void*)string;
+}
+#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
+    #pragma GCC diagnostic pop
+#endif
+
+CJSON_PUBLIC(void) cJSON_InitIndexHooks(const cJSON_IndexHooks *hooks)
+{
+    if (hooks == NULL)
+    {
+        memset(&index_hooks, '\0', sizeof(index_hooks));
+        return;
+    }
+
+    index_hooks = *hooks;
+}
+
+CJSON_PUBLIC(void) cJSON_DropIndex(cJSON * const item)
+{
+    if ((item == NULL) || !(item->type & cJSON_IsIndexed))
+    {
+        return;
+    }
+
+    if (index_hooks.drop != NULL)
+    {
+        index_hooks.drop(item);
+    }
+    item->type &= ~cJSON_IsIndexed;
+}
+
+/* Ask the index hooks to index an array or object, returns whether it is indexed now */
+static cJSON_bool index_item(cJSON * const item)
+{
+    if ((index_hooks.build == NULL) || !(cJSON_IsArray(item) || cJSON_IsObject(item)) || (item->type & cJSON_IsReference))
+    {
+        return false;
+    }
+
+    return (item->type & cJSON_IsIndexed) || index_hooks.build(item);
+}
+
 /* Internal constructor. */
 static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
 {
@@ -254,11 +343,12 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
     while (item != NULL)
     {
         next = item->next;
-        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
+        cJSON_DropIndex(item);
+        if (!(item->type & cJSON_IsReference) && (cJSON_Child(item) != NULL))
         {
             cJSON_Delete(item->child);
         }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+        if (!(item->type & cJSON_IsReference) && (cJSON_ValueString(item) != NULL))
         {
             global_hooks.deallocate(item->valuestring);
             item->valuestring = NULL;
@@ -301,60 +391,988 @@ typedef struct
 /* get a pointer to the buffer at the position */
 #define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
 
+#if defined(__GNUC__) || defined(__clang__)
+__extension__ typedef unsigned long long cjson_uint64;
+#else
+typedef unsigned long long cjson_uint64;
+#endif
+#define CJSON_INT64_MAX ((cJSON_int64)((~(cjson_uint64)0) >> 1))
+#define CJSON_INT64_MIN (-CJSON_INT64_MAX - 1)
+
+/* 10^k for k = -292 ... 324, as the upper 128 bits of its binary significand
+ * rounded up, most significant 32 bits first (generated with exact rational
+ * arithmetic, used to convert numbers in both directions) */
+static const unsigned long powers_of_ten_significand[][4] =
+{
+    { 0xff77b1fcUL, 0xbebcdc4fUL, 0x25e8e89cUL, 0x13bb0f7bUL },
+    { 0x9faacf3dUL, 0xf73609b1UL, 0x77b19161UL, 0x8c54e9adUL },
+    { 0xc795830dUL, 0x75038c1dUL, 0xd59df5b9UL, 0xef6a2418UL },
+    { 0xf97ae3d0UL, 0xd2446f25UL, 0x4b057328UL, 0x6b44ad1eUL },
+    { 0x9becce62UL, 0x836ac577UL, 0x4ee367f9UL, 0x430aec33UL },
+    { 0xc2e801fbUL, 0x244576d5UL, 0x229c41f7UL, 0x93cda740UL },
+    { 0xf3a20279UL, 0xed56d48aUL, 0x6b435275UL, 0x78c11110UL },
+    { 0x9845418cUL, 0x345644d6UL, 0x830a1389UL, 0x6b78aaaaUL },
+    { 0xbe5691efUL, 0x416bd60cUL, 0x23cc986bUL, 0xc656d554UL },
+    { 0xedec366bUL, 0x11c6cb8fUL, 0x2cbfbe86UL, 0xb7ec8aa9UL },
+    { 0x94b3a202UL, 0xeb1c3f39UL, 0x7bf7d714UL, 0x32f3d6aaUL },
+    { 0xb9e08a83UL, 0xa5e34f07UL, 0xdaf5ccd9UL, 0x3fb0cc54UL },
+    { 0xe858ad24UL, 0x8f5c22c9UL, 0xd1b3400fUL, 0x8f9cff69UL },
+    { 0x91376c36UL, 0xd99995beUL, 0x23100809UL, 0xb9c21fa2UL },
+    { 0xb5854744UL, 0x8ffffb2dUL, 0xabd40a0cUL, 0x2832a78bUL },
+    { 0xe2e69915UL, 0xb3fff9f9UL, 0x16c90c8fUL, 0x323f516dUL },
+    { 0x8dd01fadUL, 0x907ffc3bUL, 0xae3da7d9UL, 0x7f6792e4UL },
+    { 0xb1442798UL, 0xf49ffb4aUL, 0x99cd11cfUL, 0xdf41779dUL },
+    { 0xdd95317fUL, 0x31c7fa1dUL, 0x40405643UL, 0xd711d584UL },
+    { 0x8a7d3eefUL, 0x7f1cfc52UL, 0x482835eaUL, 0x666b2573UL },
+    { 0xad1c8eabUL, 0x5ee43b66UL, 0xda324365UL, 0x0005eed0UL },
+    { 0xd863b256UL, 0x369d4a40UL, 0x90bed43eUL, 0x40076a83UL },
+    { 0x873e4f75UL, 0xe2224e68UL, 0x5a7744a6UL, 0xe804a292UL },
+    { 0xa90de353UL, 0x5aaae202UL, 0x711515d0UL, 0xa205cb37UL },
+    { 0xd3515c28UL, 0x31559a83UL, 0x0d5a5b44UL, 0xca873e04UL },
+    { 0x8412d999UL, 0x1ed58091UL, 0xe858790aUL, 0xfe9486c3UL },
+    { 0xa5178fffUL, 0x668ae0b6UL, 0x626e974dUL, 0xbe39a873UL },
+    { 0xce5d73ffUL, 0x402d98e3UL, 0xfb0a3d21UL, 0x2dc81290UL },
+    { 0x80fa687fUL, 0x881c7f8eUL, 0x7ce66634UL, 0xbc9d0b9aUL },
+    { 0xa139029fUL, 0x6a239f72UL, 0x1c1fffc1UL, 0xebc44e81UL },
+    { 0xc9874347UL, 0x44ac874eUL, 0xa327ffb2UL, 0x66b56221UL },
+    { 0xfbe91419UL, 0x15d7a922UL, 0x4bf1ff9fUL, 0x0062baa9UL },
+    { 0x9d71ac8fUL, 0xada6c9b5UL, 0x6f773fc3UL, 0x603db4aaUL },
+    { 0xc4ce17b3UL, 0x99107c22UL, 0xcb550fb4UL, 0x384d21d4UL },
+    { 0xf6019da0UL, 0x7f549b2bUL, 0x7e2a53a1UL, 0x46606a49UL },
+    { 0x99c10284UL, 0x4f94e0fbUL, 0x2eda7444UL, 0xcbfc426eUL },
+    { 0xc0314325UL, 0x637a1939UL, 0xfa911155UL, 0xfefb5309UL },
+    { 0xf03d93eeUL, 0xbc589f88UL, 0x793555abUL, 0x7eba27cbUL },
+    { 0x96267c75UL, 0x35b763b5UL, 0x4bc1558bUL, 0x2f3458dfUL },
+    { 0xbbb01b92UL, 0x83253ca2UL, 0x9eb1aaedUL, 0xfb016f17UL },
+    { 0xea9c2277UL, 0x23ee8bcbUL, 0x465e15a9UL, 0x79c1caddUL },
+    { 0x92a1958aUL, 0x7675175fUL, 0x0bfacd89UL, 0xec191ecaUL },
+    { 0xb749faedUL, 0x14125d36UL, 0xcef980ecUL, 0x671f667cUL },
+    { 0xe51c79a8UL, 0x5916f484UL, 0x82b7e127UL, 0x80e7401bUL },
+    { 0x8f31cc09UL, 0x37ae58d2UL, 0xd1b2ecb8UL, 0xb0908811UL },
+    { 0xb2fe3f0bUL, 0x8599ef07UL, 0x861fa7e6UL, 0xdcb4aa16UL },
+    { 0xdfbdceceUL, 0x67006ac9UL, 0x67a791e0UL, 0x93e1d49bUL },
+    { 0x8bd6a141UL, 0x006042bdUL, 0xe0c8bb2cUL, 0x5c6d24e1UL },
+    { 0xaecc4991UL, 0x4078536dUL, 0x58fae9f7UL, 0x73886e19UL },
+    { 0xda7f5bf5UL, 0x90966848UL, 0xaf39a475UL, 0x506a899fUL },
+    { 0x888f9979UL, 0x7a5e012dUL, 0x6d8406c9UL, 0x52429604UL },
+    { 0xaab37fd7UL, 0xd8f58178UL, 0xc8e5087bUL, 0xa6d33b84UL },
+    { 0xd5605fcdUL, 0xcf32e1d6UL, 0xfb1e4a9aUL, 0x90880a65UL },
+    { 0x855c3be0UL, 0xa17fcd26UL, 0x5cf2eea0UL, 0x9a550680UL },
+    { 0xa6b34ad8UL, 0xc9dfc06fUL, 0xf42faa48UL, 0xc0ea481fUL },
+    { 0xd0601d8eUL, 0xfc57b08bUL, 0xf13b94daUL, 0xf124da27UL },
+    { 0x823c1279UL, 0x5db6ce57UL, 0x76c53d08UL, 0xd6b70859UL },
+    { 0xa2cb1717UL, 0xb52481edUL, 0x54768c4bUL, 0x0c64ca6fUL },
+    { 0xcb7ddcddUL, 0xa26da268UL, 0xa9942f5dUL, 0xcf7dfd0aUL },
+    { 0xfe5d5415UL, 0x0b090b02UL, 0xd3f93b35UL, 0x435d7c4dUL },
+    { 0x9efa548dUL, 0x26e5a6e1UL, 0xc47bc501UL, 0x4a1a6db0UL },
+    { 0xc6b8e9b0UL, 0x709f109aUL, 0x359ab641UL, 0x9ca1091cUL },
+    { 0xf867241cUL, 0x8cc6d4c0UL, 0xc30163d2UL, 0x03c94b63UL },
+    { 0x9b407691UL, 0xd7fc44f8UL, 0x79e0de63UL, 0x425dcf1eUL },
+    { 0xc2109436UL, 0x4dfb5636UL, 0x985915fcUL, 0x12f542e5UL },
+    { 0xf294b943UL, 0xe17a2bc4UL, 0x3e6f5b7bUL, 0x17b2939eUL },
+    { 0x979cf3caUL, 0x6cec5b5aUL, 0xa705992cUL, 0xeecf9c43UL },
+    { 0xbd8430bdUL, 0x08277231UL, 0x50c6ff78UL, 0x2a838354UL },
+    { 0xece53cecUL, 0x4a314ebdUL, 0xa4f8bf56UL, 0x35246429UL },
+    { 0x940f4613UL, 0xae5ed136UL, 0x871b7795UL, 0xe136be9aUL },
+    { 0xb9131798UL, 0x99f68584UL, 0x28e2557bUL, 0x59846e40UL },
+    { 0xe757dd7eUL, 0xc07426e5UL, 0x331aeadaUL, 0x2fe589d0UL },
+    { 0x9096ea6fUL, 0x3848984fUL, 0x3ff0d2c8UL, 0x5def7622UL },
+    { 0xb4bca50bUL, 0x065abe63UL, 0x0fed077aUL, 0x756b53aaUL },
+    { 0xe1ebce4dUL, 0xc7f16dfbUL, 0xd3e84959UL, 0x12c62895UL },
+    { 0x8d3360f0UL, 0x9cf6e4bdUL, 0x64712dd7UL, 0xabbbd95dUL },
+    { 0xb080392cUL, 0xc4349decUL, 0xbd8d794dUL, 0x96aacfb4UL },
+    { 0xdca04777UL, 0xf541c567UL, 0xecf0d7a0UL, 0xfc5583a1UL },
+    { 0x89e42caaUL, 0xf9491b60UL, 0xf41686c4UL, 0x9db57245UL },
+    { 0xac5d37d5UL, 0xb79b6239UL, 0x311c2875UL, 0xc522ced6UL },
+    { 0xd77485cbUL, 0x25823ac7UL, 0x7d633293UL, 0x366b828cUL },
+    { 0x86a8d39eUL, 0xf77164bcUL, 0xae5dff9cUL, 0x02033198UL },
+    { 0xa8530886UL, 0xb54dbdebUL, 0xd9f57f83UL, 0x0283fdfdUL },
+    { 0xd267caa8UL, 0x62a12d66UL, 0xd072df63UL, 0xc324fd7cUL },
+    { 0x8380dea9UL, 0x3da4bc60UL, 0x4247cb9eUL, 0x59f71e6eUL },
+    { 0xa4611653UL, 0x8d0deb78UL, 0x52d9be85UL, 0xf074e609UL },
+    { 0xcd795be8UL, 0x70516656UL, 0x67902e27UL, 0x6c921f8cUL },
+    { 0x806bd971UL, 0x4632dff6UL, 0x00ba1cd8UL, 0xa3db53b7UL },
+    { 0xa086cfcdUL, 0x97bf97f3UL, 0x80e8a40eUL, 0xccd228a5UL },
+    { 0xc8a883c0UL, 0xfdaf7df0UL, 0x6122cd12UL, 0x8006b2ceUL },
+    { 0xfad2a4b1UL, 0x3d1b5d6cUL, 0x796b8057UL, 0x20085f82UL },
+    { 0x9cc3a6eeUL, 0xc6311a63UL, 0xcbe33036UL, 0x74053bb1UL },
+    { 0xc3f490aaUL, 0x77bd60fcUL, 0xbedbfc44UL, 0x11068a9dUL },
+    { 0xf4f1b4d5UL, 0x15acb93bUL, 0xee92fb55UL, 0x15482d45UL },
+    { 0x99171105UL, 0x2d8bf3c5UL, 0x751bdd15UL, 0x2d4d1c4bUL },
+    { 0xbf5cd546UL, 0x78eef0b6UL, 0xd262d45aUL, 0x78a0635eUL },
+    { 0xef340a98UL, 0x172aace4UL, 0x86fb8971UL, 0x16c87c35UL },
+    { 0x9580869fUL, 0x0e7aac0eUL, 0xd45d35e6UL, 0xae3d4da1UL },
+    { 0xbae0a846UL, 0xd2195712UL, 0x89748360UL, 0x59cca10aUL },
+    { 0xe998d258UL, 0x869facd7UL, 0x2bd1a438UL, 0x703fc94cUL },
+    { 0x91ff8377UL, 0x5423cc06UL, 0x7b6306a3UL, 0x4627ddd0UL },
+    { 0xb67f6455UL, 0x292cbf08UL, 0x1a3bc84cUL, 0x17b1d543UL },
+    { 0xe41f3d6aUL, 0x7377eecaUL, 0x20caba5fUL, 0x1d9e4a94UL },
+    { 0x8e938662UL, 0x882af53eUL, 0x547eb47bUL, 0x7282ee9dUL },
+    { 0xb23867fbUL, 0x2a35b28dUL, 0xe99e619aUL, 0x4f23aa44UL },
+    { 0xdec681f9UL, 0xf4c31f31UL, 0x6405fa00UL, 0xe2ec94d5UL },
+    { 0x8b3c113cUL, 0x38f9f37eUL, 0xde83bc40UL, 0x8dd3dd05UL },
+    { 0xae0b158bUL, 0x4738705eUL, 0x9624ab50UL, 0xb148d446UL },
+    { 0xd98ddaeeUL, 0x19068c76UL, 0x3badd624UL, 0xdd9b0958UL },
+    { 0x87f8a8d4UL, 0xcfa417c9UL, 0xe54ca5d7UL, 0x0a80e5d7UL },
+    { 0xa9f6d30aUL, 0x038d1dbcUL, 0x5e9fcf4cUL, 0xcd211f4dUL },
+    { 0xd47487ccUL, 0x8470652bUL, 0x7647c320UL, 0x00696720UL },
+    { 0x84c8d4dfUL, 0xd2c63f3bUL, 0x29ecd9f4UL, 0x0041e074UL },
+    { 0xa5fb0a17UL, 0xc777cf09UL, 0xf4681071UL, 0x00525891UL },
+    { 0xcf79cc9dUL, 0xb955c2ccUL, 0x7182148dUL, 0x4066eeb5UL },
+    { 0x81ac1fe2UL, 0x93d599bfUL, 0xc6f14cd8UL, 0x48405531UL },
+    { 0xa21727dbUL, 0x38cb002fUL, 0xb8ada00eUL, 0x5a506a7dUL },
+    { 0xca9cf1d2UL, 0x06fdc03bUL, 0xa6d90811UL, 0xf0e4851dUL },
+    { 0xfd442e46UL, 0x88bd304aUL, 0x908f4a16UL, 0x6d1da664UL },
+    { 0x9e4a9cecUL, 0x15763e2eUL, 0x9a598e4eUL, 0x043287ffUL },
+    { 0xc5dd4427UL, 0x1ad3cdbaUL, 0x40eff1e1UL, 0x853f29feUL },
+    { 0xf7549530UL, 0xe188c128UL, 0xd12bee59UL, 0xe68ef47dUL },
+    { 0x9a94dd3eUL, 0x8cf578b9UL, 0x82bb74f8UL, 0x301958cfUL },
+    { 0xc13a148eUL, 0x3032d6e7UL, 0xe36a5236UL, 0x3c1faf02UL },
+    { 0xf18899b1UL, 0xbc3f8ca1UL, 0xdc44e6c3UL, 0xcb279ac2UL },
+    { 0x96f5600fUL, 0x15a7b7e5UL, 0x29ab103aUL, 0x5ef8c0baUL },
+    { 0xbcb2b812UL, 0xdb11a5deUL, 0x7415d448UL, 0xf6b6f0e8UL },
+    { 0xebdf6617UL, 0x91d60f56UL, 0x111b495bUL, 0x3464ad22UL },
+    { 0x936b9fceUL, 0xbb25c995UL, 0xcab10dd9UL, 0x00beec35UL },
+    { 0xb84687c2UL, 0x69ef3bfbUL, 0x3d5d514fUL, 0x40eea743UL },
+    { 0xe65829b3UL, 0x046b0afaUL, 0x0cb4a5a3UL, 0x112a5113UL },
+    { 0x8ff71a0fUL, 0xe2c2e6dcUL, 0x47f0e785UL, 0xeaba72acUL },
+    { 0xb3f4e093UL, 0xdb73a093UL, 0x59ed2167UL, 0x65690f57UL },
+    { 0xe0f218b8UL, 0xd25088b8UL, 0x306869c1UL, 0x3ec3532dUL },
+    { 0x8c974f73UL, 0x83725573UL, 0x1e414218UL, 0xc73a13fcUL },
+    { 0xafbd2350UL, 0x644eeacfUL, 0xe5d1929eUL, 0xf90898fbUL },
+    { 0xdbac6c24UL, 0x7d62a583UL, 0xdf45f746UL, 0xb74abf3aUL },
+    { 0x894bc396UL, 0xce5da772UL, 0x6b8bba8cUL, 0x328eb784UL },
+    { 0xab9eb47cUL, 0x81f5114fUL, 0x066ea92fUL, 0x3f326565UL },
+    { 0xd686619bUL, 0xa27255a2UL, 0xc80a537bUL, 0x0efefebeUL },
+    { 0x8613fd01UL, 0x45877585UL, 0xbd06742cUL, 0xe95f5f37UL },
+    { 0xa798fc41UL, 0x96e952e7UL, 0x2c481138UL, 0x23b73705UL },
+    { 0xd17f3b51UL, 0xfca3a7a0UL, 0xf75a1586UL, 0x2ca504c6UL },
+    { 0x82ef8513UL, 0x3de648c4UL, 0x9a984d73UL, 0xdbe722fcUL },
+    { 0xa3ab6658UL, 0x0d5fdaf5UL, 0xc13e60d0UL, 0xd2e0ebbbUL },
+    { 0xcc963feeUL, 0x10b7d1b3UL, 0x318df905UL, 0x079926a9UL },
+    { 0xffbbcfe9UL, 0x94e5c61fUL, 0xfdf17746UL, 0x497f7053UL },
+    { 0x9fd561f1UL, 0xfd0f9bd3UL, 0xfeb6ea8bUL, 0xedefa634UL },
+    { 0xc7caba6eUL, 0x7c5382c8UL, 0xfe64a52eUL, 0xe96b8fc1UL },
+    { 0xf9bd690aUL, 0x1b68637bUL, 0x3dfdce7aUL, 0xa3c673b1UL },
+    { 0x9c1661a6UL, 0x51213e2dUL, 0x06bea10cUL, 0xa65c084fUL },
+    { 0xc31bfa0fUL, 0xe5698db8UL, 0x486e494fUL, 0xcff30a63UL },
+    { 0xf3e2f893UL, 0xdec3f126UL, 0x5a89dba3UL, 0xc3efccfbUL },
+    { 0x986ddb5cUL, 0x6b3a76b7UL, 0xf8962946UL, 0x5a75e01dUL },
+    { 0xbe895233UL, 0x86091465UL, 0xf6bbb397UL, 0xf1135824UL },
+    { 0xee2ba6c0UL, 0x678b597fUL, 0x746aa07dUL, 0xed582e2dUL },
+    { 0x94db4838UL, 0x40b717efUL, 0xa8c2a44eUL, 0xb4571cddUL },
+    { 0xba121a46UL, 0x50e4ddebUL, 0x92f34d62UL, 0x616ce414UL },
+    { 0xe896a0d7UL, 0xe51e1566UL, 0x77b020baUL, 0xf9c81d18UL },
+    { 0x915e2486UL, 0xef32cd60UL, 0x0ace1474UL, 0xdc1d122fUL },
+    { 0xb5b5ada8UL, 0xaaff80b8UL, 0x0d819992UL, 0x132456bbUL },
+    { 0xe3231912UL, 0xd5bf60e6UL, 0x10e1fff6UL, 0x97ed6c6aUL },
+    { 0x8df5efabUL, 0xc5979c8fUL, 0xca8d3ffaUL, 0x1ef463c2UL },
+    { 0xb1736b96UL, 0xb6fd83b3UL, 0xbd308ff8UL, 0xa6b17cb3UL },
+    { 0xddd0467cUL, 0x64bce4a0UL, 0xac7cb3f6UL, 0xd05ddbdfUL },
+    { 0x8aa22c0dUL, 0xbef60ee4UL, 0x6bcdf07aUL, 0x423aa96cUL },
+    { 0xad4ab711UL, 0x2eb3929dUL, 0x86c16c98UL, 0xd2c953c7UL },
+    { 0xd89d64d5UL, 0x7a607744UL, 0xe871c7bfUL, 0x077ba8b8UL },
+    { 0x87625f05UL, 0x6c7c4a8bUL, 0x11471cd7UL, 0x64ad4973UL },
+    { 0xa93af6c6UL, 0xc79b5d2dUL, 0xd598e40dUL, 0x3dd89bd0UL },
+    { 0xd389b478UL, 0x79823479UL, 0x4aff1d10UL, 0x8d4ec2c4UL },
+    { 0x843610cbUL, 0x4bf160cbUL, 0xcedf722aUL, 0x585139bbUL },
+    { 0xa54394feUL, 0x1eedb8feUL, 0xc2974eb4UL, 0xee658829UL },
+    { 0xce947a3dUL, 0xa6a9273eUL, 0x733d2262UL, 0x29feea33UL },
+    { 0x811ccc66UL, 0x8829b887UL, 0x0806357dUL, 0x5a3f5260UL },
+    { 0xa163ff80UL, 0x2a3426a8UL, 0xca07c2dcUL, 0xb0cf26f8UL },
+    { 0xc9bcff60UL, 0x34c13052UL, 0xfc89b393UL, 0xdd02f0b6UL },
+    { 0xfc2c3f38UL, 0x41f17c67UL, 0xbbac2078UL, 0xd443ace3UL },
+    { 0x9d9ba783UL, 0x2936edc0UL, 0xd54b944bUL, 0x84aa4c0eUL },
+    { 0xc5029163UL, 0xf384a931UL, 0x0a9e795eUL, 0x65d4df12UL },
+    { 0xf64335bcUL, 0xf065d37dUL, 0x4d4617b5UL, 0xff4a16d6UL },
+    { 0x99ea0196UL, 0x163fa42eUL, 0x504bced1UL, 0xbf8e4e46UL },
+    { 0xc06481fbUL, 0x9bcf8d39UL, 0xe45ec286UL, 0x2f71e1d7UL },
+    { 0xf07da27aUL, 0x82c37088UL, 0x5d767327UL, 0xbb4e5a4dUL },
+    { 0x964e858cUL, 0x91ba2655UL, 0x3a6a07f8UL, 0xd510f870UL },
+    { 0xbbe226efUL, 0xb628afeaUL, 0x890489f7UL, 0x0a55368cUL },
+    { 0xeadab0abUL, 0xa3b2dbe5UL, 0x2b45ac74UL, 0xccea842fUL },
+    { 0x92c8ae6bUL, 0x464fc96fUL, 0x3b0b8bc9UL, 0x0012929eUL },
+    { 0xb77ada06UL, 0x17e3bbcbUL, 0x09ce6ebbUL, 0x40173745UL },
+    { 0xe5599087UL, 0x9ddcaabdUL, 0xcc420a6aUL, 0x101d0516UL },
+    { 0x8f57fa54UL, 0xc2a9eab6UL, 0x9fa94682UL, 0x4a12232eUL },
+    { 0xb32df8e9UL, 0xf3546564UL, 0x47939822UL, 0xdc96abfaUL },
+    { 0xdff97724UL, 0x70297ebdUL, 0x59787e2bUL, 0x93bc56f8UL },
+    { 0x8bfbea76UL, 0xc619ef36UL, 0x57eb4edbUL, 0x3c55b65bUL },
+    { 0xaefae514UL, 0x77a06b03UL, 0xede62292UL, 0x0b6b23f2UL },
+    { 0xdab99e59UL, 0x958885c4UL, 0xe95fab36UL, 0x8e45eceeUL },
+    { 0x88b402f7UL, 0xfd75539bUL, 0x11dbcb02UL, 0x18ebb415UL },
+    { 0xaae103b5UL, 0xfcd2a881UL, 0xd652bdc2UL, 0x9f26a11aUL },
+    { 0xd59944a3UL, 0x7c0752a2UL, 0x4be76d33UL, 0x46f04960UL },
+    { 0x857fcae6UL, 0x2d8493a5UL, 0x6f70a440UL, 0x0c562ddcUL },
+    { 0xa6dfbd9fUL, 0xb8e5b88eUL, 0xcb4ccd50UL, 0x0f6bb953UL },
+    { 0xd097ad07UL, 0xa71f26b2UL, 0x7e2000a4UL, 0x1346a7a8UL },
+    { 0x825ecc24UL, 0xc873782fUL, 0x8ed40066UL, 0x8c0c28c9UL },
+    { 0xa2f67f2dUL, 0xfa90563bUL, 0x72890080UL, 0x2f0f32fbUL },
+    { 0xcbb41ef9UL, 0x79346bcaUL, 0x4f2b40a0UL, 0x3ad2ffbaUL },
+    { 0xfea126b7UL, 0xd78186bcUL, 0xe2f610c8UL, 0x4987bfa9UL },
+    { 0x9f24b832UL, 0xe6b0f436UL, 0x0dd9ca7dUL, 0x2df4d7caUL },
+    { 0xc6ede63fUL, 0xa05d3143UL, 0x91503d1cUL, 0x79720dbcUL },
+    { 0xf8a95fcfUL, 0x88747d94UL, 0x75a44c63UL, 0x97ce912bUL },
+    { 0x9b69dbe1UL, 0xb548ce7cUL, 0xc986afbeUL, 0x3ee11abbUL },
+    { 0xc24452daUL, 0x229b021bUL, 0xfbe85badUL, 0xce996169UL },
+    { 0xf2d56790UL, 0xab41c2a2UL, 0xfae27299UL, 0x423fb9c4UL },
+    { 0x97c560baUL, 0x6b0919a5UL, 0xdccd879fUL, 0xc967d41bUL },
+    { 0xbdb6b8e9UL, 0x05cb600fUL, 0x5400e987UL, 0xbbc1c921UL },
+    { 0xed246723UL, 0x473e3813UL, 0x290123e9UL, 0xaab23b69UL },
+    { 0x9436c076UL, 0x0c86e30bUL, 0xf9a0b672UL, 0x0aaf6522UL },
+    { 0xb9447093UL, 0x8fa89bceUL, 0xf808e40eUL, 0x8d5b3e6aUL },
+    { 0xe7958cb8UL, 0x7392c2c2UL, 0xb60b1d12UL, 0x30b20e05UL },
+    { 0x90bd77f3UL, 0x483bb9b9UL, 0xb1c6f22bUL, 0x5e6f48c3UL },
+    { 0xb4ecd5f0UL, 0x1a4aa828UL, 0x1e38aeb6UL, 0x360b1af4UL },
+    { 0xe2280b6cUL, 0x20dd5232UL, 0x25c6da63UL, 0xc38de1b1UL },
+    { 0x8d590723UL, 0x948a535fUL, 0x579c487eUL, 0x5a38ad0fUL },
+    { 0xb0af48ecUL, 0x79ace837UL, 0x2d835a9dUL, 0xf0c6d852UL },
+    { 0xdcdb1b27UL, 0x98182244UL, 0xf8e43145UL, 0x6cf88e66UL },
+    { 0x8a08f0f8UL, 0xbf0f156bUL, 0x1b8e9ecbUL, 0x641b5900UL },
+    { 0xac8b2d36UL, 0xeed2dac5UL, 0xe272467eUL, 0x3d222f40UL },
+    { 0xd7adf884UL, 0xaa879177UL, 0x5b0ed81dUL, 0xcc6abb10UL },
+    { 0x86ccbb52UL, 0xea94baeaUL, 0x98e94712UL, 0x9fc2b4eaUL },
+    { 0xa87fea27UL, 0xa539e9a5UL, 0x3f2398d7UL, 0x47b36225UL },
+    { 0xd29fe4b1UL, 0x8e88640eUL, 0x8eec7f0dUL, 0x19a03aaeUL },
+    { 0x83a3eeeeUL, 0xf9153e89UL, 0x1953cf68UL, 0x300424adUL },
+    { 0xa48ceaaaUL, 0xb75a8e2bUL, 0x5fa8c342UL, 0x3c052dd8UL },
+    { 0xcdb02555UL, 0x653131b6UL, 0x3792f412UL, 0xcb06794eUL },
+    { 0x808e1755UL, 0x5f3ebf11UL, 0xe2bbd88bUL, 0xbee40bd1UL },
+    { 0xa0b19d2aUL, 0xb70e6ed6UL, 0x5b6aceaeUL, 0xae9d0ec5UL },
+    { 0xc8de0475UL, 0x64d20a8bUL, 0xf245825aUL, 0x5a445276UL },
+    { 0xfb158592UL, 0xbe068d2eUL, 0xeed6e2f0UL, 0xf0d56713UL },
+    { 0x9ced737bUL, 0xb6c4183dUL, 0x55464dd6UL, 0x9685606cUL },
+    { 0xc428d05aUL, 0xa4751e4cUL, 0xaa97e14cUL, 0x3c26b887UL },
+    { 0xf5330471UL, 0x4d9265dfUL, 0xd53dd99fUL, 0x4b3066a9UL },
+    { 0x993fe2c6UL, 0xd07b7fabUL, 0xe546a803UL, 0x8efe402aUL },
+    { 0xbf8fdb78UL, 0x849a5f96UL, 0xde985204UL, 0x72bdd034UL },
+    { 0xef73d256UL, 0xa5c0f77cUL, 0x963e6685UL, 0x8f6d4441UL },
+    { 0x95a86376UL, 0x27989aadUL, 0xdde70013UL, 0x79a44aa9UL },
+    { 0xbb127c53UL, 0xb17ec159UL, 0x5560c018UL, 0x580d5d53UL },
+    { 0xe9d71b68UL, 0x9dde71afUL, 0xaab8f01eUL, 0x6e10b4a7UL },
+    { 0x92267121UL, 0x62ab070dUL, 0xcab39613UL, 0x04ca70e9UL },
+    { 0xb6b00d69UL, 0xbb55c8d1UL, 0x3d607b97UL, 0xc5fd0d23UL },
+    { 0xe45c10c4UL, 0x2a2b3b05UL, 0x8cb89a7dUL, 0xb77c506bUL },
+    { 0x8eb98a7aUL, 0x9a5b04e3UL, 0x77f3608eUL, 0x92adb243UL },
+    { 0xb267ed19UL, 0x40f1c61cUL, 0x55f038b2UL, 0x37591ed4UL },
+    { 0xdf01e85fUL, 0x912e37a3UL, 0x6b6c46deUL, 0xc52f6689UL },
+    { 0x8b61313bUL, 0xbabce2c6UL, 0x2323ac4bUL, 0x3b3da016UL },
+    { 0xae397d8aUL, 0xa96c1b77UL, 0xabec975eUL, 0x0a0d081bUL },
+    { 0xd9c7dcedUL, 0x53c72255UL, 0x96e7bd35UL, 0x8c904a22UL },
+    { 0x881cea14UL, 0x545c7575UL, 0x7e50d641UL, 0x77da2e55UL },
+    { 0xaa242499UL, 0x697392d2UL, 0xdde50bd1UL, 0xd5d0b9eaUL },
+    { 0xd4ad2dbfUL, 0xc3d07787UL, 0x955e4ec6UL, 0x4b44e865UL },
+    { 0x84ec3c97UL, 0xda624ab4UL, 0xbd5af13bUL, 0xef0b113fUL },
+    { 0xa6274bbdUL, 0xd0fadd61UL, 0xecb1ad8aUL, 0xeacdd58fUL },
+    { 0xcfb11eadUL, 0x453994baUL, 0x67de18edUL, 0xa5814af3UL },
+    { 0x81ceb32cUL, 0x4b43fcf4UL, 0x80eacf94UL, 0x8770ced8UL },
+    { 0xa2425ff7UL, 0x5e14fc31UL, 0xa1258379UL, 0xa94d028eUL },
+    { 0xcad2f7f5UL, 0x359a3b3eUL, 0x096ee458UL, 0x13a04331UL },
+    { 0xfd87b5f2UL, 0x8300ca0dUL, 0x8bca9d6eUL, 0x188853fdUL },
+    { 0x9e74d1b7UL, 0x91e07e48UL, 0x775ea264UL, 0xcf55347eUL },
+    { 0xc6120625UL, 0x76589ddaUL, 0x95364afeUL, 0x032a819eUL },
+    { 0xf79687aeUL, 0xd3eec551UL, 0x3a83ddbdUL, 0x83f52205UL },
+    { 0x9abe14cdUL, 0x44753b52UL, 0xc4926a96UL, 0x72793543UL },
+    { 0xc16d9a00UL, 0x95928a27UL, 0x75b7053cUL, 0x0f178294UL },
+    { 0xf1c90080UL, 0xbaf72cb1UL, 0x5324c68bUL, 0x12dd6339UL },
+    { 0x971da050UL, 0x74da7beeUL, 0xd3f6fc16UL, 0xebca5e04UL },
+    { 0xbce50864UL, 0x92111aeaUL, 0x88f4bb1cUL, 0xa6bcf585UL },
+    { 0xec1e4a7dUL, 0xb69561a5UL, 0x2b31e9e3UL, 0xd06c32e6UL },
+    { 0x9392ee8eUL, 0x921d5d07UL, 0x3aff322eUL, 0x62439fd0UL },
+    { 0xb877aa32UL, 0x36a4b449UL, 0x09befeb9UL, 0xfad487c3UL },
+    { 0xe69594beUL, 0xc44de15bUL, 0x4c2ebe68UL, 0x7989a9b4UL },
+    { 0x901d7cf7UL, 0x3ab0acd9UL, 0x0f9d3701UL, 0x4bf60a11UL },
+    { 0xb424dc35UL, 0x095cd80fUL, 0x538484c1UL, 0x9ef38c95UL },
+    { 0xe12e1342UL, 0x4bb40e13UL, 0x2865a5f2UL, 0x06b06fbaUL },
+    { 0x8cbccc09UL, 0x6f5088cbUL, 0xf93f87b7UL, 0x442e45d4UL },
+    { 0xafebff0bUL, 0xcb24aafeUL, 0xf78f69a5UL, 0x1539d749UL },
+    { 0xdbe6feceUL, 0xbdedd5beUL, 0xb573440eUL, 0x5a884d1cUL },
+    { 0x89705f41UL, 0x36b4a597UL, 0x31680a88UL, 0xf8953031UL },
+    { 0xabcc7711UL, 0x8461cefcUL, 0xfdc20d2bUL, 0x36ba7c3eUL },
+    { 0xd6bf94d5UL, 0xe57a42bcUL, 0x3d329076UL, 0x04691b4dUL },
+    { 0x8637bd05UL, 0xaf6c69b5UL, 0xa63f9a49UL, 0xc2c1b110UL },
+    { 0xa7c5ac47UL, 0x1b478423UL, 0x0fcf80dcUL, 0x33721d54UL },
+    { 0xd1b71758UL, 0xe219652bUL, 0xd3c36113UL, 0x404ea4a9UL },
+    { 0x83126e97UL, 0x8d4fdf3bUL, 0x645a1cacUL, 0x083126eaUL },
+    { 0xa3d70a3dUL, 0x70a3d70aUL, 0x3d70a3d7UL, 0x0a3d70a4UL },
+    { 0xccccccccUL, 0xccccccccUL, 0xccccccccUL, 0xcccccccdUL },
+    { 0x80000000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xa0000000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xc8000000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xfa000000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0x9c400000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xc3500000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xf4240000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0x98968000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xbebc2000UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xee6b2800UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0x9502f900UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xba43b740UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xe8d4a510UL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0x9184e72aUL, 0x00000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xb5e620f4UL, 0x80000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xe35fa931UL, 0xa0000000UL, 0x00000000UL, 0x00000001UL },
+    { 0x8e1bc9bfUL, 0x04000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xb1a2bc2eUL, 0xc5000000UL, 0x00000000UL, 0x00000001UL },
+    { 0xde0b6b3aUL, 0x76400000UL, 0x00000000UL, 0x00000001UL },
+    { 0x8ac72304UL, 0x89e80000UL, 0x00000000UL, 0x00000001UL },
+    { 0xad78ebc5UL, 0xac620000UL, 0x00000000UL, 0x00000001UL },
+    { 0xd8d726b7UL, 0x177a8000UL, 0x00000000UL, 0x00000001UL },
+    { 0x87867832UL, 0x6eac9000UL, 0x00000000UL, 0x00000001UL },
+    { 0xa968163fUL, 0x0a57b400UL, 0x00000000UL, 0x00000001UL },
+    { 0xd3c21bceUL, 0xcceda100UL, 0x00000000UL, 0x00000001UL },
+    { 0x84595161UL, 0x401484a0UL, 0x00000000UL, 0x00000001UL },
+    { 0xa56fa5b9UL, 0x9019a5c8UL, 0x00000000UL, 0x00000001UL },
+    { 0xcecb8f27UL, 0xf4200f3aUL, 0x00000000UL, 0x00000001UL },
+    { 0x813f3978UL, 0xf8940984UL, 0x40000000UL, 0x00000001UL },
+    { 0xa18f07d7UL, 0x36b90be5UL, 0x50000000UL, 0x00000001UL },
+    { 0xc9f2c9cdUL, 0x04674edeUL, 0xa4000000UL, 0x00000001UL },
+    { 0xfc6f7c40UL, 0x45812296UL, 0x4d000000UL, 0x00000001UL },
+    { 0x9dc5ada8UL, 0x2b70b59dUL, 0xf0200000UL, 0x00000001UL },
+    { 0xc5371912UL, 0x364ce305UL, 0x6c280000UL, 0x00000001UL },
+    { 0xf684df56UL, 0xc3e01bc6UL, 0xc7320000UL, 0x00000001UL },
+    { 0x9a130b96UL, 0x3a6c115cUL, 0x3c7f4000UL, 0x00000001UL },
+    { 0xc097ce7bUL, 0xc90715b3UL, 0x4b9f1000UL, 0x00000001UL },
+    { 0xf0bdc21aUL, 0xbb48db20UL, 0x1e86d400UL, 0x00000001UL },
+    { 0x96769950UL, 0xb50d88f4UL, 0x13144480UL, 0x00000001UL },
+    { 0xbc143fa4UL, 0xe250eb31UL, 0x17d955a0UL, 0x00000001UL },
+    { 0xeb194f8eUL, 0x1ae525fdUL, 0x5dcfab08UL, 0x00000001UL },
+    { 0x92efd1b8UL, 0xd0cf37beUL, 0x5aa1cae5UL, 0x00000001UL },
+    { 0xb7abc627UL, 0x050305adUL, 0xf14a3d9eUL, 0x40000001UL },
+    { 0xe596b7b0UL, 0xc643c719UL, 0x6d9ccd05UL, 0xd0000001UL },
+    { 0x8f7e32ceUL, 0x7bea5c6fUL, 0xe4820023UL, 0xa2000001UL },
+    { 0xb35dbf82UL, 0x1ae4f38bUL, 0xdda2802cUL, 0x8a800001UL },
+    { 0xe0352f62UL, 0xa19e306eUL, 0xd50b2037UL, 0xad200001UL },
+    { 0x8c213d9dUL, 0xa502de45UL, 0x4526f422UL, 0xcc340001UL },
+    { 0xaf298d05UL, 0x0e4395d6UL, 0x9670b12bUL, 0x7f410001UL },
+    { 0xdaf3f046UL, 0x51d47b4cUL, 0x3c0cdd76UL, 0x5f114001UL },
+    { 0x88d8762bUL, 0xf324cd0fUL, 0xa5880a69UL, 0xfb6ac801UL },
+    { 0xab0e93b6UL, 0xefee0053UL, 0x8eea0d04UL, 0x7a457a01UL },
+    { 0xd5d238a4UL, 0xabe98068UL, 0x72a49045UL, 0x98d6d881UL },
+    { 0x85a36366UL, 0xeb71f041UL, 0x47a6da2bUL, 0x7f864751UL },
+    { 0xa70c3c40UL, 0xa64e6c51UL, 0x999090b6UL, 0x5f67d925UL },
+    { 0xd0cf4b50UL, 0xcfe20765UL, 0xfff4b4e3UL, 0xf741cf6eUL },
+    { 0x82818f12UL, 0x81ed449fUL, 0xbff8f10eUL, 0x7a8921a5UL },
+    { 0xa321f2d7UL, 0x226895c7UL, 0xaff72d52UL, 0x192b6a0eUL },
+    { 0xcbea6f8cUL, 0xeb02bb39UL, 0x9bf4f8a6UL, 0x9f764491UL },
+    { 0xfee50b70UL, 0x25c36a08UL, 0x02f236d0UL, 0x4753d5b5UL },
+    { 0x9f4f2726UL, 0x179a2245UL, 0x01d76242UL, 0x2c946591UL },
+    { 0xc722f0efUL, 0x9d80aad6UL, 0x424d3ad2UL, 0xb7b97ef6UL },
+    { 0xf8ebad2bUL, 0x84e0d58bUL, 0xd2e08987UL, 0x65a7deb3UL },
+    { 0x9b934c3bUL, 0x330c8577UL, 0x63cc55f4UL, 0x9f88eb30UL },
+    { 0xc2781f49UL, 0xffcfa6d5UL, 0x3cbf6b71UL, 0xc76b25fcUL },
+    { 0xf316271cUL, 0x7fc3908aUL, 0x8bef464eUL, 0x3945ef7bUL },
+    { 0x97edd871UL, 0xcfda3a56UL, 0x97758bf0UL, 0xe3cbb5adUL },
+    { 0xbde94e8eUL, 0x43d0c8ecUL, 0x3d52eeedUL, 0x1cbea318UL },
+    { 0xed63a231UL, 0xd4c4fb27UL, 0x4ca7aaa8UL, 0x63ee4bdeUL },
+    { 0x945e455fUL, 0x24fb1cf8UL, 0x8fe8caa9UL, 0x3e74ef6bUL },
+    { 0xb975d6b6UL, 0xee39e436UL, 0xb3e2fd53UL, 0x8e122b45UL },
+    { 0xe7d34c64UL, 0xa9c85d44UL, 0x60dbbca8UL, 0x7196b617UL },
+    { 0x90e40fbeUL, 0xea1d3a4aUL, 0xbc8955e9UL, 0x46fe31ceUL },
+    { 0xb51d13aeUL, 0xa4a488ddUL, 0x6babab63UL, 0x98bdbe42UL },
+    { 0xe264589aUL, 0x4dcdab14UL, 0xc696963cUL, 0x7eed2dd2UL },
+    { 0x8d7eb760UL, 0x70a08aecUL, 0xfc1e1de5UL, 0xcf543ca3UL },
+    { 0xb0de6538UL, 0x8cc8ada8UL, 0x3b25a55fUL, 0x43294bccUL },
+    { 0xdd15fe86UL, 0xaffad912UL, 0x49ef0eb7UL, 0x13f39ebfUL },
+    { 0x8a2dbf14UL, 0x2dfcc7abUL, 0x6e356932UL, 0x6c784338UL },
+    { 0xacb92ed9UL, 0x397bf996UL, 0x49c2c37fUL, 0x07965405UL },
+    { 0xd7e77a8fUL, 0x87daf7fbUL, 0xdc33745eUL, 0xc97be907UL },
+    { 0x86f0ac99UL, 0xb4e8dafdUL, 0x69a028bbUL, 0x3ded71a4UL },
+    { 0xa8acd7c0UL, 0x222311bcUL, 0xc40832eaUL, 0x0d68ce0dUL },
+    { 0xd2d80db0UL, 0x2aabd62bUL, 0xf50a3fa4UL, 0x90c30191UL },
+    { 0x83c7088eUL, 0x1aab65dbUL, 0x792667c6UL, 0xda79e0fbUL },
+    { 0xa4b8cab1UL, 0xa1563f52UL, 0x577001b8UL, 0x91185939UL },
+    { 0xcde6fd5eUL, 0x09abcf26UL, 0xed4c0226UL, 0xb55e6f87UL },
+    { 0x80b05e5aUL, 0xc60b6178UL, 0x544f8158UL, 0x315b05b5UL },
+    { 0xa0dc75f1UL, 0x778e39d6UL, 0x696361aeUL, 0x3db1c722UL },
+    { 0xc913936dUL, 0xd571c84cUL, 0x03bc3a19UL, 0xcd1e38eaUL },
+    { 0xfb587849UL, 0x4ace3a5fUL, 0x04ab48a0UL, 0x4065c724UL },
+    { 0x9d174b2dUL, 0xcec0e47bUL, 0x62eb0d64UL, 0x283f9c77UL },
+    { 0xc45d1df9UL, 0x42711d9aUL, 0x3ba5d0bdUL, 0x324f8395UL },
+    { 0xf5746577UL, 0x930d6500UL, 0xca8f44ecUL, 0x7ee3647aUL },
+    { 0x9968bf6aUL, 0xbbe85f20UL, 0x7e998b13UL, 0xcf4e1eccUL },
+    { 0xbfc2ef45UL, 0x6ae276e8UL, 0x9e3fedd8UL, 0xc321a67fUL },
+    { 0xefb3ab16UL, 0xc59b14a2UL, 0xc5cfe94eUL, 0xf3ea101fUL },
+    { 0x95d04aeeUL, 0x3b80ece5UL, 0xbba1f1d1UL, 0x58724a13UL },
+    { 0xbb445da9UL, 0xca61281fUL, 0x2a8a6e45UL, 0xae8edc98UL },
+    { 0xea157514UL, 0x3cf97226UL, 0xf52d09d7UL, 0x1a3293beUL },
+    { 0x924d692cUL, 0xa61be758UL, 0x593c2626UL, 0x705f9c57UL },
+    { 0xb6e0c377UL, 0xcfa2e12eUL, 0x6f8b2fb0UL, 0x0c77836dUL },
+    { 0xe498f455UL, 0xc38b997aUL, 0x0b6dfb9cUL, 0x0f956448UL },
+    { 0x8edf98b5UL, 0x9a373fecUL, 0x4724bd41UL, 0x89bd5eadUL },
+    { 0xb2977ee3UL, 0x00c50fe7UL, 0x58edec91UL, 0xec2cb658UL },
+    { 0xdf3d5e9bUL, 0xc0f653e1UL, 0x2f2967b6UL, 0x6737e3eeUL },
+    { 0x8b865b21UL, 0x5899f46cUL, 0xbd79e0d2UL, 0x0082ee75UL },
+    { 0xae67f1e9UL, 0xaec07187UL, 0xecd85906UL, 0x80a3aa12UL },
+    { 0xda01ee64UL, 0x1a708de9UL, 0xe80e6f48UL, 0x20cc9496UL },
+    { 0x884134feUL, 0x908658b2UL, 0x3109058dUL, 0x147fdcdeUL },
+    { 0xaa51823eUL, 0x34a7eedeUL, 0xbd4b46f0UL, 0x599fd416UL },
+    { 0xd4e5e2cdUL, 0xc1d1ea96UL, 0x6c9e18acUL, 0x7007c91bUL },
+    { 0x850fadc0UL, 0x9923329eUL, 0x03e2cf6bUL, 0xc604ddb1UL },
+    { 0xa6539930UL, 0xbf6bff45UL, 0x84db8346UL, 0xb786151dUL },
+    { 0xcfe87f7cUL, 0xef46ff16UL, 0xe6126418UL, 0x65679a64UL },
+    { 0x81f14faeUL, 0x158c5f6eUL, 0x4fcb7e8fUL, 0x3f60c07fUL },
+    { 0xa26da399UL, 0x9aef7749UL, 0xe3be5e33UL, 0x0f38f09eUL },
+    { 0xcb090c80UL, 0x01ab551cUL, 0x5cadf5bfUL, 0xd3072cc6UL },
+    { 0xfdcb4fa0UL, 0x02162a63UL, 0x73d9732fUL, 0xc7c8f7f7UL },
+    { 0x9e9f11c4UL, 0x014dda7eUL, 0x2867e7fdUL, 0xdcdd9afbUL },
+    { 0xc646d635UL, 0x01a1511dUL, 0xb281e1fdUL, 0x541501b9UL },
+    { 0xf7d88bc2UL, 0x4209a565UL, 0x1f225a7cUL, 0xa91a4227UL },
+    { 0x9ae75759UL, 0x6946075fUL, 0x3375788dUL, 0xe9b06959UL },
+    { 0xc1a12d2fUL, 0xc3978937UL, 0x0052d6b1UL, 0x641c83afUL },
+    { 0xf209787bUL, 0xb47d6b84UL, 0xc0678c5dUL, 0xbd23a49bUL },
+    { 0x9745eb4dUL, 0x50ce6332UL, 0xf840b7baUL, 0x963646e1UL },
+    { 0xbd176620UL, 0xa501fbffUL, 0xb650e5a9UL, 0x3bc3d899UL },
+    { 0xec5d3fa8UL, 0xce427affUL, 0xa3e51f13UL, 0x8ab4cebfUL },
+    { 0x93ba47c9UL, 0x80e98cdfUL, 0xc66f336cUL, 0x36b10138UL },
+    { 0xb8a8d9bbUL, 0xe123f017UL, 0xb80b0047UL, 0x445d4185UL },
+    { 0xe6d3102aUL, 0xd96cec1dUL, 0xa60dc059UL, 0x157491e6UL },
+    { 0x9043ea1aUL, 0xc7e41392UL, 0x87c89837UL, 0xad68db30UL },
+    { 0xb454e4a1UL, 0x79dd1877UL, 0x29babe45UL, 0x98c311fcUL },
+    { 0xe16a1dc9UL, 0xd8545e94UL, 0xf4296dd6UL, 0xfef3d67bUL },
+    { 0x8ce2529eUL, 0x2734bb1dUL, 0x1899e4a6UL, 0x5f58660dUL },
+    { 0xb01ae745UL, 0xb101e9e4UL, 0x5ec05dcfUL, 0xf72e7f90UL },
+    { 0xdc21a117UL, 0x1d42645dUL, 0x76707543UL, 0xf4fa1f74UL },
+    { 0x899504aeUL, 0x72497ebaUL, 0x6a06494aUL, 0x791c53a9UL },
+    { 0xabfa45daUL, 0x0edbde69UL, 0x0487db9dUL, 0x17636893UL },
+    { 0xd6f8d750UL, 0x9292d603UL, 0x45a9d284UL, 0x5d3c42b7UL },
+    { 0x865b8692UL, 0x5b9bc5c2UL, 0x0b8a2392UL, 0xba45a9b3UL },
+    { 0xa7f26836UL, 0xf282b732UL, 0x8e6cac77UL, 0x68d7141fUL },
+    { 0xd1ef0244UL, 0xaf2364ffUL, 0x3207d795UL, 0x430cd927UL },
+    { 0x8335616aUL, 0xed761f1fUL, 0x7f44e6bdUL, 0x49e807b9UL },
+    { 0xa402b9c5UL, 0xa8d3a6e7UL, 0x5f16206cUL, 0x9c6209a7UL },
+    { 0xcd036837UL, 0x130890a1UL, 0x36dba887UL, 0xc37a8c10UL },
+    { 0x80222122UL, 0x6be55a64UL, 0xc2494954UL, 0xda2c978aUL },
+    { 0xa02aa96bUL, 0x06deb0fdUL, 0xf2db9baaUL, 0x10b7bd6dUL },
+    { 0xc83553c5UL, 0xc8965d3dUL, 0x6f928294UL, 0x94e5acc8UL },
+    { 0xfa42a8b7UL, 0x3abbf48cUL, 0xcb772339UL, 0xba1f17faUL },
+    { 0x9c69a972UL, 0x84b578d7UL, 0xff2a7604UL, 0x14536efcUL },
+    { 0xc38413cfUL, 0x25e2d70dUL, 0xfef51385UL, 0x19684abbUL },
+    { 0xf46518c2UL, 0xef5b8cd1UL, 0x7eb25866UL, 0x5fc25d6aUL },
+    { 0x98bf2f79UL, 0xd5993802UL, 0xef2f773fUL, 0xfbd97a62UL },
+    { 0xbeeefb58UL, 0x4aff8603UL, 0xaafb550fUL, 0xfacfd8fbUL },
+    { 0xeeaaba2eUL, 0x5dbf6784UL, 0x95ba2a53UL, 0xf983cf39UL },
+    { 0x952ab45cUL, 0xfa97a0b2UL, 0xdd945a74UL, 0x7bf26184UL },
+    { 0xba756174UL, 0x393d88dfUL, 0x94f97111UL, 0x9aeef9e5UL },
+    { 0xe912b9d1UL, 0x478ceb17UL, 0x7a37cd56UL, 0x01aab85eUL },
+    { 0x91abb422UL, 0xccb812eeUL, 0xac62e055UL, 0xc10ab33bUL },
+    { 0xb616a12bUL, 0x7fe617aaUL, 0x577b986bUL, 0x314d600aUL },
+    { 0xe39c4976UL, 0x5fdf9d94UL, 0xed5a7e85UL, 0xfda0b80cUL },
+    { 0x8e41ade9UL, 0xfbebc27dUL, 0x14588f13UL, 0xbe847308UL },
+    { 0xb1d21964UL, 0x7ae6b31cUL, 0x596eb2d8UL, 0xae258fc9UL },
+    { 0xde469fbdUL, 0x99a05fe3UL, 0x6fca5f8eUL, 0xd9aef3bcUL },
+    { 0x8aec23d6UL, 0x80043beeUL, 0x25de7bb9UL, 0x480d5855UL },
+    { 0xada72cccUL, 0x20054ae9UL, 0xaf561aa7UL, 0x9a10ae6bUL },
+    { 0xd910f7ffUL, 0x28069da4UL, 0x1b2ba151UL, 0x8094da05UL },
+    { 0x87aa9affUL, 0x79042286UL, 0x90fb44d2UL, 0xf05d0843UL },
+    { 0xa99541bfUL, 0x57452b28UL, 0x353a1607UL, 0xac744a54UL },
+    { 0xd3fa922fUL, 0x2d1675f2UL, 0x42889b89UL, 0x97915ce9UL },
+    { 0x847c9b5dUL, 0x7c2e09b7UL, 0x69956135UL, 0xfebada12UL },
+    { 0xa59bc234UL, 0xdb398c25UL, 0x43fab983UL, 0x7e699096UL },
+    { 0xcf02b2c2UL, 0x1207ef2eUL, 0x94f967e4UL, 0x5e03f4bcUL },
+    { 0x8161afb9UL, 0x4b44f57dUL, 0x1d1be0eeUL, 0xbac278f6UL },
+    { 0xa1ba1ba7UL, 0x9e1632dcUL, 0x6462d92aUL, 0x69731733UL },
+    { 0xca28a291UL, 0x859bbf93UL, 0x7d7b8f75UL, 0x03cfdcffUL },
+    { 0xfcb2cb35UL, 0xe702af78UL, 0x5cda7352UL, 0x44c3d43fUL },
+    { 0x9defbf01UL, 0xb061adabUL, 0x3a088813UL, 0x6afa64a8UL },
+    { 0xc56baec2UL, 0x1c7a1916UL, 0x088aaa18UL, 0x45b8fdd1UL },
+    { 0xf6c69a72UL, 0xa3989f5bUL, 0x8aad549eUL, 0x57273d46UL },
+    { 0x9a3c2087UL, 0xa63f6399UL, 0x36ac54e2UL, 0xf678864cUL },
+    { 0xc0cb28a9UL, 0x8fcf3c7fUL, 0x84576a1bUL, 0xb416a7deUL },
+    { 0xf0fdf2d3UL, 0xf3c30b9fUL, 0x656d44a2UL, 0xa11c51d6UL },
+    { 0x969eb7c4UL, 0x7859e743UL, 0x9f644ae5UL, 0xa4b1b326UL },
+    { 0xbc4665b5UL, 0x96706114UL, 0x873d5d9fUL, 0x0dde1fefUL },
+    { 0xeb57ff22UL, 0xfc0c7959UL, 0xa90cb506UL, 0xd155a7ebUL },
+    { 0x9316ff75UL, 0xdd87cbd8UL, 0x09a7f124UL, 0x42d588f3UL },
+    { 0xb7dcbf53UL, 0x54e9beceUL, 0x0c11ed6dUL, 0x538aeb30UL },
+    { 0xe5d3ef28UL, 0x2a242e81UL, 0x8f1668c8UL, 0xa86da5fbUL },
+    { 0x8fa47579UL, 0x1a569d10UL, 0xf96e017dUL, 0x694487bdUL },
+    { 0xb38d92d7UL, 0x60ec4455UL, 0x37c981dcUL, 0xc395a9adUL },
+    { 0xe070f78dUL, 0x3927556aUL, 0x85bbe253UL, 0xf47b1418UL },
+    { 0x8c469ab8UL, 0x43b89562UL, 0x93956d74UL, 0x78ccec8fUL },
+    { 0xaf584166UL, 0x54a6babbUL, 0x387ac8d1UL, 0x970027b3UL },
+    { 0xdb2e51bfUL, 0xe9d0696aUL, 0x06997b05UL, 0xfcc0319fUL },
+    { 0x88fcf317UL, 0xf22241e2UL, 0x441fece3UL, 0xbdf81f04UL },
+    { 0xab3c2fddUL, 0xeeaad25aUL, 0xd527e81cUL, 0xad7626c4UL },
+    { 0xd60b3bd5UL, 0x6a5586f1UL, 0x8a71e223UL, 0xd8d3b075UL },
+    { 0x85c70565UL, 0x62757456UL, 0xf6872d56UL, 0x67844e4aUL },
+    { 0xa738c6beUL, 0xbb12d16cUL, 0xb428f8acUL, 0x016561dcUL },
+    { 0xd106f86eUL, 0x69d785c7UL, 0xe13336d7UL, 0x01beba53UL },
+    { 0x82a45b45UL, 0x0226b39cUL, 0xecc00246UL, 0x61173474UL },
+    { 0xa34d7216UL, 0x42b06084UL, 0x27f002d7UL, 0xf95d0191UL },
+    { 0xcc20ce9bUL, 0xd35c78a5UL, 0x31ec038dUL, 0xf7b441f5UL },
+    { 0xff290242UL, 0xc83396ceUL, 0x7e670471UL, 0x75a15272UL },
+    { 0x9f79a169UL, 0xbd203e41UL, 0x0f0062c6UL, 0xe984d387UL },
+    { 0xc75809c4UL, 0x2c684dd1UL, 0x52c07b78UL, 0xa3e60869UL },
+    { 0xf92e0c35UL, 0x37826145UL, 0xa7709a56UL, 0xccdf8a83UL },
+    { 0x9bbcc7a1UL, 0x42b17ccbUL, 0x88a66076UL, 0x400bb692UL },
+    { 0xc2abf989UL, 0x935ddbfeUL, 0x6acff893UL, 0xd00ea436UL },
+    { 0xf356f7ebUL, 0xf83552feUL, 0x0583f6b8UL, 0xc4124d44UL },
+    { 0x98165af3UL, 0x7b2153deUL, 0xc3727a33UL, 0x7a8b704bUL },
+    { 0xbe1bf1b0UL, 0x59e9a8d6UL, 0x744f18c0UL, 0x592e4c5dUL },
+    { 0xeda2ee1cUL, 0x7064130cUL, 0x1162def0UL, 0x6f79df74UL },
+    { 0x9485d4d1UL, 0xc63e8be7UL, 0x8addcb56UL, 0x45ac2ba9UL },
+    { 0xb9a74a06UL, 0x37ce2ee1UL, 0x6d953e2bUL, 0xd7173693UL },
+    { 0xe8111c87UL, 0xc5c1ba99UL, 0xc8fa8db6UL, 0xccdd0438UL },
+    { 0x910ab1d4UL, 0xdb9914a0UL, 0x1d9c9892UL, 0x400a22a3UL },
+    { 0xb54d5e4aUL, 0x127f59c8UL, 0x2503beb6UL, 0xd00cab4cUL },
+    { 0xe2a0b5dcUL, 0x971f303aUL, 0x2e44ae64UL, 0x840fd61eUL },
+    { 0x8da471a9UL, 0xde737e24UL, 0x5ceaecfeUL, 0xd289e5d3UL },
+    { 0xb10d8e14UL, 0x56105dadUL, 0x7425a83eUL, 0x872c5f48UL },
+    { 0xdd50f199UL, 0x6b947518UL, 0xd12f124eUL, 0x28f7771aUL },
+    { 0x8a5296ffUL, 0xe33cc92fUL, 0x82bd6b70UL, 0xd99aaa70UL },
+    { 0xace73cbfUL, 0xdc0bfb7bUL, 0x636cc64dUL, 0x1001550cUL },
+    { 0xd8210befUL, 0xd30efa5aUL, 0x3c47f7e0UL, 0x5401aa4fUL },
+    { 0x8714a775UL, 0xe3e95c78UL, 0x65acfaecUL, 0x34810a72UL },
+    { 0xa8d9d153UL, 0x5ce3b396UL, 0x7f1839a7UL, 0x41a14d0eUL },
+    { 0xd31045a8UL, 0x341ca07cUL, 0x1ede4811UL, 0x1209a051UL },
+    { 0x83ea2b89UL, 0x2091e44dUL, 0x934aed0aUL, 0xab460433UL },
+    { 0xa4e4b66bUL, 0x68b65d60UL, 0xf81da84dUL, 0x56178540UL },
+    { 0xce1de406UL, 0x42e3f4b9UL, 0x36251260UL, 0xab9d668fUL },
+    { 0x80d2ae83UL, 0xe9ce78f3UL, 0xc1d72b7cUL, 0x6b42601aUL },
+    { 0xa1075a24UL, 0xe4421730UL, 0xb24cf65bUL, 0x8612f820UL },
+    { 0xc94930aeUL, 0x1d529cfcUL, 0xdee033f2UL, 0x6797b628UL },
+    { 0xfb9b7cd9UL, 0xa4a7443cUL, 0x169840efUL, 0x017da3b2UL },
+    { 0x9d412e08UL, 0x06e88aa5UL, 0x8e1f2895UL, 0x60ee864fUL },
+    { 0xc491798aUL, 0x08a2ad4eUL, 0xf1a6f2baUL, 0xb92a27e3UL },
+    { 0xf5b5d7ecUL, 0x8acb58a2UL, 0xae10af69UL, 0x6774b1dcUL },
+    { 0x9991a6f3UL, 0xd6bf1765UL, 0xacca6da1UL, 0xe0a8ef2aUL },
+    { 0xbff610b0UL, 0xcc6edd3fUL, 0x17fd090aUL, 0x58d32af4UL },
+    { 0xeff394dcUL, 0xff8a948eUL, 0xddfc4b4cUL, 0xef07f5b1UL },
+    { 0x95f83d0aUL, 0x1fb69cd9UL, 0x4abdaf10UL, 0x1564f98fUL },
+    { 0xbb764c4cUL, 0xa7a4440fUL, 0x9d6d1ad4UL, 0x1abe37f2UL },
+    { 0xea53df5fUL, 0xd18d5513UL, 0x84c86189UL, 0x216dc5eeUL },
+    { 0x92746b9bUL, 0xe2f8552cUL, 0x32fd3cf5UL, 0xb4e49bb5UL },
+    { 0xb7118682UL, 0xdbb66a77UL, 0x3fbc8c33UL, 0x221dc2a2UL },
+    { 0xe4d5e823UL, 0x92a40515UL, 0x0fabaf3fUL, 0xeaa5334bUL },
+    { 0x8f05b116UL, 0x3ba6832dUL, 0x29cb4d87UL, 0xf2a7400fUL },
+    { 0xb2c71d5bUL, 0xca9023f8UL, 0x743e20e9UL, 0xef511013UL },
+    { 0xdf78e4b2UL, 0xbd342cf6UL, 0x914da924UL, 0x6b255417UL },
+    { 0x8bab8eefUL, 0xb6409c1aUL, 0x1ad089b6UL, 0xc2f7548fUL },
+    { 0xae9672abUL, 0xa3d0c320UL, 0xa184ac24UL, 0x73b529b2UL },
+    { 0xda3c0f56UL, 0x8cc4f3e8UL, 0xc9e5d72dUL, 0x90a2741fUL },
+    { 0x88658996UL, 0x17fb1871UL, 0x7e2fa67cUL, 0x7a658893UL },
+    { 0xaa7eebfbUL, 0x9df9de8dUL, 0xddbb901bUL, 0x98feeab8UL },
+    { 0xd51ea6faUL, 0x85785631UL, 0x552a7422UL, 0x7f3ea566UL },
+    { 0x8533285cUL, 0x936b35deUL, 0xd53a8895UL, 0x8f872760UL },
+    { 0xa67ff273UL, 0xb8460356UL, 0x8a892abaUL, 0xf368f138UL },
+    { 0xd01fef10UL, 0xa657842cUL, 0x2d2b7569UL, 0xb0432d86UL },
+    { 0x8213f56aUL, 0x67f6b29bUL, 0x9c3b2962UL, 0x0e29fc74UL },
+    { 0xa298f2c5UL, 0x01f45f42UL, 0x8349f3baUL, 0x91b47b90UL },
+    { 0xcb3f2f76UL, 0x42717713UL, 0x241c70a9UL, 0x36219a74UL },
+    { 0xfe0efb53UL, 0xd30dd4d7UL, 0xed238cd3UL, 0x83aa0111UL },
+    { 0x9ec95d14UL, 0x63e8a506UL, 0xf4363804UL, 0x324a40abUL },
+    { 0xc67bb459UL, 0x7ce2ce48UL, 0xb143c605UL, 0x3edcd0d6UL },
+    { 0xf81aa16fUL, 0xdc1b81daUL, 0xdd94b786UL, 0x8e94050bUL },
+    { 0x9b10a4e5UL, 0xe9913128UL, 0xca7cf2b4UL, 0x191c8327UL },
+    { 0xc1d4ce1fUL, 0x63f57d72UL, 0xfd1c2f61UL, 0x1f63a3f1UL },
+    { 0xf24a01a7UL, 0x3cf2dccfUL, 0xbc633b39UL, 0x673c8cedUL },
+    { 0x976e4108UL, 0x8617ca01UL, 0xd5be0503UL, 0xe085d814UL },
+    { 0xbd49d14aUL, 0xa79dbc82UL, 0x4b2d8644UL, 0xd8a74e19UL },
+    { 0xec9c459dUL, 0x51852ba2UL, 0xddf8e7d6UL, 0x0ed1219fUL },
+    { 0x93e1ab82UL, 0x52f33b45UL, 0xcabb90e5UL, 0xc942b504UL },
+    { 0xb8da1662UL, 0xe7b00a17UL, 0x3d6a751fUL, 0x3b936244UL },
+    { 0xe7109bfbUL, 0xa19c0c9dUL, 0x0cc51267UL, 0x0a783ad5UL },
+    { 0x906a617dUL, 0x450187e2UL, 0x27fb2b80UL, 0x668b24c6UL },
+    { 0xb484f9dcUL, 0x9641e9daUL, 0xb1f9f660UL, 0x802dedf7UL },
+    { 0xe1a63853UL, 0xbbd26451UL, 0x5e7873f8UL, 0xa0396974UL },
+    { 0x8d07e334UL, 0x55637eb2UL, 0xdb0b487bUL, 0x6423e1e9UL },
+    { 0xb049dc01UL, 0x6abc5e5fUL, 0x91ce1a9aUL, 0x3d2cda63UL },
+    { 0xdc5c5301UL, 0xc56b75f7UL, 0x7641a140UL, 0xcc7810fcUL },
+    { 0x89b9b3e1UL, 0x1b6329baUL, 0xa9e904c8UL, 0x7fcb0a9eUL },
+    { 0xac2820d9UL, 0x623bf429UL, 0x546345faUL, 0x9fbdcd45UL },
+    { 0xd732290fUL, 0xbacaf133UL, 0xa97c1779UL, 0x47ad4096UL },
+    { 0x867f59a9UL, 0xd4bed6c0UL, 0x49ed8eabUL, 0xcccc485eUL },
+    { 0xa81f3014UL, 0x49ee8c70UL, 0x5c68f256UL, 0xbfff5a75UL },
+    { 0xd226fc19UL, 0x5c6a2f8cUL, 0x73832eecUL, 0x6fff3112UL },
+    { 0x83585d8fUL, 0xd9c25db7UL, 0xc831fd53UL, 0xc5ff7eacUL },
+    { 0xa42e74f3UL, 0xd032f525UL, 0xba3e7ca8UL, 0xb77f5e56UL },
+    { 0xcd3a1230UL, 0xc43fb26fUL, 0x28ce1bd2UL, 0xe55f35ecUL },
+    { 0x80444b5eUL, 0x7aa7cf85UL, 0x7980d163UL, 0xcf5b81b4UL },
+    { 0xa0555e36UL, 0x1951c366UL, 0xd7e105bcUL, 0xc3326220UL },
+    { 0xc86ab5c3UL, 0x9fa63440UL, 0x8dd9472bUL, 0xf3fefaa8UL },
+    { 0xfa856334UL, 0x878fc150UL, 0xb14f98f6UL, 0xf0feb952UL },
+    { 0x9c935e00UL, 0xd4b9d8d2UL, 0x6ed1bf9aUL, 0x569f33d4UL },
+    { 0xc3b83581UL, 0x09e84f07UL, 0x0a862f80UL, 0xec4700c9UL },
+    { 0xf4a642e1UL, 0x4c6262c8UL, 0xcd27bb61UL, 0x2758c0fbUL },
+    { 0x98e7e9ccUL, 0xcfbd7dbdUL, 0x8038d51cUL, 0xb897789dUL },
+    { 0xbf21e440UL, 0x03acdd2cUL, 0xe0470a63UL, 0xe6bd56c4UL },
+    { 0xeeea5d50UL, 0x04981478UL, 0x1858ccfcUL, 0xe06cac75UL },
+    { 0x95527a52UL, 0x02df0ccbUL, 0x0f37801eUL, 0x0c43ebc9UL },
+    { 0xbaa718e6UL, 0x8396cffdUL, 0xd3056025UL, 0x8f54e6bbUL },
+    { 0xe950df20UL, 0x247c83fdUL, 0x47c6b82eUL, 0xf32a206aUL },
+    { 0x91d28b74UL, 0x16cdd27eUL, 0x4cdc331dUL, 0x57fa5442UL },
+    { 0xb6472e51UL, 0x1c81471dUL, 0xe0133fe4UL, 0xadf8e953UL },
+    { 0xe3d8f9e5UL, 0x63a198e5UL, 0x58180fddUL, 0xd97723a7UL },
+    { 0x8e679c2fUL, 0x5e44ff8fUL, 0x570f09eaUL, 0xa7ea7649UL },
+    { 0xb201833bUL, 0x35d63f73UL, 0x2cd2cc65UL, 0x51e513dbUL },
+    { 0xde81e40aUL, 0x034bcf4fUL, 0xf8077f7eUL, 0xa65e58d2UL },
+    { 0x8b112e86UL, 0x420f6191UL, 0xfb04afafUL, 0x27faf783UL },
+    { 0xadd57a27UL, 0xd29339f6UL, 0x79c5db9aUL, 0xf1f9b564UL },
+    { 0xd94ad8b1UL, 0xc7380874UL, 0x18375281UL, 0xae7822bdUL },
+    { 0x87cec76fUL, 0x1c830548UL, 0x8f229391UL, 0x0d0b15b6UL },
+    { 0xa9c2794aUL, 0xe3a3c69aUL, 0xb2eb3875UL, 0x504ddb23UL },
+    { 0xd433179dUL, 0x9c8cb841UL, 0x5fa60692UL, 0xa46151ecUL },
+    { 0x849feec2UL, 0x81d7f328UL, 0xdbc7c41bUL, 0xa6bcd334UL },
+    { 0xa5c7ea73UL, 0x224deff3UL, 0x12b9b522UL, 0x906c0801UL },
+    { 0xcf39e50fUL, 0xeae16befUL, 0xd768226bUL, 0x34870a01UL },
+    { 0x81842f29UL, 0xf2cce375UL, 0xe6a11583UL, 0x00d46641UL },
+    { 0xa1e53af4UL, 0x6f801c53UL, 0x60495ae3UL, 0xc1097fd1UL },
+    { 0xca5e89b1UL, 0x8b602368UL, 0x385bb19cUL, 0xb14bdfc5UL },
+    { 0xfcf62c1dUL, 0xee382c42UL, 0x46729e03UL, 0xdd9ed7b6UL },
+    { 0x9e19db92UL, 0xb4e31ba9UL, 0x6c07a2c2UL, 0x6a8346d2UL }
+};
+
+#define POWER_OF_TEN_MIN (-292)
+
+/* floor(x / 2^shift) for negative x too, without relying on arithmetic shifts */
+static long floor_shift(long x, int shift)
+{
+    if (x >= 0)
+    {
+        return x >> shift;
+    }
+    return -((-x + (1L << shift) - 1) >> shift);
+}
+
+/* the 128 bit product of two 64 bit numbers */
+static void multiply_64(cjson_uint64 a, cjson_uint64 b, cjson_uint64 *high, cjson_uint64 *low)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+
+    *low = (cjson_uint64)product;
+    *high = (cjson_uint64)(product >> 64);
+#else
+    const cjson_uint64 mask = 0xFFFFFFFFUL;
+    cjson_uint64 a_high = a >> 32;
+    cjson_uint64 a_low = a & mask;
+    cjson_uint64 b_high = b >> 32;
+    cjson_uint64 b_low = b & mask;
+    cjson_uint64 low_low = a_low * b_low;
+    cjson_uint64 high_low = a_high * b_low;
+    cjson_uint64 low_high = a_low * b_high;
+    cjson_uint64 middle = (low_low >> 32) + (high_low & mask) + low_high;
+
+    *low = (middle << 32) | (low_low & mask);
+    *high = a_high * b_high + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+/* valueint saturates in case of overflow */
+static int saturate_int(cJSON_int64 number)
+{
+    if (number >= INT_MAX)
+    {
+        return INT_MAX;
+    }
+    if (number <= INT_MIN)
+    {
+        return INT_MIN;
+    }
+    return (int)number;
+}
+
+/* Parse a literal made of an optional minus and at most 19 digits, false for anything else or if it doesn't fit. */
+static cJSON_bool parse_int64(const unsigned char * const literal, size_t length, cJSON_int64 * const number)
+{
+    cjson_uint64 magnitude = 0;
+    cJSON_bool negative = (length > 0) && (literal[0] == '-');
+    size_t i = negative ? 1 : 0;
+
+    if ((length == i) || ((length - i) > 19))
+    {
+        return false;
+    }
+    for (; i < length; i++)
+    {
+        if ((literal[i] < '0') || (literal[i] > '9'))
+        {
+            return false;
+        }
+        magnitude = (magnitude * 10) + (cjson_uint64)(literal[i] - '0');
+    }
+
+    if (magnitude > (cjson_uint64)CJSON_INT64_MAX + (negative ? 1 : 0))
+    {
+        return false;
+    }
+    if (negative)
+    {
+        *number = (magnitude == (cjson_uint64)CJSON_INT64_MAX + 1) ? CJSON_INT64_MIN : -(cJSON_int64)magnitude;
+    }
+    else
+    {
+        *number = (cJSON_int64)magnitude;
+    }
+    return true;
+}
+
+/* Clinger's fast path needs double arithmetic without excess precision (no x87) */
+#if (defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)) || (defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ == 0))
+#define CJSON_EXACT_DOUBLE_ARITHMETIC
+/* powers of ten that are exact doubles */
+static const double exact_powers_of_ten[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif
+
+/* Decimal to double conversion after Eisel and Lemire ("Number Parsing at a
+ * Gigabyte per Second", 2021): the significand is multiplied by the 128 bit
+ * power of ten and the product rounded, false if the product can't decide
+ * the rounding and strtod has to. */
+static cJSON_bool eisel_lemire(cjson_uint64 significand, int exponent, double * const number)
+{
+    const unsigned long *g = NULL;
+    cjson_uint64 g_high = 0;
+    cjson_uint64 g_low = 0;
+    cjson_uint64 high = 0;
+    cjson_uint64 low = 0;
+    cjson_uint64 second_high = 0;
+    cjson_uint64 second_low = 0;
+    cjson_uint64 mantissa = 0;
+    cjson_uint64 bits = 0;
+    int leading_zeros = 0;
+    int upper_bit = 0;
+    long binary_exponent = 0;
+
+    if (significand == 0)
+    {
+        *number = 0;
+        return true;
+    }
+    if ((exponent < POWER_OF_TEN_MIN) || (exponent > 308))
+    {
+        return false;
+    }
+
+    /* the table rounds up, the algorithm wants positive powers truncated */
+    g = powers_of_ten_significand[exponent - POWER_OF_TEN_MIN];
+    g_high = ((cjson_uint64)g[0] << 32) | (cjson_uint64)g[1];
+    g_low = ((cjson_uint64)g[2] << 32) | (cjson_uint64)g[3];
+    if (exponent >= 0)
+    {
+        g_high -= (g_low == 0) ? 1 : 0;
+        g_low--;
+    }
+
+    while (!(significand & ((cjson_uint64)1 << 63)))
+    {
+        significand <<= 1;
+        leading_zeros++;
+    }
+
+    multiply_64(significand, g_high, &high, &low);
+    /* the low bits below the 55 we keep are all ones, the truncated half of the power may carry into them */
+    if ((high & 0x1FF) == 0x1FF)
+    {
+        multiply_64(significand, g_low, &second_high, &second_low);
+        low += second_high;
+        if (second_high > low)
+        {
+            high++;
+        }
+        if ((low == ~(cjson_uint64)0) && ((exponent < -27) || (exponent > 55)))
+        {
+            return false;
+        }
+    }
+
+    upper_bit = (int)(high >> 63);
+    mantissa = high >> (upper_bit + 9);
+    /* floor(log2(10^exponent)) + 63 plus the normalization, biased */
+    binary_exponent = floor_shift(217706L * exponent, 16) + 63 + upper_bit - leading_zeros + 1023;
+
+    if (binary_exponent <= 0)
+    {
+        /* subnormal */
+        if ((-binary_exponent + 1) >= 64)
+        {
+            *number = 0;
+            return true;
+        }
+        mantissa >>= -binary_exponent + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        binary_exponent = (mantissa < ((cjson_uint64)1 << 52)) ? 0 : 1;
+    }
+    else
+    {
+        /* exactly halfway between two doubles, round to even */
+        if ((low <= 1) && (exponent >= -4) && (exponent <= 23) && ((mantissa & 3) == 1)
+                && ((mantissa << (upper_bit + 9)) == high))
+        {
+            mantissa &= ~(cjson_uint64)1;
+        }
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= ((cjson_uint64)2 << 52))
+        {
+            mantissa = (cjson_uint64)1 << 52;
+            binary_exponent++;
+        }
+        if (binary_exponent >= 0x7FF)
+        {
+            return false;
+        }
+    }
+
+    bits = (mantissa & (((cjson_uint64)1 << 52) - 1)) | ((cjson_uint64)binary_exponent << 52);
+    memcpy(number, &bits, sizeof(bits));
+    return true;
+}
+
 /* Parse the input text to generate a number, and populate the result into item. */
 static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
 {
     double number = 0;
-    unsigned char *after_end = NULL;
-    unsigned char number_c_string[64];
-    unsigned char decimal_point = get_decimal_point();
-    size_t i = 0;
+    cJSON_int64 integer = 0;
+    const unsigned char *literal = NULL;
+    size_t available = 0;
+    size_t length = 0;
+    cjson_uint64 significand = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    int explicit_exponent = 0;
+    cJSON_bool truncated = false;
+    cJSON_bool negative = false;
+    cJSON_bool integral = true;
+    cJSON_bool have_digits = false;
 
     if ((input_buffer == NULL) || (input_buffer->content == NULL))
     {
         return false;
     }
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; (i < (sizeof(number_c_string) - 1)) && can_access_at_index(input_buffer, i); i++)
-    {
-        switch (buffer_at_offset(input_buffer)[i])
-        {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_c_string[i] = buffer_at_offset(input_buffer)[i];
-                break;
-
-            case '.':
-                number_c_string[i] = decimal_point;
-                break;
+    /* recognize the same prefix strtod would, within the first 63 characters
+     * this also takes care of '\0' not necessarily being available for marking the end of the input */
+    literal = buffer_at_offset(input_buffer);
+    available = input_buffer->length - input_buffer->offset;
+    if (available > 63)
+    {
+        available = 63;
+    }
 
-            default:
-                goto loop_end;
+    if ((length < available) && ((literal[length] == '-') || (literal[length] == '+')))
+    {
+        negative = (literal[length] == '-');
+        integral = negative;
+        length++;
+    }
+    for (; (length < available) && (literal[length] >= '0') && (literal[length] <= '9'); length++)
+    {
+        have_digits = true;
+        if (significant_digits < 19)
+        {
+            significand = (significand * 10) + (cjson_uint64)(literal[length] - '0');
+            significant_digits += (significand != 0) ? 1 : 0;
+        }
+        else
+        {
+            truncated = truncated || (literal[length] != '0');
+            exponent++;
         }
     }
-loop_end:
-    number_c_string[i] = '\0';
+    if ((length < available) && (literal[length] == '.'))
+    {
+        size_t point = length;
 
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+        for (length++; (length < available) && (literal[length] >= '0') && (literal[length] <= '9'); length++)
+        {
+            have_digits = true;
+            if (significant_digits < 19)
+            {
+                significand = (significand * 10) + (cjson_uint64)(literal[length] - '0');
+                significant_digits += (significand != 0) ? 1 : 0;
+                exponent--;
+            }
+            else
+            {
+                truncated = truncated || (literal[length] != '0');
+            }
+        }
+        integral = false;
+        if (!have_digits)
+        {
+            length = point;
+        }
+    }
+    if (!have_digits)
     {
         return false; /* parse_error */
     }
+    if ((length < available) && ((literal[length] == 'e') || (literal[length] == 'E')))
+    {
+        size_t mark = length++;
+        cJSON_bool negative_exponent = false;
+
+        if ((length < available) && ((literal[length] == '-') || (literal[length] == '+')))
+        {
+            negative_exponent = (literal[length] == '-');
+            length++;
+        }
+        if ((length < available) && (literal[length] >= '0') && (literal[length] <= '9'))
+        {
+            for (; (length < available) && (literal[length] >= '0') && (literal[length] <= '9'); length++)
+            {
+                if (explicit_exponent < 100000)
+                {
+                    explicit_exponent = (explicit_exponent * 10) + (literal[length] - '0');
+                }
+            }
+            exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+            integral = false;
+        }
+        else
+        {
+            /* a dangling exponent isn't part of the number */
+            length = mark;
+        }
+    }
+
+    /* integral literals are kept exactly when they fit */
+    if (integral && parse_int64(literal, length, &integer))
+    {
+        item->valueint64 = integer;
+        item->valueint = saturate_int(integer);
+        item->type = cJSON_Number | cJSON_NumberIsInt;
+        input_buffer->offset += length;
+        return true;
+    }
+
+#ifdef CJSON_EXACT_DOUBLE_ARITHMETIC
+    /* Clinger's fast path: both operands are exact doubles, so is the correctly rounded result */
+    if (!truncated && (significand <= ((cjson_uint64)1 << 53)) && (exponent >= -22) && (exponent <= 22))
+    {
+        number = (exponent < 0)
+            ? (double)significand / exact_powers_of_ten[-exponent]
+            : (double)significand * exact_powers_of_ten[exponent];
+    }
+    else
+#endif
+    if (truncated || !eisel_lemire(significand, exponent, &number))
+    {
+        /* more than 19 significant digits, products too close to call and out of range
+         * exponents are left to strtod, with '.' replaced by the decimal point of the
+         * current locale */
+        unsigned char number_c_string[64];
+        unsigned char decimal_point = get_decimal_point();
+        size_t i = 0;
+
+        for (i = 0; i < length; i++)
+        {
+            number_c_string[i] = (literal[i] == '.') ? decimal_point : literal[i];
+        }
+        number_c_string[length] = '\0';
+        number = strtod((const char*)number_c_string, NULL);
+        negative = false; /* the literal carries its sign */
+    }
+    if (negative)
+    {
+        number = -number;
+    }
 
     item->valuedouble = number;
 
@@ -374,13 +1392,19 @@ loop_end:
 
     item->type = cJSON_Number;
 
-    input_buffer->offset += (size_t)(after_end - number_c_string);
+    input_buffer->offset += length;
     return true;
 }
 
 /* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
 CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
 {
+    /* the number fields share storage with child and valuestring */
+    if (!cJSON_IsNumber(object))
+    {
+        return number;
+    }
+
     if (number >= INT_MAX)
     {
         object->valueint = INT_MAX;
@@ -394,9 +1418,22 @@ CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
         object->valueint = (int)number;
     }
 
+    object->type &= ~cJSON_NumberIsInt;
     return object->valuedouble = number;
 }
 
+CJSON_PUBLIC(cJSON_int64) cJSON_SetInt64Value(cJSON *object, cJSON_int64 number)
+{
+    if (!cJSON_IsNumber(object))
+    {
+        return number;
+    }
+
+    object->type |= cJSON_NumberIsInt;
+    object->valueint = saturate_int(number);
+    return object->valueint64 = number;
+}
+
 /* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
 CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
 {
@@ -547,78 +1584,304 @@ static cJSON_bool compare_double(double a, double b)
     return (fabs(a - b) <= maxVal * DBL_EPSILON);
 }
 
-/* Render the number nicely from the given item into a string. */
-static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+/* Render an integer into buffer without going through sprintf, returns its length. */
+static int print_int64(unsigned char * const buffer, cJSON_int64 number)
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
+    static const char digit_pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    unsigned char digits[20];
+    cjson_uint64 magnitude = (number < 0) ? (cjson_uint64)0 - (cjson_uint64)number : (cjson_uint64)number;
+    int count = sizeof(digits);
     int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
 
-    if (output_buffer == NULL)
+    /* two digits per division, from the back */
+    while (magnitude >= 100)
     {
-        return false;
+        size_t pair = (size_t)(magnitude % 100) * 2;
+        magnitude /= 100;
+        digits[--count] = (unsigned char)digit_pairs[pair + 1];
+        digits[--count] = (unsigned char)digit_pairs[pair];
     }
-
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+    if (magnitude >= 10)
     {
-        length = sprintf((char*)number_buffer, "null");
+        digits[--count] = (unsigned char)digit_pairs[magnitude * 2 + 1];
+        digits[--count] = (unsigned char)digit_pairs[magnitude * 2];
     }
-    else if(d == (double)item->valueint)
+    else
     {
-        length = sprintf((char*)number_buffer, "%d", item->valueint);
+        digits[--count] = (unsigned char)('0' + magnitude);
     }
-    else
+
+    if (number < 0)
     {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
+        buffer[length++] = '-';
+    }
+    memcpy(buffer + length, digits + count, sizeof(digits) - (size_t)count);
+    length += (int)sizeof(digits) - count;
+    buffer[length] = '\0';
+
+    return length;
+}
+
+/* Shortest round-trip formatting of doubles, after Raffaello Giulietti's
+ * Schubfach ("The Schubfach way to render doubles", 2020). It yields the
+ * fewest digits that read back to the same double, choosing the closest of
+ * them when there are several, without sprintf, sscanf or the locale. */
+
+#define SCHUBFACH_HIDDEN_BIT ((cjson_uint64)1 << 52)
+
+/* g * c / 2^128 for the 128 bit power g, with any remainder folded into the
+ * lowest bit (round to odd) */
+static cjson_uint64 round_to_odd(const unsigned long *g, cjson_uint64 c)
+{
+    cjson_uint64 g_high = ((cjson_uint64)g[0] << 32) | (cjson_uint64)g[1];
+    cjson_uint64 g_low = ((cjson_uint64)g[2] << 32) | (cjson_uint64)g[3];
+    cjson_uint64 x_high = 0;
+    cjson_uint64 x_low = 0;
+    cjson_uint64 y_high = 0;
+    cjson_uint64 y_low = 0;
+    cjson_uint64 middle = 0;
+
+    multiply_64(g_low, c, &x_high, &x_low);
+    multiply_64(g_high, c, &y_high, &y_low);
+    middle = y_low + x_high;
+    y_high += (middle < x_high) ? 1 : 0;
+
+    return y_high | ((middle > 1) ? 1 : 0);
+}
 
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+/* the shortest decimal significand of a positive finite double, its decimal
+ * exponent is stored in *exponent */
+static cjson_uint64 schubfach(double number, int *exponent)
+{
+    cjson_uint64 bits = 0;
+    cjson_uint64 significand = 0;
+    cjson_uint64 c = 0;
+    cjson_uint64 value = 0;
+    cjson_uint64 lower = 0;
+    cjson_uint64 upper = 0;
+    cjson_uint64 s = 0;
+    const unsigned long *g = NULL;
+    int biased_exponent = 0;
+    int q = 0;
+    int k = 0;
+    int h = 0;
+    cJSON_bool even = false;
+    cJSON_bool closer_lower_boundary = false;
+    cJSON_bool u_inside = false;
+    cJSON_bool w_inside = false;
+
+    memcpy(&bits, &number, sizeof(bits));
+    significand = bits & (SCHUBFACH_HIDDEN_BIT - 1);
+    biased_exponent = (int)((bits >> 52) & 0x7FF);
+
+    if (biased_exponent != 0)
+    {
+        c = SCHUBFACH_HIDDEN_BIT | significand;
+        q = biased_exponent - 1075;
+        /* integers below 2^53 are their own shortest representation */
+        if ((q <= 0) && (q > -53) && ((c & ((((cjson_uint64)1) << -q) - 1)) == 0))
         {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
+            *exponent = 0;
+            return c >> -q;
         }
     }
-
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    else
     {
-        return false;
+        c = significand;
+        q = -1074;
     }
 
-    /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
-    if (output_pointer == NULL)
-    {
-        return false;
-    }
+    even = ((c & 1) == 0);
+    closer_lower_boundary = ((significand == 0) && (biased_exponent > 1));
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
+    /* k = floor(log10(2^q)), or floor(log10(3/4 * 2^q)) when the lower boundary is closer */
+    k = (int)floor_shift((long)q * 1262611L - (closer_lower_boundary ? 524031L : 0L), 22);
+    /* h = q + floor(log2(10^-k)) + 1, which is in [1, 4] */
+    h = q + (int)floor_shift((long)-k * 1741647L, 19) + 1;
+    g = powers_of_ten_significand[-k - POWER_OF_TEN_MIN];
+
+    /* the value and its rounding interval scaled by 10^-k, times 4 */
+    value = round_to_odd(g, (c << 2) << h);
+    lower = round_to_odd(g, ((c << 2) - 2 + (closer_lower_boundary ? 1 : 0)) << h) + (even ? 0 : 1);
+    upper = round_to_odd(g, ((c << 2) + 2) << h) - (even ? 0 : 1);
+
+    s = value >> 2;
+    if (s >= 10)
     {
-        if (number_buffer[i] == decimal_point)
+        /* one digit less is enough when exactly one of its neighbours is inside */
+        cjson_uint64 shorter = s / 10;
+        cJSON_bool up_inside = (lower <= shorter * 40);
+        cJSON_bool wp_inside = (shorter * 40 + 40 <= upper);
+
+        if (up_inside != wp_inside)
         {
-            output_pointer[i] = '.';
-            continue;
+            *exponent = k + 1;
+            return shorter + (wp_inside ? 1 : 0);
         }
-
-        output_pointer[i] = number_buffer[i];
     }
-    output_pointer[i] = '\0';
 
-    output_buffer->offset += (size_t)length;
+    *exponent = k;
+    u_inside = (lower <= (s << 2));
+    w_inside = ((s << 2) + 4 <= upper);
+    if (u_inside != w_inside)
+    {
+        return s + (w_inside ? 1 : 0);
+    }
 
-    return true;
+    /* both neighbours are inside, take the closer one and break ties to even */
+    if ((value > (s << 2) + 2) || ((value == (s << 2) + 2) && ((s & 1) != 0)))
+    {
+        return s + 1;
+    }
+    return s;
 }
 
-/* parse 4 digit hexadecimal number */
-static unsigned parse_hex4(const unsigned char * const input)
+/* Render a finite double in the layout of "%g" (exponent below 1e-4 and from
+ * 1e15 on) with the shortest digits that read back to it, returns the length. */
+static int print_double(unsigned char * const buffer, double number)
+{
+    unsigned char digits[21];
+    cjson_uint64 significand = 0;
+    int count = 0;
+    int exponent = 0;
+    int decimal_exponent = 0;
+    int length = 0;
+    int i = 0;
+
+    if (number < 0)
+    {
+        buffer[length++] = '-';
+        number = -number;
+    }
+    if (number == 0)
+    {
+        buffer[length++] = '0';
+        buffer[length] = '\0';
+        return length;
+    }
+
+    significand = schubfach(number, &exponent);
+    while ((significand % 10) == 0)
+    {
+        significand /= 10;
+        exponent++;
+    }
+    count = print_int64(digits, (cJSON_int64)significand);
+    /* exponent of the first digit, as in d.ddde+x */
+    decimal_exponent = count + exponent - 1;
+
+    if ((decimal_exponent < -4) || (decimal_exponent >= 15))
+    {
+        buffer[length++] = digits[0];
+        if (count > 1)
+        {
+            buffer[length++] = '.';
+            memcpy(buffer + length, digits + 1, (size_t)(count - 1));
+            length += count - 1;
+        }
+        buffer[length++] = 'e';
+        buffer[length++] = (decimal_exponent < 0) ? '-' : '+';
+        if (decimal_exponent < 0)
+        {
+            decimal_exponent = -decimal_exponent;
+        }
+        if (decimal_exponent >= 100)
+        {
+            buffer[length++] = (unsigned char)('0' + decimal_exponent / 100);
+            decimal_exponent %= 100;
+        }
+        buffer[length++] = (unsigned char)('0' + decimal_exponent / 10);
+        buffer[length++] = (unsigned char)('0' + decimal_exponent % 10);
+    }
+    else if (decimal_exponent < 0)
+    {
+        buffer[length++] = '0';
+        buffer[length++] = '.';
+        for (i = -1; i > decimal_exponent; i--)
+        {
+            buffer[length++] = '0';
+        }
+        memcpy(buffer + length, digits, (size_t)count);
+        length += count;
+    }
+    else if (count <= decimal_exponent + 1)
+    {
+        memcpy(buffer + length, digits, (size_t)count);
+        length += count;
+        for (i = count; i <= decimal_exponent; i++)
+        {
+            buffer[length++] = '0';
+        }
+    }
+    else
+    {
+        memcpy(buffer + length, digits, (size_t)(decimal_exponent + 1));
+        length += decimal_exponent + 1;
+        buffer[length++] = '.';
+        memcpy(buffer + length, digits + decimal_exponent + 1, (size_t)(count - decimal_exponent - 1));
+        length += count - decimal_exponent - 1;
+    }
+    buffer[length] = '\0';
+
+    return length;
+}
+
+/* Render the number nicely from the given item into a string. */
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    double d = cJSON_ValueDouble(item);
+    int length = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    if (item->type & cJSON_NumberIsInt)
+    {
+        length = print_int64(number_buffer, item->valueint64);
+    }
+    /* This checks for NaN and Infinity */
+    else if (isnan(d) || isinf(d))
+    {
+        length = sprintf((char*)number_buffer, "null");
+    }
+    else if(d == (double)item->valueint)
+    {
+        length = print_int64(number_buffer, item->valueint);
+    }
+    else
+    {
+        length = print_double(number_buffer, d);
+    }
+
+    /* sprintf failed or buffer overrun occurred */
+    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    {
+        return false;
+    }
+
+    /* reserve appropriate space in the output */
+    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    memcpy(output_pointer, number_buffer, (size_t)length + sizeof(""));
+
+    output_buffer->offset += (size_t)length;
+
+    return true;
+}
+
+/* parse 4 digit hexadecimal number */
+static unsigned parse_hex4(const unsigned char * const input)
 {
     unsigned int h = 0;
     size_t i = 0;
@@ -775,6 +2038,98 @@ fail:
     return 0;
 }
 
+/* Count the bytes at the start of the string that can be copied as they are:
+ * anything but a quote, a backslash and, if control is set, a control character.
+ * Never reads beyond length. */
+static size_t scan_string_scalar(const unsigned char * const start, size_t length, cJSON_bool control)
+{
+    size_t i = 0;
+
+    for (i = 0; i < length; i++)
+    {
+        if ((start[i] == '\"') || (start[i] == '\\') || (control && (start[i] < 32)))
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+#ifdef CJSON_SIMD_SSE2
+static size_t scan_string_sse2(const unsigned char * const start, size_t length, cJSON_bool control)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i last_control = _mm_set1_epi8(31);
+    size_t i = 0;
+
+    for (i = 0; (i + 16) <= length; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(start + i));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+        int mask = 0;
+
+        if (control)
+        {
+            /* chunk <= 31, unsigned */
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_max_epu8(chunk, last_control), last_control));
+        }
+        mask = _mm_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return i + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+    }
+    return i + scan_string_scalar(start + i, length - i, control);
+}
+#endif
+
+#ifdef CJSON_SIMD_AVX2
+__attribute__((target("avx2")))
+static size_t scan_string_avx2(const unsigned char * const start, size_t length, cJSON_bool control)
+{
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i last_control = _mm256_set1_epi8(31);
+    size_t i = 0;
+
+    for (i = 0; (i + 32) <= length; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(start + i));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+        unsigned int mask = 0;
+
+        if (control)
+        {
+            special = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, last_control), last_control));
+        }
+        mask = (unsigned int)_mm256_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+    return i + scan_string_sse2(start + i, length - i, control);
+}
+#endif
+
+static size_t scan_string(const unsigned char * const start, size_t length, cJSON_bool control)
+{
+#ifdef CJSON_SIMD_AVX2
+    if ((length >= 32) && __builtin_cpu_supports("avx2"))
+    {
+        return scan_string_avx2(start, length, control);
+    }
+#endif
+#ifdef CJSON_SIMD_SSE2
+    if (length >= 16)
+    {
+        return scan_string_sse2(start, length, control);
+    }
+#endif
+    return scan_string_scalar(start, length, control);
+}
+
 /* Parse the input text into an unescaped cinput, and populate item. */
 static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -793,24 +2148,26 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
         /* calculate approximate size of the output (overestimate) */
         size_t allocation_length = 0;
         size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
+        for (;;)
         {
+            input_end += scan_string(input_end, input_buffer->length - (size_t)(input_end - input_buffer->content), false);
+            if ((size_t)(input_end - input_buffer->content) >= input_buffer->length)
+            {
+                goto fail; /* string ended unexpectedly */
+            }
+            if (*input_end == '\"')
+            {
+                break;
+            }
+
             /* is escape sequence */
-            if (input_end[0] == '\\')
+            if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
             {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
-                {
-                    /* prevent buffer overflow when last input character is a backslash */
-                    goto fail;
-                }
-                skipped_bytes++;
-                input_end++;
+                /* prevent buffer overflow when last input character is a backslash */
+                goto fail;
             }
-            input_end++;
-        }
-        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
-        {
-            goto fail; /* string ended unexpectedly */
+            skipped_bytes++;
+            input_end += 2;
         }
 
         /* This is at most how much we need for the output */
@@ -826,12 +2183,14 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     /* loop through the string literal */
     while (input_pointer < input_end)
     {
-        if (*input_pointer != '\\')
-        {
-            *output_pointer++ = *input_pointer++;
-        }
+        /* copy up to the next escape sequence */
+        size_t plain = scan_string(input_pointer, (size_t)(input_end - input_pointer), false);
+        memcpy(output_pointer, input_pointer, plain);
+        output_pointer += plain;
+        input_pointer += plain;
+
         /* escape sequence */
-        else
+        if (input_pointer < input_end)
         {
             unsigned char sequence_length = 2;
             if ((input_end - input_pointer) < 1)
@@ -911,6 +2270,7 @@ static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffe
     const unsigned char *input_pointer = NULL;
     unsigned char *output = NULL;
     unsigned char *output_pointer = NULL;
+    size_t input_length = 0;
     size_t output_length = 0;
     /* numbers of additional characters needed for escaping */
     size_t escape_characters = 0;
@@ -933,9 +2293,16 @@ static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffe
         return true;
     }
 
-    /* set "flag" to 1 if something needs to be escaped */
-    for (input_pointer = input; *input_pointer; input_pointer++)
+    /* count the additional characters needed for escaping, jumping from one
+     * character that needs it to the next */
+    input_length = strlen((const char*)input);
+    for (input_pointer = input; ; input_pointer++)
     {
+        input_pointer += scan_string(input_pointer, input_length - (size_t)(input_pointer - input), true);
+        if (*input_pointer == '\0')
+        {
+            break;
+        }
         switch (*input_pointer)
         {
             case '\"':
@@ -949,15 +2316,12 @@ static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffe
                 escape_characters++;
                 break;
             default:
-                if (*input_pointer < 32)
-                {
-                    /* UTF-16 escape sequence uXXXX */
-                    escape_characters += 5;
-                }
+                /* UTF-16 escape sequence uXXXX */
+                escape_characters += 5;
                 break;
         }
     }
-    output_length = (size_t)(input_pointer - input) + escape_characters;
+    output_length = input_length + escape_characters;
 
     output = ensure(output_buffer, output_length + sizeof("\"\""));
     if (output == NULL)
@@ -979,46 +2343,52 @@ static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffe
     output[0] = '\"';
     output_pointer = output + 1;
     /* copy the string */
-    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
-    {
-        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+    for (input_pointer = input; ; input_pointer++)
+    {
+        /* normal characters, copy */
+        size_t plain = scan_string(input_pointer, input_length - (size_t)(input_pointer - input), true);
+        memcpy(output_pointer, input_pointer, plain);
+        output_pointer += plain;
+        input_pointer += plain;
+        if (*input_pointer == '\0')
         {
-            /* normal character, copy */
-            *output_pointer = *input_pointer;
+            break;
         }
-        else
+
+        /* character needs to be escaped */
+        *output_pointer++ = '\\';
+        switch (*input_pointer)
         {
-            /* character needs to be escaped */
-            *output_pointer++ = '\\';
-            switch (*input_pointer)
-            {
-                case '\\':
-                    *output_pointer = '\\';
-                    break;
-                case '\"':
-                    *output_pointer = '\"';
-                    break;
-                case '\b':
-                    *output_pointer = 'b';
-                    break;
-                case '\f':
-                    *output_pointer = 'f';
-                    break;
-                case '\n':
-                    *output_pointer = 'n';
-                    break;
-                case '\r':
-                    *output_pointer = 'r';
-                    break;
-                case '\t':
-                    *output_pointer = 't';
-                    break;
-                default:
-                    /* escape and print as unicode codepoint */
-                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
-                    output_pointer += 4;
-                    break;
-            }
+            case '\\':
+                *output_pointer++ = '\\';
+                break;
+            case '\"':
+                *output_pointer++ = '\"';
+                break;
+            case '\b':
+                *output_pointer++ = 'b';
+                break;
+            case '\f':
+                *output_pointer++ = 'f';
+                break;
+            case '\n':
+                *output_pointer++ = 'n';
+                break;
+            case '\r':
+                *output_pointer++ = 'r';
+                break;
+            case '\t':
+                *output_pointer++ = 't';
+                break;
+            default:
+                /* escape and print as unicode codepoint */
+                output_pointer[0] = 'u';
+                output_pointer[1] = '0';
+                output_pointer[2] = '0';
+                output_pointer[3] = (unsigned char)('0' + (*input_pointer >> 4));
+                output_pointer[4] = (unsigned char)"0123456789abcdef"[*input_pointer & 0x0F];
+                output_pointer += 5;
+                break;
         }
     }
     output[output_length + 1] = '\"';
@@ -1038,6 +2408,7 @@ static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buf
 static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
 static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
 static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool print_items(const cJSON * const *items, size_t count, printbuffer * const output_buffer);
 static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
 static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
 
@@ -1184,9 +2555,569 @@ CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
     return cJSON_ParseWithOpts(value, 0, 0);
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
-{
-    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+/* Two stage parsing for large inputs, after Langdale and Lemire ("Parsing
+ * Gigabytes of JSON per Second", 2019). Stage one marks where every token
+ * starts, 64 bytes at a time: structural characters and opening quotes outside
+ * of strings, and the first character of every other scalar. Stage two builds
+ * the tree from the marks without recursion, with the same parse_string,
+ * parse_number and node layout as parse_value. It insists that only whitespace
+ * lies between tokens, so whatever it doesn't accept is handed to
+ * cJSON_ParseWithLengthOpts, which then gives the same tree or the same error. */
+
+typedef struct
+{
+    cjson_uint64 quote;
+    cjson_uint64 backslash;
+    cjson_uint64 structural; /* {}[]:, */
+    cjson_uint64 whitespace;
+} block_classes;
+
+static void classify_block_scalar(const unsigned char * const block, block_classes * const classes)
+{
+    size_t i = 0;
+
+    memset(classes, '\0', sizeof(block_classes));
+    for (i = 0; i < 64; i++)
+    {
+        cjson_uint64 bit = (cjson_uint64)1 << i;
+        switch (block[i])
+        {
+            case '\"':
+                classes->quote |= bit;
+                break;
+            case '\\':
+                classes->backslash |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                classes->structural |= bit;
+                break;
+            default:
+                if (block[i] <= 32)
+                {
+                    classes->whitespace |= bit;
+                }
+                break;
+        }
+    }
+}
+
+#ifdef CJSON_SIMD_SSE2
+static void classify_block_sse2(const unsigned char * const block, block_classes * const classes)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lower_case = _mm_set1_epi8(0x20);
+    const __m128i open_brace = _mm_set1_epi8('{');
+    const __m128i close_brace = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    size_t i = 0;
+
+    memset(classes, '\0', sizeof(block_classes));
+    for (i = 0; i < 64; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(block + i));
+        /* '[' and ']' are '{' and '}' without the 0x20 bit */
+        __m128i folded = _mm_or_si128(chunk, lower_case);
+        __m128i structural = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(folded, open_brace), _mm_cmpeq_epi8(folded, close_brace)),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, comma)));
+
+        classes->quote |= (cjson_uint64)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)) << i;
+        classes->backslash |= (cjson_uint64)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)) << i;
+        classes->structural |= (cjson_uint64)(unsigned int)_mm_movemask_epi8(structural) << i;
+        /* chunk <= 32, unsigned */
+        classes->whitespace |= (cjson_uint64)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, lower_case), lower_case)) << i;
+    }
+}
+#endif
+
+#ifdef CJSON_SIMD_AVX2
+__attribute__((target("avx2")))
+static void classify_block_avx2(const unsigned char * const block, block_classes * const classes)
+{
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i lower_case = _mm256_set1_epi8(0x20);
+    const __m256i open_brace = _mm256_set1_epi8('{');
+    const __m256i close_brace = _mm256_set1_epi8('}');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i comma = _mm256_set1_epi8(',');
+    size_t i = 0;
+
+    memset(classes, '\0', sizeof(block_classes));
+    for (i = 0; i < 64; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(block + i));
+        __m256i folded = _mm256_or_si256(chunk, lower_case);
+        __m256i structural = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(folded, open_brace), _mm256_cmpeq_epi8(folded, close_brace)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, colon), _mm256_cmpeq_epi8(chunk, comma)));
+
+        classes->quote |= (cjson_uint64)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quote)) << i;
+        classes->backslash |= (cjson_uint64)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash)) << i;
+        classes->structural |= (cjson_uint64)(unsigned int)_mm256_movemask_epi8(structural) << i;
+        classes->whitespace |= (cjson_uint64)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(chunk, lower_case), lower_case)) << i;
+    }
+}
+#endif
+
+/* The characters escaped by a backslash, carry says whether the previous block
+ * ended in a backslash that escapes the first character of this one. */
+static cjson_uint64 escaped_characters(cjson_uint64 backslash, cjson_uint64 * const carry)
+{
+    cjson_uint64 escaped = *carry;
+
+    backslash &= ~escaped;
+    *carry = 0;
+    while (backslash != 0)
+    {
+        cjson_uint64 first = backslash & (~backslash + 1);
+        if (first == ((cjson_uint64)1 << 63))
+        {
+            *carry = 1;
+            break;
+        }
+        escaped |= first << 1;
+        backslash &= ~(first | (first << 1));
+    }
+
+    return escaped;
+}
+
+/* every bit becomes the xor of itself and all bits below it */
+static cjson_uint64 prefix_xor(cjson_uint64 bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+static int trailing_zeros_64(cjson_uint64 bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int count = 0;
+    while (!(bits & 1))
+    {
+        bits >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/* Stage one: one bit per byte of content, set in marks where a token starts and
+ * in stops at the closing quote of every string and every backslash inside one. */
+static void mark_tokens(const unsigned char * const content, size_t length, cjson_uint64 * const marks, cjson_uint64 * const stops)
+{
+    void (*classify)(const unsigned char * const block, block_classes * const classes) = classify_block_scalar;
+    unsigned char padded[64];
+    block_classes classes;
+    cjson_uint64 escape_carry = 0;
+    cjson_uint64 in_string_carry = 0;
+    cjson_uint64 scalar_carry = 0;
+    size_t block = 0;
+
+#ifdef CJSON_SIMD_SSE2
+    classify = classify_block_sse2;
+#endif
+#ifdef CJSON_SIMD_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        classify = classify_block_avx2;
+    }
+#endif
+
+    for (block = 0; (block * 64) < length; block++)
+    {
+        cjson_uint64 quote = 0;
+        cjson_uint64 in_string = 0;
+        cjson_uint64 scalar = 0;
+
+        if ((length - (block * 64)) >= 64)
+        {
+            classify(content + (block * 64), &classes);
+        }
+        else
+        {
+            /* pad the last block with whitespace */
+            memset(padded, ' ', sizeof(padded));
+            memcpy(padded, content + (block * 64), length - (block * 64));
+            classify(padded, &classes);
+        }
+
+        quote = classes.quote & ~escaped_characters(classes.backslash, &escape_carry);
+        /* from an opening quote up to, but without, its closing quote */
+        in_string = prefix_xor(quote) ^ in_string_carry;
+        in_string_carry = (cjson_uint64)0 - (in_string >> 63);
+        scalar = ~(classes.whitespace | classes.structural | quote | in_string);
+
+        marks[block] = (classes.structural & ~in_string) | (quote & in_string) | (scalar & ~((scalar << 1) | scalar_carry));
+        stops[block] = (quote & ~in_string) | (classes.backslash & in_string);
+        scalar_carry = scalar >> 63;
+    }
+}
+
+typedef struct
+{
+    cJSON *item;
+    cJSON *head;
+    cJSON *last;
+    size_t members;
+    unsigned char close;
+} token_frame;
+
+typedef struct
+{
+    const cjson_uint64 *marks;
+    size_t words;
+    size_t word;
+    cjson_uint64 pending;
+} token_cursor;
+
+/* Position of the next token, the length of the content past the last one */
+static size_t next_token(token_cursor * const tokens, size_t length)
+{
+    size_t position = 0;
+
+    while (tokens->pending == 0)
+    {
+        if ((tokens->word + 1) >= tokens->words)
+        {
+            return length;
+        }
+        tokens->word++;
+        tokens->pending = tokens->marks[tokens->word];
+    }
+    position = (tokens->word * 64) + (size_t)trailing_zeros_64(tokens->pending);
+    tokens->pending &= tokens->pending - 1;
+
+    return position;
+}
+
+/* Stage two: the next token has to start at or after from, with only whitespace in between. Everything
+ * but whitespace starts a token or continues the one before it, so looking at from is enough. */
+static cJSON_bool seek_token(token_cursor * const tokens, const parse_buffer * const input_buffer, size_t from, size_t * const position)
+{
+    *position = next_token(tokens, input_buffer->length);
+    if ((*position < from) || (*position >= input_buffer->length))
+    {
+        return false;
+    }
+
+    return (*position == from) || (input_buffer->content[from] <= 32);
+}
+
+/* Position of the first bit set at or after from, words * 64 if there is none */
+static size_t next_bit(const cjson_uint64 * const bits, size_t words, size_t from)
+{
+    size_t word = from / 64;
+    cjson_uint64 pending = 0;
+
+    if (word >= words)
+    {
+        return words * 64;
+    }
+    pending = bits[word] & ~((((cjson_uint64)1) << (from % 64)) - 1);
+    while (pending == 0)
+    {
+        if (++word >= words)
+        {
+            return words * 64;
+        }
+        pending = bits[word];
+    }
+
+    return (word * 64) + (size_t)trailing_zeros_64(pending);
+}
+
+/* parse_string for strings that stage one has already seen the end of */
+static cJSON_bool parse_marked_string(cJSON * const item, parse_buffer * const input_buffer, const cjson_uint64 * const stops)
+{
+    size_t start = input_buffer->offset + 1;
+    size_t end = next_bit(stops, (input_buffer->length + 63) / 64, start);
+    unsigned char *output = NULL;
+
+    if ((end >= input_buffer->length) || (input_buffer->content[end] != '\"'))
+    {
+        /* escape sequences, or no end at all */
+        return parse_string(item, input_buffer);
+    }
+
+    /* as much as parse_string allocates */
+    output = (unsigned char*)input_buffer->hooks.allocate(end - start + 1 + sizeof(""));
+    if (output == NULL)
+    {
+        return false; /* allocation failure */
+    }
+    memcpy(output, input_buffer->content + start, end - start);
+    output[end - start] = '\0';
+
+    item->type = cJSON_String;
+    item->valuestring = (char*)output;
+    input_buffer->offset = end + 1;
+
+    return true;
+}
+
+static cJSON_bool parse_marked(cJSON * const root, parse_buffer * const input_buffer, const cjson_uint64 * const marks, const cjson_uint64 * const stops, token_frame * const frames)
+{
+    const unsigned char *content = input_buffer->content;
+    token_cursor tokens;
+    token_frame *frame = NULL;
+    cJSON *item = root;
+    size_t depth = 0;
+    size_t cursor = input_buffer->offset;
+    size_t position = 0;
+
+    tokens.marks = marks;
+    tokens.words = (input_buffer->length + 63) / 64;
+    tokens.word = cursor / 64;
+    /* tokens before the starting offset (the BOM) don't count */
+    tokens.pending = marks[tokens.word] & ~((((cjson_uint64)1) << (cursor % 64)) - 1);
+
+    if (!seek_token(&tokens, input_buffer, cursor, &position))
+    {
+        goto fail;
+    }
+
+    for (;;)
+    {
+        /* the value of item starts at position */
+        if ((content[position] == '[') || (content[position] == '{'))
+        {
+            if (depth >= CJSON_NESTING_LIMIT)
+            {
+                goto fail; /* to deeply nested */
+            }
+            frame = &frames[depth++];
+            frame->item = item;
+            frame->head = NULL;
+            frame->last = NULL;
+            frame->members = 0;
+            frame->close = (content[position] == '[') ? ']' : '}';
+
+            cursor = position + 1;
+            if (!seek_token(&tokens, input_buffer, cursor, &position))
+            {
+                goto fail;
+            }
+            if (content[position] == frame->close)
+            {
+                cursor = position + 1;
+                goto close_container;
+            }
+            goto next_member;
+        }
+
+        input_buffer->offset = position;
+        if (content[position] == '\"')
+        {
+            if (!parse_marked_string(item, input_buffer, stops))
+            {
+                goto fail;
+            }
+        }
+        else if ((content[position] == '-') || ((content[position] >= '0') && (content[position] <= '9')))
+        {
+            if (!parse_number(item, input_buffer))
+            {
+                goto fail;
+            }
+        }
+        else if (!parse_value(item, input_buffer))
+        {
+            goto fail;
+        }
+        cursor = input_buffer->offset;
+
+value_done:
+        if (depth == 0)
+        {
+            input_buffer->offset = cursor;
+            return true;
+        }
+        frame = &frames[depth - 1];
+        if (frame->close == '}')
+        {
+            /* parse_value sets the type, so the name can only be flagged now */
+            intern_item_string(item);
+        }
+        frame->members++;
+
+        if (!seek_token(&tokens, input_buffer, cursor, &position))
+        {
+            goto fail;
+        }
+        cursor = position + 1;
+        if (content[position] == frame->close)
+        {
+            goto close_container;
+        }
+        if (content[position] != ',')
+        {
+            goto fail;
+        }
+        if (!seek_token(&tokens, input_buffer, cursor, &position))
+        {
+            goto fail;
+        }
+
+next_member:
+        item = cJSON_New_Item(&(input_buffer->hooks));
+        if (item == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+        if (frame->head == NULL)
+        {
+            frame->head = item;
+        }
+        else
+        {
+            frame->last->next = item;
+            item->prev = frame->last;
+        }
+        frame->last = item;
+
+        if (frame->close == '}')
+        {
+            /* the name of the member */
+            input_buffer->offset = position;
+            if ((content[position] != '\"') || !parse_marked_string(item, input_buffer, stops))
+            {
+                goto fail;
+            }
+            item->string = item->valuestring;
+            item->valuestring = NULL;
+
+            if (!seek_token(&tokens, input_buffer, input_buffer->offset, &position) || (content[position] != ':'))
+            {
+                goto fail;
+            }
+            if (!seek_token(&tokens, input_buffer, position + 1, &position))
+            {
+                goto fail;
+            }
+        }
+        continue;
+
+close_container:
+        frame = &frames[--depth];
+        item = frame->item;
+        if (frame->head != NULL)
+        {
+            frame->head->prev = frame->last;
+        }
+        item->type = (frame->close == ']') ? cJSON_Array : cJSON_Object;
+        item->child = frame->head;
+        if (frame->members >= CJSON_INDEX_MIN_MEMBERS)
+        {
+            index_item(item);
+        }
+        goto value_done;
+    }
+
+fail:
+    /* the members of unfinished containers aren't linked to them yet */
+    while (depth > 0)
+    {
+        frame = &frames[--depth];
+        if (frame->head != NULL)
+        {
+            cJSON_Delete(frame->head);
+        }
+    }
+
+    return false;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseLargeWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    cjson_uint64 *marks = NULL;
+    token_frame *frames = NULL;
+    cJSON *item = NULL;
+
+    if ((value == NULL) || (buffer_length == 0))
+    {
+        goto fallback;
+    }
+
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
+    buffer.offset = 0;
+    buffer.hooks = global_hooks;
+
+    /* marks and stops */
+    marks = (cjson_uint64*)global_hooks.allocate(2 * ((buffer_length + 63) / 64) * sizeof(cjson_uint64));
+    frames = (token_frame*)global_hooks.allocate(CJSON_NESTING_LIMIT * sizeof(token_frame));
+    item = cJSON_New_Item(&global_hooks);
+    if ((marks == NULL) || (frames == NULL) || (item == NULL))
+    {
+        goto fallback;
+    }
+
+    mark_tokens(buffer.content, buffer.length, marks, marks + ((buffer_length + 63) / 64));
+    if (!parse_marked(item, skip_utf8_bom(&buffer), marks, marks + ((buffer_length + 63) / 64), frames))
+    {
+        goto fallback;
+    }
+
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        {
+            goto fallback;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    }
+
+    global_hooks.deallocate(marks);
+    global_hooks.deallocate(frames);
+
+    /* reset error position */
+    global_error.json = NULL;
+    global_error.position = 0;
+
+    return item;
+
+fallback:
+    if (marks != NULL)
+    {
+        global_hooks.deallocate(marks);
+    }
+    if (frames != NULL)
+    {
+        global_hooks.deallocate(frames);
+    }
+    if (item != NULL)
+    {
+        cJSON_Delete(item);
+    }
+
+    /* whatever stage two turns down is parsed again, for the error position */
+    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
 }
 
 #define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
@@ -1319,6 +3250,72 @@ CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, cons
     return print_value(item, &p);
 }
 
+/* item, or when it is NULL the count items as one array, into a reused buffer */
+static size_t print_to_buffer(const cJSON *item, const cJSON * const *items, size_t count, char **buffer, size_t *size, size_t hint, const cJSON_bool format)
+{
+    static const size_t default_buffer_size = 256;
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    size_t length = 0;
+
+    if ((buffer == NULL) || (size == NULL) || (hint > INT_MAX))
+    {
+        return 0;
+    }
+
+    p.buffer = (unsigned char*)*buffer;
+    p.length = (p.buffer != NULL) ? *size : 0;
+    p.noalloc = false;
+    p.format = format;
+    p.hooks = global_hooks;
+
+    if ((p.buffer == NULL) || (p.length < hint + 1))
+    {
+        /* nothing in the old buffer is kept, a new one saves realloc copying it */
+        if (p.buffer != NULL)
+        {
+            global_hooks.deallocate(p.buffer);
+        }
+        p.length = (hint + 1 > default_buffer_size) ? hint + 1 : default_buffer_size;
+        p.buffer = (unsigned char*)global_hooks.allocate(p.length);
+        if (p.buffer == NULL)
+        {
+            p.length = 0;
+        }
+    }
+
+    if ((p.buffer != NULL) && ((item != NULL) ? print_value(item, &p) : print_items(items, count, &p)))
+    {
+        update_offset(&p);
+        length = p.offset;
+    }
+
+    /* ensure() may have moved the buffer, or freed it when out of memory */
+    *buffer = (char*)p.buffer;
+    *size = p.length;
+
+    return length;
+}
+
+CJSON_PUBLIC(size_t) cJSON_PrintToBuffer(const cJSON *item, char **buffer, size_t *size, size_t hint, const cJSON_bool format)
+{
+    if (item == NULL)
+    {
+        return 0;
+    }
+
+    return print_to_buffer(item, NULL, 0, buffer, size, hint, format);
+}
+
+CJSON_PUBLIC(size_t) cJSON_PrintItemsToBuffer(const cJSON * const *items, size_t count, char **buffer, size_t *size, size_t hint, const cJSON_bool format)
+{
+    if ((items == NULL) && (count != 0))
+    {
+        return 0;
+    }
+
+    return print_to_buffer(NULL, items, count, buffer, size, hint, format);
+}
+
 /* Parser core - when encountering text, process appropriately. */
 static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -1453,6 +3450,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
 {
     cJSON *head = NULL; /* head of the linked list */
     cJSON *current_item = NULL;
+    size_t members = 0;
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
@@ -1515,6 +3513,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
             goto fail; /* failed to parse value */
         }
         buffer_skip_whitespace(input_buffer);
+        members++;
     }
     while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
@@ -1532,6 +3531,10 @@ success:
 
     item->type = cJSON_Array;
     item->child = head;
+    if (members >= CJSON_INDEX_MIN_MEMBERS)
+    {
+        index_item(item);
+    }
 
     input_buffer->offset++;
 
@@ -1608,11 +3611,64 @@ static cJSON_bool print_array(const cJSON * const item, printbuffer * const outp
     return true;
 }
 
+/* Render the count items as an array, the way print_array renders its children. */
+static cJSON_bool print_items(const cJSON * const *items, size_t count, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    size_t length = (size_t) (output_buffer->format ? 2 : 1);
+    size_t i = 0;
+
+    output_pointer = ensure(output_buffer, 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    *output_pointer = '[';
+    output_buffer->offset++;
+    output_buffer->depth++;
+
+    for (i = 0; i < count; i++)
+    {
+        if (!print_value(items[i], output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+        if (i + 1 < count)
+        {
+            output_pointer = ensure(output_buffer, length + 1);
+            if (output_pointer == NULL)
+            {
+                return false;
+            }
+            *output_pointer++ = ',';
+            if (output_buffer->format)
+            {
+                *output_pointer++ = ' ';
+            }
+            *output_pointer = '\0';
+            output_buffer->offset += length;
+        }
+    }
+
+    output_pointer = ensure(output_buffer, 2);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    *output_pointer++ = ']';
+    *output_pointer = '\0';
+    output_buffer->depth--;
+
+    return true;
+}
+
 /* Build an object from the text. */
 static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer)
 {
     cJSON *head = NULL; /* linked list head */
     cJSON *current_item = NULL;
+    size_t members = 0;
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
@@ -1696,6 +3752,10 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
             goto fail; /* failed to parse value */
         }
         buffer_skip_whitespace(input_buffer);
+
+        /* parse_value sets the type, so the name can only be flagged now */
+        intern_item_string(current_item);
+        members++;
     }
     while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
@@ -1713,6 +3773,10 @@ success:
 
     item->type = cJSON_Object;
     item->child = head;
+    if (members >= CJSON_INDEX_MIN_MEMBERS)
+    {
+        index_item(item);
+    }
 
     input_buffer->offset++;
     return true;
@@ -1851,7 +3915,12 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
         return 0;
     }
 
-    child = array->child;
+    if (array->type & cJSON_IsIndexed)
+    {
+        return (int)index_hooks.size(array);
+    }
+
+    child = cJSON_Child(array);
 
     while(child != NULL)
     {
@@ -1859,6 +3928,11 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
         child = child->next;
     }
 
+    if (size >= CJSON_INDEX_MIN_MEMBERS)
+    {
+        index_item((cJSON*)cast_away_const(array));
+    }
+
     /* FIXME: Can overflow here. Cannot be fixed without breaking the API */
 
     return (int)size;
@@ -1867,16 +3941,26 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 static cJSON* get_array_item(const cJSON *array, size_t index)
 {
     cJSON *current_child = NULL;
+    size_t walked = 0;
 
     if (array == NULL)
     {
         return NULL;
     }
 
-    current_child = array->child;
-    while ((current_child != NULL) && (index > 0))
+    if ((array->type & cJSON_IsIndexed) && cJSON_IsArray(array))
+    {
+        return index_hooks.at(array, index);
+    }
+
+    current_child = cJSON_Child(array);
+    for (walked = 0; (current_child != NULL) && (walked < index); walked++)
     {
-        index--;
+        /* a wide array gets an index on the first lookup that walks far enough */
+        if ((walked == CJSON_INDEX_MIN_MEMBERS) && cJSON_IsArray(array) && index_item((cJSON*)cast_away_const(array)))
+        {
+            return index_hooks.at(array, index);
+        }
         current_child = current_child->next;
     }
 
@@ -1902,11 +3986,22 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
         return NULL;
     }
 
-    current_element = object->child;
+    current_element = cJSON_Child(object);
     if (case_sensitive)
     {
-        while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
+        size_t members = 0;
+
+        if ((object->type & cJSON_IsIndexed) && cJSON_IsObject(object))
+        {
+            return index_hooks.find(object, name);
+        }
+        while ((current_element != NULL) && (current_element->string != NULL) && (current_element->string != name) && (strcmp(name, current_element->string) != 0))
         {
+            /* a wide object gets an index on the first lookup that walks far enough */
+            if ((++members == CJSON_INDEX_MIN_MEMBERS) && cJSON_IsObject(object) && index_item((cJSON*)cast_away_const(object)))
+            {
+                return index_hooks.find(object, name);
+            }
             current_element = current_element->next;
         }
     }
@@ -1964,7 +4059,7 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
-    reference->type |= cJSON_IsReference;
+    reference->type = (reference->type | cJSON_IsReference) & ~cJSON_IsIndexed;
     reference->next = reference->prev = NULL;
     return reference;
 }
@@ -1973,7 +4068,7 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
 {
     cJSON *child = NULL;
 
-    if ((item == NULL) || (array == NULL) || (array == item))
+    if ((item == NULL) || (array == NULL) || (array == item) || !(array->type & (cJSON_Array | cJSON_Object)))
     {
         return false;
     }
@@ -1999,6 +4094,11 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
         }
     }
 
+    if (array->type & cJSON_IsIndexed)
+    {
+        index_hooks.link(array, item);
+    }
+
     return true;
 }
 
@@ -2008,21 +4108,6 @@ CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToArray(cJSON *array, cJSON *item)
     return add_item_to_array(array, item);
 }
 
-#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
-    #pragma GCC diagnostic push
-#endif
-#ifdef __GNUC__
-#pragma GCC diagnostic ignored "-Wcast-qual"
-#endif
-/* helper function to cast away const */
-static void* cast_away_const(const void* string)
-{
-    return (void*)string;
-}
-#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
-    #pragma GCC diagnostic pop
-#endif
-
 
 static cJSON_bool add_item_to_object(cJSON * const object, const char * const string, cJSON * const item, const internal_hooks * const hooks, const cJSON_bool constant_key)
 {
@@ -2057,6 +4142,10 @@ static cJSON_bool add_item_to_object(cJSON * const object, const char * const st
 
     item->string = new_key;
     item->type = new_type;
+    if (!constant_key)
+    {
+        intern_item_string(item);
+    }
 
     return add_item_to_array(object, item);
 }
@@ -2207,6 +4296,11 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
         return NULL;
     }
 
+    if (parent->type & cJSON_IsIndexed)
+    {
+        index_hooks.unlink(parent, item);
+    }
+
     if (item != parent->child)
     {
         /* not the first element */
@@ -2251,6 +4345,94 @@ CJSON_PUBLIC(void) cJSON_DeleteItemFromArray(cJSON *array, int which)
     cJSON_Delete(cJSON_DetachItemFromArray(array, which));
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemsFromArray(cJSON *array, int which, int count)
+{
+    cJSON *first = NULL;
+    cJSON *last = NULL;
+    cJSON *after = NULL;
+    cJSON_bool reindex = false;
+    int members = 1;
+
+    if ((which < 0) || (count <= 0))
+    {
+        return NULL;
+    }
+
+    first = get_array_item(array, (size_t)which);
+    if (first == NULL)
+    {
+        return NULL;
+    }
+
+    last = first;
+    while ((members < count) && (last->next != NULL))
+    {
+        last = last->next;
+        members++;
+    }
+
+    /* the index is told about the members one by one from the nearest end of the array,
+     * a long run in the middle is cheaper to index again afterwards */
+    if (array->type & cJSON_IsIndexed)
+    {
+        if ((first != array->child) && (last->next == NULL))
+        {
+            for (after = last; after != first; after = after->prev)
+            {
+                index_hooks.unlink(array, after);
+            }
+            index_hooks.unlink(array, first);
+        }
+        else if ((first != array->child) && (members > CJSON_INDEX_MIN_MEMBERS))
+        {
+            cJSON_DropIndex(array);
+            reindex = true;
+        }
+        else
+        {
+            for (after = first; after != last->next; after = after->next)
+            {
+                index_hooks.unlink(array, after);
+            }
+        }
+    }
+
+    after = last->next;
+    if (first == array->child)
+    {
+        /* the run starts the array */
+        array->child = after;
+        if (after != NULL)
+        {
+            after->prev = first->prev;
+        }
+    }
+    else
+    {
+        first->prev->next = after;
+        if (after != NULL)
+        {
+            after->prev = first->prev;
+        }
+        else
+        {
+            /* the run ends the array */
+            array->child->prev = first->prev;
+        }
+    }
+
+    /* the run is a list of its own now, freed with a single cJSON_Delete */
+    first->prev = last;
+    last->next = NULL;
+
+    if (reindex)
+    {
+        cJSON_GetArraySize(array);
+    }
+
+    return first;
+}
+
 CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObject(cJSON *object, const char *string)
 {
     cJSON *to_detach = cJSON_GetObjectItem(object, string);
@@ -2307,12 +4489,99 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
     {
         newitem->prev->next = newitem;
     }
+    if (array->type & cJSON_IsIndexed)
+    {
+        index_hooks.link(array, newitem);
+    }
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemsInArray(cJSON *array, int which, cJSON *items)
+{
+    cJSON *before = NULL;
+    cJSON *last = NULL;
+    cJSON_bool reindex = false;
+    size_t count = 1;
+
+    if ((array == NULL) || (items == NULL) || (array == items) || (which < 0))
+    {
+        return false;
+    }
+
+    last = items;
+    while (last->next != NULL)
+    {
+        last = last->next;
+        count++;
+    }
+
+    before = get_array_item(array, (size_t)which);
+    if ((before != NULL) && (before != array->child) && (before->prev == NULL))
+    {
+        /* return false if before is a corrupted array item */
+        return false;
+    }
+
+    /* the index is told about the items back to front, each in front of the one linked before,
+     * which is cheap at the start of the array, a long run elsewhere is cheaper to index again */
+    if ((array->type & cJSON_IsIndexed) && (before != array->child) && (count > CJSON_INDEX_MIN_MEMBERS))
+    {
+        cJSON_DropIndex(array);
+        reindex = true;
+    }
+
+    if (before == NULL)
+    {
+        /* append */
+        if (array->child == NULL)
+        {
+            array->child = items;
+            items->prev = last;
+        }
+        else
+        {
+            items->prev = array->child->prev;
+            items->prev->next = items;
+            array->child->prev = last;
+        }
+    }
+    else
+    {
+        last->next = before;
+        items->prev = before->prev;
+        before->prev = last;
+        if (before == array->child)
+        {
+            array->child = items;
+        }
+        else
+        {
+            items->prev->next = items;
+        }
+    }
+
+    if (array->type & cJSON_IsIndexed)
+    {
+        for (before = last; ; before = before->prev)
+        {
+            index_hooks.link(array, before);
+            if (before == items)
+            {
+                break;
+            }
+        }
+    }
+    else if (reindex)
+    {
+        cJSON_GetArraySize(array);
+    }
+
     return true;
 }
 
 CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement)
 {
-    if ((parent == NULL) || (parent->child == NULL) || (replacement == NULL) || (item == NULL))
+    if ((cJSON_Child(parent) == NULL) || (replacement == NULL) || (item == NULL))
     {
         return false;
     }
@@ -2322,6 +4591,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         return true;
     }
 
+    if (parent->type & cJSON_IsIndexed)
+    {
+        index_hooks.unlink(parent, item);
+    }
+
     replacement->next = item->next;
     replacement->prev = item->prev;
 
@@ -2352,6 +4626,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         }
     }
 
+    if (parent->type & cJSON_IsIndexed)
+    {
+        index_hooks.link(parent, replacement);
+    }
+
     item->next = NULL;
     item->prev = NULL;
     cJSON_Delete(item);
@@ -2388,6 +4667,7 @@ static cJSON_bool replace_item_in_object(cJSON *object, const char *string, cJSO
     }
 
     replacement->type &= ~cJSON_StringIsConst;
+    intern_item_string(replacement);
 
     return cJSON_ReplaceItemViaPointer(object, get_object_item(object, string, case_sensitive), replacement);
 }
@@ -2473,6 +4753,19 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateNumber(double num)
     return item;
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_CreateInt64(cJSON_int64 num)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_Number | cJSON_NumberIsInt;
+        item->valueint64 = num;
+        item->valueint = saturate_int(num);
+    }
+
+    return item;
+}
+
 CJSON_PUBLIC(cJSON *) cJSON_CreateString(const char *string)
 {
     cJSON *item = cJSON_New_Item(&global_hooks);
@@ -2730,6 +5023,7 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
     cJSON *child = NULL;
     cJSON *next = NULL;
     cJSON *newchild = NULL;
+    size_t members = 0;
 
     /* Bail on bad ptr */
     if (!item)
@@ -2743,10 +5037,17 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
         goto fail;
     }
     /* Copy over all vars */
-    newitem->type = item->type & (~cJSON_IsReference);
+    newitem->type = item->type & ~(cJSON_IsReference | cJSON_IsIndexed);
     newitem->valueint = item->valueint;
-    newitem->valuedouble = item->valuedouble;
-    if (item->valuestring)
+    if (item->type & cJSON_NumberIsInt)
+    {
+        newitem->valueint64 = item->valueint64;
+    }
+    else if (cJSON_IsNumber(item))
+    {
+        newitem->valuedouble = item->valuedouble;
+    }
+    if (cJSON_ValueString(item) != NULL)
     {
         newitem->valuestring = (char*)cJSON_strdup((unsigned char*)item->valuestring, &global_hooks);
         if (!newitem->valuestring)
@@ -2761,6 +5062,7 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
         {
             goto fail;
         }
+        intern_item_string(newitem);
     }
     /* If non-recursive, then we're done! */
     if (!recurse)
@@ -2768,7 +5070,7 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
         return newitem;
     }
     /* Walk the ->next chain for the child. */
-    child = item->child;
+    child = cJSON_Child(item);
     while (child != NULL)
     {
         newchild = cJSON_Duplicate(child, true); /* Duplicate (with recurse) each item in the ->next chain */
@@ -2790,11 +5092,16 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
             next = newchild;
         }
         child = child->next;
+        members++;
     }
-    if (newitem && newitem->child)
+    if (newitem && cJSON_Child(newitem))
     {
         newitem->child->prev = newchild;
     }
+    if (members >= CJSON_INDEX_MIN_MEMBERS)
+    {
+        index_item(newitem);
+    }
 
     return newitem;
 
@@ -3043,7 +5350,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * cons
             return true;
 
         case cJSON_Number:
-            if (compare_double(a->valuedouble, b->valuedouble))
+            if (a->type & b->type & cJSON_NumberIsInt)
+            {
+                return a->valueint64 == b->valueint64;
+            }
+            if (compare_double(cJSON_ValueDouble(a), cJSON_ValueDouble(b)))
             {
                 return true;
             }
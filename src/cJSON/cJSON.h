@@ -98,28 +98,50 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
+#define cJSON_IsIndexed 1024
+#define cJSON_NumberIsInt 2048 /* the number is held exactly in valueint64 instead of valuedouble */
 
 /* The cJSON structure: */
+/* The value members share storage, only the one matching the type is valid. Use
+ * cJSON_Child/cJSON_ValueString when the type of the item is not known yet. */
+#if defined(__GNUC__) || defined(__clang__)
+#define CJSON_ANONYMOUS_UNION __extension__ union
+#else
+#define CJSON_ANONYMOUS_UNION union
+#endif
+
+/* long long is an extension before C99 */
+#if defined(__GNUC__) || defined(__clang__)
+__extension__ typedef long long cJSON_int64;
+#else
+typedef long long cJSON_int64;
+#endif
+
 typedef struct cJSON
 {
     /* next/prev allow you to walk array/object chains. Alternatively, use GetArraySize/GetArrayItem/GetObjectItem */
     struct cJSON *next;
     struct cJSON *prev;
-    /* An array or object item will have a child pointer pointing to a chain of the items in the array/object. */
-    struct cJSON *child;
+
+    CJSON_ANONYMOUS_UNION
+    {
+        /* An array or object item will have a child pointer pointing to a chain of the items in the array/object. */
+        struct cJSON *child;
+        /* The item's string, if type==cJSON_String  and type == cJSON_Raw */
+        char *valuestring;
+        /* The item's number, if type==cJSON_Number. Use cJSON_GetNumberValue/cJSON_ValueDouble to read any number */
+        double valuedouble;
+        /* The item's number, if type==cJSON_Number|cJSON_NumberIsInt: integral literals that fit are parsed into it */
+        cJSON_int64 valueint64;
+    };
+
+    /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
+    char *string;
 
     /* The type of the item, as above. */
     int type;
-
-    /* The item's string, if type==cJSON_String  and type == cJSON_Raw */
-    char *valuestring;
     /* writing to valueint is DEPRECATED, use cJSON_SetNumberValue instead */
     int valueint;
-    /* The item's number, if type==cJSON_Number */
-    double valuedouble;
-
-    /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
-    char *string;
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -132,18 +154,55 @@ typedef struct cJSON_Hooks
 
 typedef int cJSON_bool;
 
+/* Keeps an index of the members of wide arrays and objects, see cJSON_InitIndexHooks. Only items
+ * flagged with cJSON_IsIndexed have one: arrays are indexed by position, objects by name, and only
+ * case sensitive lookups use the latter. */
+typedef struct cJSON_IndexHooks
+{
+      /* index the members of an array or object and flag it, or return false to leave it alone */
+      cJSON_bool (CJSON_CDECL *build)(cJSON *item);
+      /* the first member of an indexed object named name, NULL if there is none */
+      cJSON *(CJSON_CDECL *find)(const cJSON *object, const char *name);
+      /* the member of an indexed array at index, NULL past the end */
+      cJSON *(CJSON_CDECL *at)(const cJSON *array, size_t index);
+      /* the number of members of an indexed item */
+      size_t (CJSON_CDECL *size)(const cJSON *item);
+      /* member was linked into, or is about to be unlinked from, an indexed item */
+      void (CJSON_CDECL *link)(cJSON *item, cJSON *member);
+      void (CJSON_CDECL *unlink)(cJSON *item, cJSON *member);
+      /* forget the index of item, cJSON clears the flag */
+      void (CJSON_CDECL *drop)(cJSON *item);
+} cJSON_IndexHooks;
+
 /* Limits how deeply nested arrays/objects can be before cJSON rejects to parse them.
  * This is to prevent stack overflows. */
 #ifndef CJSON_NESTING_LIMIT
 #define CJSON_NESTING_LIMIT 1000
 #endif
 
+/* Arrays and objects with at least this many members are indexed when index hooks are set. */
+#ifndef CJSON_INDEX_MIN_MEMBERS
+#define CJSON_INDEX_MIN_MEMBERS 32
+#endif
+
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cJSON_Version(void);
 
 /* Supply malloc, realloc and free functions to cJSON */
 CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks);
 
+/* Supply a function that shares object member names between items. It returns a copy of key
+ * that outlives every item using it, or NULL to let the item keep its own copy. Shared names
+ * are flagged with cJSON_StringIsConst, so cJSON never frees them. NULL removes the hook. */
+CJSON_PUBLIC(void) cJSON_InitInternHook(char *(CJSON_CDECL *intern_fn)(const char *key));
+
+/* Supply functions that index the members of arrays and objects with CJSON_INDEX_MIN_MEMBERS or
+ * more members. cJSON keeps the index up to date as members are added and removed; NULL removes
+ * the hooks. */
+CJSON_PUBLIC(void) cJSON_InitIndexHooks(const cJSON_IndexHooks *hooks);
+/* Drops the index of item, for code that changes its members behind cJSON's back. */
+CJSON_PUBLIC(void) cJSON_DropIndex(cJSON * const item);
+
 /* Memory Management: the caller is always responsible to free the results from all variants of cJSON_Parse (with cJSON_Delete) and cJSON_Print (with stdlib free, cJSON_Hooks.free_fn, or cJSON_free as appropriate). The exception is cJSON_PrintPreallocated, where the caller has full responsibility of the buffer. */
 /* Supply a block of JSON, and this returns a cJSON object you can interrogate. */
 CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value);
@@ -152,6 +211,8 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error so will match cJSON_GetErrorPtr(). */
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+/* Same as ParseWithLengthOpts, same tree and same errors, but indexes the tokens of the whole buffer first. Faster for large documents, slower for small ones. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseLargeWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
 
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
@@ -162,6 +223,12 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
 /* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
+/* Render a cJSON entity into *buffer, a buffer of *size bytes allocated with the hooks (NULL and 0 for none yet) that is grown
+ * as needed and handed back for the next print. hint is the expected length, the buffer is grown to fit it up front.
+ * Returns the length of the NUL terminated text, 0 on failure. The caller frees *buffer once it is done printing. */
+CJSON_PUBLIC(size_t) cJSON_PrintToBuffer(const cJSON *item, char **buffer, size_t *size, size_t hint, const cJSON_bool format);
+/* Same as cJSON_PrintToBuffer, rendering the count items as the elements of one array. They don't have to be in the same tree. */
+CJSON_PUBLIC(size_t) cJSON_PrintItemsToBuffer(const cJSON * const *items, size_t count, char **buffer, size_t *size, size_t hint, const cJSON_bool format);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
 
@@ -198,6 +265,7 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateTrue(void);
 CJSON_PUBLIC(cJSON *) cJSON_CreateFalse(void);
 CJSON_PUBLIC(cJSON *) cJSON_CreateBool(cJSON_bool boolean);
 CJSON_PUBLIC(cJSON *) cJSON_CreateNumber(double num);
+CJSON_PUBLIC(cJSON *) cJSON_CreateInt64(cJSON_int64 num);
 CJSON_PUBLIC(cJSON *) cJSON_CreateString(const char *string);
 /* raw json */
 CJSON_PUBLIC(cJSON *) cJSON_CreateRaw(const char *raw);
@@ -234,6 +302,8 @@ CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToObject(cJSON *object, const cha
 CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const item);
 CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which);
 CJSON_PUBLIC(void) cJSON_DeleteItemFromArray(cJSON *array, int which);
+/* Detaches up to count items starting at which, returned as a list of their own: free them all with one cJSON_Delete. */
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemsFromArray(cJSON *array, int which, int count);
 CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObject(cJSON *object, const char *string);
 CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObjectCaseSensitive(cJSON *object, const char *string);
 CJSON_PUBLIC(void) cJSON_DeleteItemFromObject(cJSON *object, const char *string);
@@ -241,6 +311,8 @@ CJSON_PUBLIC(void) cJSON_DeleteItemFromObjectCaseSensitive(cJSON *object, const
 
 /* Update array items. */
 CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newitem); /* Shifts pre-existing items to the right. */
+/* Inserts items and the items following it in one splice, appends if which is past the end. */
+CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemsInArray(cJSON *array, int which, cJSON *items);
 CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement);
 CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem);
 CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInObject(cJSON *object,const char *string,cJSON *newitem);
@@ -272,11 +344,14 @@ CJSON_PUBLIC(cJSON*) cJSON_AddRawToObject(cJSON * const object, const char * con
 CJSON_PUBLIC(cJSON*) cJSON_AddObjectToObject(cJSON * const object, const char * const name);
 CJSON_PUBLIC(cJSON*) cJSON_AddArrayToObject(cJSON * const object, const char * const name);
 
-/* When assigning an integer value, it needs to be propagated to valuedouble too. */
-#define cJSON_SetIntValue(object, number) ((object) ? (object)->valueint = (object)->valuedouble = (number) : (number))
+/* When assigning an integer value, it needs to be propagated to valuedouble too.
+ * The number setters do nothing unless object is a number. */
+#define cJSON_SetIntValue(object, number) (cJSON_IsNumber(object) ? ((object)->type &= ~cJSON_NumberIsInt, (object)->valueint = (object)->valuedouble = (number)) : (number))
 /* helper for the cJSON_SetNumberValue macro */
 CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number);
 #define cJSON_SetNumberValue(object, number) ((object != NULL) ? cJSON_SetNumberHelper(object, (double)number) : (number))
+/* Makes object an exact integer, valueint saturates like with cJSON_SetNumberValue */
+CJSON_PUBLIC(cJSON_int64) cJSON_SetInt64Value(cJSON *object, cJSON_int64 number);
 /* Change the valuestring of a cJSON_String object, only takes effect when type of object is cJSON_String */
 CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring);
 
@@ -287,8 +362,15 @@ CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
     cJSON_Invalid\
 )
 
+/* The first child of an array or object, NULL for any other item */
+#define cJSON_Child(item) ((((item) != NULL) && ((item)->type & (cJSON_Array | cJSON_Object))) ? (item)->child : NULL)
+/* The valuestring of a string or raw item, NULL for any other item */
+#define cJSON_ValueString(item) ((((item) != NULL) && ((item)->type & (cJSON_String | cJSON_Raw))) ? (item)->valuestring : NULL)
+/* The value of a number item as a double, whichever way it is held */
+#define cJSON_ValueDouble(item) (((item)->type & cJSON_NumberIsInt) ? (double)(item)->valueint64 : (item)->valuedouble)
+
 /* Macro for iterating over an array or object */
-#define cJSON_ArrayForEach(element, array) for(element = (array != NULL) ? (array)->child : NULL; element != NULL; element = element->next)
+#define cJSON_ArrayForEach(element, array) for(element = cJSON_Child(array); element != NULL; element = element->next)
 
 /* malloc/free objects using the malloc/free functions that have been set with cJSON_InitHooks */
 CJSON_PUBLIC(void *) cJSON_malloc(size_t size);
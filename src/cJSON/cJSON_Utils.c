@@ -115,6 +115,16 @@ static cJSON_bool compare_double(double a, double b)
     return (fabs(a - b) <= maxVal * DBL_EPSILON);
 }
 
+/* numbers are equal exactly when both are integers, close enough otherwise */
+static cJSON_bool compare_number(const cJSON * const a, const cJSON * const b)
+{
+    if (a->type & b->type & cJSON_NumberIsInt)
+    {
+        return a->valueint64 == b->valueint64;
+    }
+    return (a->valueint == b->valueint) && compare_double(cJSON_ValueDouble(a), cJSON_ValueDouble(b));
+}
+
 
 /* Compare the next path element of two JSON pointers, two NULL pointers are considered unequal: */
 static cJSON_bool compare_pointers(const unsigned char *name, const unsigned char *pointer, const cJSON_bool case_sensitive)
@@ -212,7 +222,7 @@ CJSON_PUBLIC(char *) cJSONUtils_FindPointerFromObjectTo(const cJSON * const obje
     }
 
     /* recursively search all children of the object or array */
-    for (current_child = object->child; current_child != NULL; (void)(current_child = current_child->next), child_index++)
+    for (current_child = cJSON_Child(object); current_child != NULL; (void)(current_child = current_child->next), child_index++)
     {
         unsigned char *target_pointer = (unsigned char*)cJSONUtils_FindPointerFromObjectTo(current_child, target);
         /* found the target? */
@@ -261,14 +271,12 @@ CJSON_PUBLIC(char *) cJSONUtils_FindPointerFromObjectTo(const cJSON * const obje
 /* non broken version of cJSON_GetArrayItem */
 static cJSON *get_array_item(const cJSON *array, size_t item)
 {
-    cJSON *child = array ? array->child : NULL;
-    while ((child != NULL) && (item > 0))
+    if (item > INT_MAX)
     {
-        item--;
-        child = child->next;
+        return NULL;
     }
 
-    return child;
+    return cJSON_GetArrayItem(array, (int)item);
 }
 
 static cJSON_bool decode_array_index_from_pointer(const unsigned char * const pointer, size_t * const index)
@@ -298,43 +306,101 @@ static cJSON_bool decode_array_index_from_pointer(const unsigned char * const po
     return 1;
 }
 
-static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer, const cJSON_bool case_sensitive)
+/* look the member named by the next token of pointer up in the index of object */
+static cJSON *get_indexed_item(const cJSON * const object, const char *pointer)
 {
-    cJSON *current_element = object;
+    char buffer[64];
+    char *name = buffer;
+    size_t length = 0;
+    size_t decoded = 0;
+    cJSON *item = NULL;
 
-    if (pointer == NULL)
+    while ((pointer[length] != '\0') && (pointer[length] != '/'))
+    {
+        length++;
+    }
+    if ((length >= sizeof(buffer)) && ((name = (char*)cJSON_malloc(length + 1)) == NULL))
     {
         return NULL;
     }
 
-    /* follow path of the pointer */
-    while ((pointer[0] == '/') && (current_element != NULL))
+    for (; length > 0; (void)pointer++, length--)
     {
-        pointer++;
-        if (cJSON_IsArray(current_element))
+        if (pointer[0] == '~')
         {
-            size_t index = 0;
-            if (!decode_array_index_from_pointer((const unsigned char*)pointer, &index))
+            /* same escapes as compare_pointers, anything else matches no member */
+            if ((length < 2) || ((pointer[1] != '0') && (pointer[1] != '1')))
             {
-                return NULL;
+                goto cleanup;
             }
-
-            current_element = get_array_item(current_element, index);
+            name[decoded++] = (pointer[1] == '0') ? '~' : '/';
+            pointer++;
+            length--;
         }
-        else if (cJSON_IsObject(current_element))
+        else
         {
-            current_element = current_element->child;
-            /* GetObjectItem. */
-            while ((current_element != NULL) && !compare_pointers((unsigned char*)current_element->string, (const unsigned char*)pointer, case_sensitive))
-            {
-                current_element = current_element->next;
-            }
+            name[decoded++] = pointer[0];
         }
-        else
+    }
+    name[decoded] = '\0';
+    item = cJSON_GetObjectItemCaseSensitive(object, name);
+
+cleanup:
+    if (name != buffer)
+    {
+        cJSON_free(name);
+    }
+    return item;
+}
+
+/* the child of element named by the next token of pointer, NULL if there is none */
+static cJSON *get_child_from_pointer(cJSON * const element, const char * const pointer, const cJSON_bool case_sensitive)
+{
+    cJSON *child = NULL;
+
+    if (cJSON_IsArray(element))
+    {
+        size_t index = 0;
+        if (!decode_array_index_from_pointer((const unsigned char*)pointer, &index))
         {
             return NULL;
         }
 
+        return get_array_item(element, index);
+    }
+    if (cJSON_IsObject(element) && case_sensitive && (element->type & cJSON_IsIndexed))
+    {
+        return get_indexed_item(element, pointer);
+    }
+    if (cJSON_IsObject(element))
+    {
+        child = element->child;
+        /* GetObjectItem. */
+        while ((child != NULL) && !compare_pointers((unsigned char*)child->string, (const unsigned char*)pointer, case_sensitive))
+        {
+            child = child->next;
+        }
+    }
+
+    return child;
+}
+
+/* follow the tokens of pointer that start before end, all of them if end is NULL */
+static cJSON *follow_pointer(cJSON * const object, const char * pointer, const char * const end, const cJSON_bool case_sensitive)
+{
+    cJSON *current_element = object;
+
+    if (pointer == NULL)
+    {
+        return NULL;
+    }
+
+    /* follow path of the pointer */
+    while ((pointer[0] == '/') && ((end == NULL) || (pointer < end)) && (current_element != NULL))
+    {
+        pointer++;
+        current_element = get_child_from_pointer(current_element, pointer, case_sensitive);
+
         /* skip to the next path token or end of string */
         while ((pointer[0] != '\0') && (pointer[0] != '/'))
         {
@@ -345,6 +411,11 @@ static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer,
     return current_element;
 }
 
+static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer, const cJSON_bool case_sensitive)
+{
+    return follow_pointer(object, pointer, NULL, case_sensitive);
+}
+
 CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointer(cJSON * const object, const char *pointer)
 {
     return get_item_from_pointer(object, pointer, false);
@@ -374,7 +445,7 @@ static void decode_pointer_inplace(unsigned char *string)
             }
             else if (string[1] == '1')
             {
-                decoded_string[1] = '/';
+                decoded_string[0] = '/';
             }
             else
             {
@@ -384,6 +455,10 @@ static void decode_pointer_inplace(unsigned char *string)
 
             string++;
         }
+        else
+        {
+            decoded_string[0] = string[0];
+        }
     }
 
     decoded_string[0] = '\0';
@@ -392,38 +467,14 @@ static void decode_pointer_inplace(unsigned char *string)
 /* non-broken cJSON_DetachItemFromArray */
 static cJSON *detach_item_from_array(cJSON *array, size_t which)
 {
-    cJSON *c = array->child;
-    while (c && (which > 0))
-    {
-        c = c->next;
-        which--;
-    }
+    cJSON *c = get_array_item(array, which);
     if (!c)
     {
         /* item doesn't exist */
         return NULL;
     }
-    if (c != array->child)
-    {
-        /* not the first element */
-        c->prev->next = c->next;
-    }
-    if (c->next)
-    {
-        c->next->prev = c->prev;
-    }
-    if (c == array->child)
-    {
-        array->child = c->next;
-    }
-    else if (c->next == NULL)
-    {
-        array->child->prev = c->prev;
-    }
-    /* make sure the detached item doesn't point anywhere anymore */
-    c->prev = c->next = NULL;
 
-    return c;
+    return cJSON_DetachItemViaPointer(array, c);
 }
 
 /* detach an item at the given path */
@@ -461,6 +512,10 @@ static cJSON *detach_path(cJSON *object, const unsigned char *path, const cJSON_
         }
         detached_item = detach_item_from_array(parent, index);
     }
+    else if (cJSON_IsObject(parent) && case_sensitive)
+    {
+        detached_item = cJSON_DetachItemFromObjectCaseSensitive(parent, (char*)child_pointer);
+    }
     else if (cJSON_IsObject(parent))
     {
         detached_item = cJSON_DetachItemFromObject(parent, (char*)child_pointer);
@@ -594,7 +649,7 @@ static cJSON *sort_list(cJSON *list, const cJSON_bool case_sensitive)
 
 static void sort_object(cJSON * const object, const cJSON_bool case_sensitive)
 {
-    if (object == NULL)
+    if (cJSON_Child(object) == NULL)
     {
         return;
     }
@@ -612,7 +667,7 @@ static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensiti
     {
         case cJSON_Number:
             /* numeric mismatch. */
-            if ((a->valueint != b->valueint) || (!compare_double(a->valuedouble, b->valuedouble)))
+            if (!compare_number(a, b))
             {
                 return false;
             }
@@ -692,39 +747,13 @@ static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensiti
 /* non broken version of cJSON_InsertItemInArray */
 static cJSON_bool insert_item_in_array(cJSON *array, size_t which, cJSON *newitem)
 {
-    cJSON *child = array->child;
-    while (child && (which > 0))
-    {
-        child = child->next;
-        which--;
-    }
-    if (which > 0)
+    if (which > (size_t)cJSON_GetArraySize(array))
     {
         /* item is after the end of the array */
         return 0;
     }
-    if (child == NULL)
-    {
-        cJSON_AddItemToArray(array, newitem);
-        return 1;
-    }
-
-    /* insert into the linked list */
-    newitem->next = child;
-    newitem->prev = child->prev;
-    child->prev = newitem;
-
-    /* was it at the beginning */
-    if (child == array->child)
-    {
-        array->child = newitem;
-    }
-    else
-    {
-        newitem->prev->next = newitem;
-    }
 
-    return 1;
+    return cJSON_InsertItemInArray(array, (int)which, newitem);
 }
 
 static cJSON *get_object_item(const cJSON * const object, const char* name, const cJSON_bool case_sensitive)
@@ -788,15 +817,16 @@ static void overwrite_item(cJSON * const root, const cJSON replacement)
         return;
     }
 
-    if (root->string != NULL)
+    cJSON_DropIndex(root);
+    if ((root->string != NULL) && !(root->type & cJSON_StringIsConst))
     {
         cJSON_free(root->string);
     }
-    if (root->valuestring != NULL)
+    if (cJSON_ValueString(root) != NULL)
     {
         cJSON_free(root->valuestring);
     }
-    if (root->child != NULL)
+    if (cJSON_Child(root) != NULL)
     {
         cJSON_Delete(root->child);
     }
@@ -804,14 +834,121 @@ static void overwrite_item(cJSON * const root, const cJSON replacement)
     memcpy(root, &replacement, sizeof(cJSON));
 }
 
+/* replace the root with value, whose node is freed */
+static void replace_root(cJSON * const object, cJSON * const value)
+{
+    /* the index of value is keyed by its node, which is freed below */
+    cJSON_DropIndex(value);
+    overwrite_item(object, *value);
+    cJSON_free(value);
+
+    /* the root has no name */
+    if ((object->string != NULL) && !(object->type & cJSON_StringIsConst))
+    {
+        cJSON_free(object->string);
+    }
+    object->string = NULL;
+    object->type &= ~cJSON_StringIsConst;
+}
+
+/* add value at path, value belongs to object afterwards or is deleted */
+static int add_value(cJSON * const object, const char * const path, cJSON *value, const cJSON_bool case_sensitive)
+{
+    cJSON *parent = NULL;
+    unsigned char *parent_pointer = NULL;
+    unsigned char *child_pointer = NULL;
+    int status = 0;
+
+    /* split pointer in parent and child */
+    parent_pointer = cJSONUtils_strdup((const unsigned char*)path);
+    if (parent_pointer) {
+        child_pointer = (unsigned char*)strrchr((char*)parent_pointer, '/');
+    }
+    if (child_pointer != NULL)
+    {
+        child_pointer[0] = '\0';
+        child_pointer++;
+    }
+    parent = get_item_from_pointer(object, (char*)parent_pointer, case_sensitive);
+    decode_pointer_inplace(child_pointer);
+
+    /* add, remove, replace, move, copy, test. */
+    if ((parent == NULL) || (child_pointer == NULL))
+    {
+        /* Couldn't find object to add to. */
+        status = 9;
+        goto cleanup;
+    }
+    else if (cJSON_IsArray(parent))
+    {
+        if (strcmp((char*)child_pointer, "-") == 0)
+        {
+            if (!cJSON_AddItemToArray(parent, value))
+            {
+                status = 10;
+                goto cleanup;
+            }
+            value = NULL;
+        }
+        else
+        {
+            size_t index = 0;
+            if (!decode_array_index_from_pointer(child_pointer, &index))
+            {
+                status = 11;
+                goto cleanup;
+            }
+
+            if (!insert_item_in_array(parent, index, value))
+            {
+                status = 10;
+                goto cleanup;
+            }
+            value = NULL;
+        }
+    }
+    else if (cJSON_IsObject(parent))
+    {
+        if (case_sensitive)
+        {
+            cJSON_DeleteItemFromObjectCaseSensitive(parent, (char*)child_pointer);
+        }
+        else
+        {
+            cJSON_DeleteItemFromObject(parent, (char*)child_pointer);
+        }
+        if (!cJSON_AddItemToObject(parent, (char*)child_pointer, value))
+        {
+            status = 8;
+            goto cleanup;
+        }
+        value = NULL;
+    }
+    else /* parent is not an object */
+    {
+        /* Couldn't find object to add to. */
+        status = 9;
+        goto cleanup;
+    }
+
+cleanup:
+    if (value != NULL)
+    {
+        cJSON_Delete(value);
+    }
+    if (parent_pointer != NULL)
+    {
+        cJSON_free(parent_pointer);
+    }
+
+    return status;
+}
+
 static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_sensitive)
 {
     cJSON *path = NULL;
     cJSON *value = NULL;
-    cJSON *parent = NULL;
     enum patch_operation opcode = INVALID;
-    unsigned char *parent_pointer = NULL;
-    unsigned char *child_pointer = NULL;
     int status = 0;
 
     path = get_object_item(patch, "path", case_sensitive);
@@ -840,7 +977,7 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
     {
         if (opcode == REMOVE)
         {
-            static const cJSON invalid = { NULL, NULL, NULL, cJSON_Invalid, NULL, 0, 0, NULL};
+            static const cJSON invalid = { NULL, NULL, { NULL }, NULL, cJSON_Invalid, 0 };
 
             overwrite_item(object, invalid);
 
@@ -866,19 +1003,9 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
                 goto cleanup;
             }
 
-            overwrite_item(object, *value);
-
-            /* delete the duplicated value */
-            cJSON_free(value);
+            replace_root(object, value);
             value = NULL;
 
-            /* the string "value" isn't needed */
-            if (object->string != NULL)
-            {
-                cJSON_free(object->string);
-                object->string = NULL;
-            }
-
             status = 0;
             goto cleanup;
         }
@@ -957,85 +1084,48 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
     }
 
     /* Now, just add "value" to "path". */
+    status = add_value(object, path->valuestring, value, case_sensitive);
+    value = NULL;
 
-    /* split pointer in parent and child */
-    parent_pointer = cJSONUtils_strdup((unsigned char*)path->valuestring);
-    if (parent_pointer) {
-        child_pointer = (unsigned char*)strrchr((char*)parent_pointer, '/');
-    }
-    if (child_pointer != NULL)
+cleanup:
+    if (value != NULL)
     {
-        child_pointer[0] = '\0';
-        child_pointer++;
+        cJSON_Delete(value);
     }
-    parent = get_item_from_pointer(object, (char*)parent_pointer, case_sensitive);
-    decode_pointer_inplace(child_pointer);
 
-    /* add, remove, replace, move, copy, test. */
-    if ((parent == NULL) || (child_pointer == NULL))
+    return status;
+}
+
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * const patches)
+{
+    const cJSON *current_patch = NULL;
+    int status = 0;
+
+    if (!cJSON_IsArray(patches))
     {
-        /* Couldn't find object to add to. */
-        status = 9;
-        goto cleanup;
+        /* malformed patches. */
+        return 1;
     }
-    else if (cJSON_IsArray(parent))
-    {
-        if (strcmp((char*)child_pointer, "-") == 0)
-        {
-            cJSON_AddItemToArray(parent, value);
-            value = NULL;
-        }
-        else
-        {
-            size_t index = 0;
-            if (!decode_array_index_from_pointer(child_pointer, &index))
-            {
-                status = 11;
-                goto cleanup;
-            }
 
-            if (!insert_item_in_array(parent, index, value))
-            {
-                status = 10;
-                goto cleanup;
-            }
-            value = NULL;
-        }
+    if (patches != NULL)
+    {
+        current_patch = patches->child;
     }
-    else if (cJSON_IsObject(parent))
+
+    while (current_patch != NULL)
     {
-        if (case_sensitive)
-        {
-            cJSON_DeleteItemFromObjectCaseSensitive(parent, (char*)child_pointer);
-        }
-        else
+        status = apply_patch(object, current_patch, false);
+        if (status != 0)
         {
-            cJSON_DeleteItemFromObject(parent, (char*)child_pointer);
+            return status;
         }
-        cJSON_AddItemToObject(parent, (char*)child_pointer, value);
-        value = NULL;
-    }
-    else /* parent is not an object */
-    {
-        /* Couldn't find object to add to. */
-        status = 9;
-        goto cleanup;
-    }
-
-cleanup:
-    if (value != NULL)
-    {
-        cJSON_Delete(value);
-    }
-    if (parent_pointer != NULL)
-    {
-        cJSON_free(parent_pointer);
+        current_patch = current_patch->next;
     }
 
-    return status;
+    return 0;
 }
 
-CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * const patches)
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, const cJSON * const patches)
 {
     const cJSON *current_patch = NULL;
     int status = 0;
@@ -1053,7 +1143,7 @@ CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * co
 
     while (current_patch != NULL)
     {
-        status = apply_patch(object, current_patch, false);
+        status = apply_patch(object, current_patch, true);
         if (status != 0)
         {
             return status;
@@ -1064,33 +1154,313 @@ CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * co
     return 0;
 }
 
-CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, const cJSON * const patches)
+CJSON_PUBLIC(int) cJSONUtils_LocateCaseSensitive(cJSON * const object, const char * const pointer, cJSONUtils_Location * const location)
 {
-    const cJSON *current_patch = NULL;
+    const char *last = NULL;
+
+    if ((object == NULL) || (pointer == NULL) || (location == NULL))
+    {
+        return 9;
+    }
+
+    memset(location, '\0', sizeof(cJSONUtils_Location));
+    if (pointer[0] == '\0')
+    {
+        /* the root */
+        location->item = object;
+        return 0;
+    }
+
+    last = strrchr(pointer, '/');
+    if (last == NULL)
+    {
+        return 9;
+    }
+    location->parent = follow_pointer(object, pointer, last, true);
+    location->token = last + 1;
+
+    if (cJSON_IsArray(location->parent))
+    {
+        if (strcmp(location->token, "-") == 0)
+        {
+            location->index = (size_t)cJSON_GetArraySize(location->parent);
+            return 0;
+        }
+        if (!decode_array_index_from_pointer((const unsigned char*)location->token, &location->index))
+        {
+            return 11;
+        }
+        location->item = get_array_item(location->parent, location->index);
+        return 0;
+    }
+    if (cJSON_IsObject(location->parent))
+    {
+        location->item = get_child_from_pointer(location->parent, location->token, true);
+        return 0;
+    }
+
+    /* Couldn't find object to add to. */
+    location->parent = NULL;
+    return 9;
+}
+
+CJSON_PUBLIC(int) cJSONUtils_SetAtLocation(cJSON * const object, const cJSONUtils_Location * const location, cJSON * const value)
+{
+    unsigned char *name = NULL;
     int status = 0;
 
-    if (!cJSON_IsArray(patches))
+    if ((object == NULL) || (location == NULL) || (value == NULL))
     {
-        /* malformed patches. */
-        return 1;
+        if (value != NULL)
+        {
+            cJSON_Delete(value);
+        }
+        return 7;
     }
 
-    if (patches != NULL)
+    if (location->parent == NULL)
     {
-        current_patch = patches->child;
+        if (location->item != object)
+        {
+            cJSON_Delete(value);
+            return 9;
+        }
+        replace_root(object, value);
+        return 0;
     }
 
-    while (current_patch != NULL)
+    if (cJSON_IsArray(location->parent) && (location->item != NULL))
     {
-        status = apply_patch(object, current_patch, true);
-        if (status != 0)
+        cJSON_ReplaceItemViaPointer(location->parent, location->item, value);
+        return 0;
+    }
+    if (location->item != NULL)
+    {
+        /* like "remove" then "add": value takes the name over and goes last */
+        cJSON *old = cJSON_DetachItemViaPointer(location->parent, location->item);
+        if ((value->string != NULL) && !(value->type & cJSON_StringIsConst))
         {
-            return status;
+            cJSON_free(value->string);
         }
-        current_patch = current_patch->next;
+        value->string = old->string;
+        value->type = (value->type & ~cJSON_StringIsConst) | (old->type & cJSON_StringIsConst);
+        old->string = NULL;
+        cJSON_Delete(old);
+        if (!cJSON_AddItemToArray(location->parent, value))
+        {
+            cJSON_Delete(value);
+            return 8;
+        }
+        return 0;
     }
 
-    return 0;
+    if (cJSON_IsArray(location->parent))
+    {
+        if (!insert_item_in_array(location->parent, location->index, value))
+        {
+            cJSON_Delete(value);
+            return 10;
+        }
+        return 0;
+    }
+
+    if (location->decoded)
+    {
+        if (!cJSON_AddItemToObject(location->parent, location->token, value))
+        {
+            cJSON_Delete(value);
+            return 8;
+        }
+        return 0;
+    }
+
+    /* the name of the new member, decoded as by apply_patch */
+    name = cJSONUtils_strdup((const unsigned char*)location->token);
+    if (name == NULL)
+    {
+        cJSON_Delete(value);
+        return 8;
+    }
+    decode_pointer_inplace(name);
+    if (!cJSON_AddItemToObject(location->parent, (char*)name, value))
+    {
+        cJSON_Delete(value);
+        status = 8;
+    }
+    cJSON_free(name);
+
+    return status;
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_DetachAtLocation(const cJSONUtils_Location * const location)
+{
+    if ((location == NULL) || (location->parent == NULL) || (location->item == NULL))
+    {
+        return NULL;
+    }
+
+    return cJSON_DetachItemViaPointer(location->parent, location->item);
+}
+
+CJSON_PUBLIC(cJSONUtils_Pointer *) cJSONUtils_CompilePointer(const char * const pointer)
+{
+    cJSONUtils_Pointer *compiled = NULL;
+    unsigned char *names = NULL;
+    unsigned char *end = NULL;
+    size_t length = 0;
+    size_t count = 0;
+    size_t i = 0;
+
+    if (pointer == NULL)
+    {
+        return NULL;
+    }
+
+    length = strlen(pointer);
+    if (pointer[0] == '/')
+    {
+        for (i = 0; i < length; i++)
+        {
+            count += (pointer[i] == '/') ? 1 : 0;
+        }
+    }
+
+    /* the tokens and their names go right after the pointer */
+    compiled = (cJSONUtils_Pointer*)cJSON_malloc(sizeof(cJSONUtils_Pointer) + (count * sizeof(cJSONUtils_Token)) + length + 1);
+    if (compiled == NULL)
+    {
+        return NULL;
+    }
+    compiled->tokens = (cJSONUtils_Token*)(compiled + 1);
+    compiled->count = count;
+    compiled->relative = (pointer[0] != '\0') && (pointer[0] != '/');
+    names = (unsigned char*)(compiled->tokens + count);
+    memcpy(names, pointer, length + 1);
+
+    for (i = 0; i < count; i++)
+    {
+        cJSONUtils_Token *token = &compiled->tokens[i];
+
+        /* names is at the '/' starting the token */
+        names++;
+        for (end = names; (*end != '\0') && (*end != '/'); end++)
+        {
+        }
+        *end = '\0';
+
+        token->is_index = decode_array_index_from_pointer(names, &token->index);
+        token->valid_name = true;
+        for (length = 0; names[length] != '\0'; length++)
+        {
+            if ((names[length] == '~') && (names[length + 1] != '0') && (names[length + 1] != '1'))
+            {
+                token->valid_name = false;
+            }
+        }
+        decode_pointer_inplace(names);
+        token->name = (const char*)names;
+        names = end;
+    }
+
+    return compiled;
+}
+
+/* the child of element named by token, NULL if there is none */
+static cJSON *get_child_from_token(cJSON * const element, const cJSONUtils_Token * const token)
+{
+    if (cJSON_IsArray(element))
+    {
+        return token->is_index ? get_array_item(element, token->index) : NULL;
+    }
+    if (cJSON_IsObject(element) && token->valid_name)
+    {
+        return cJSON_GetObjectItemCaseSensitive(element, token->name);
+    }
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_GetCompiledPointer(cJSON * const object, const cJSONUtils_Pointer * const pointer)
+{
+    cJSON *current_element = object;
+    size_t i = 0;
+
+    if (pointer == NULL)
+    {
+        return NULL;
+    }
+
+    for (i = 0; (i < pointer->count) && (current_element != NULL); i++)
+    {
+        current_element = get_child_from_token(current_element, &pointer->tokens[i]);
+    }
+
+    return current_element;
+}
+
+CJSON_PUBLIC(int) cJSONUtils_LocateCompiledPointer(cJSON * const object, const cJSONUtils_Pointer * const pointer, cJSONUtils_Location * const location)
+{
+    const cJSONUtils_Token *last = NULL;
+    cJSON *parent = object;
+    size_t i = 0;
+
+    if ((object == NULL) || (pointer == NULL) || (location == NULL) || pointer->relative)
+    {
+        return 9;
+    }
+
+    memset(location, '\0', sizeof(cJSONUtils_Location));
+    if (pointer->count == 0)
+    {
+        /* the root */
+        location->item = object;
+        return 0;
+    }
+
+    for (i = 0; (i + 1 < pointer->count) && (parent != NULL); i++)
+    {
+        parent = get_child_from_token(parent, &pointer->tokens[i]);
+    }
+    last = &pointer->tokens[pointer->count - 1];
+    location->token = last->name;
+    location->decoded = true;
+
+    if (cJSON_IsArray(parent))
+    {
+        location->parent = parent;
+        if (strcmp(last->name, "-") == 0)
+        {
+            location->index = (size_t)cJSON_GetArraySize(parent);
+            return 0;
+        }
+        if (!last->is_index)
+        {
+            return 11;
+        }
+        location->index = last->index;
+        location->item = get_array_item(parent, last->index);
+        return 0;
+    }
+    if (cJSON_IsObject(parent))
+    {
+        location->parent = parent;
+        location->item = get_child_from_token(parent, last);
+        return 0;
+    }
+
+    /* Couldn't find object to add to. */
+    return 9;
+}
+
+/* adds item to object, or deletes it when it can't be added */
+static cJSON_bool add_member_or_delete(cJSON * const object, const char * const name, cJSON * const item)
+{
+    if (cJSON_AddItemToObject(object, name, item))
+    {
+        return true;
+    }
+    cJSON_Delete(item);
+    return false;
 }
 
 static void compose_patch(cJSON * const patches, const unsigned char * const operation, const unsigned char * const path, const unsigned char *suffix, const cJSON * const value)
@@ -1107,30 +1477,53 @@ static void compose_patch(cJSON * const patches, const unsigned char * const ope
     {
         return;
     }
-    cJSON_AddItemToObject(patch, "op", cJSON_CreateString((const char*)operation));
+    if (!add_member_or_delete(patch, "op", cJSON_CreateString((const char*)operation)))
+    {
+        cJSON_Delete(patch);
+        return;
+    }
 
     if (suffix == NULL)
     {
-        cJSON_AddItemToObject(patch, "path", cJSON_CreateString((const char*)path));
+        if (!add_member_or_delete(patch, "path", cJSON_CreateString((const char*)path)))
+        {
+            cJSON_Delete(patch);
+            return;
+        }
     }
     else
     {
         size_t suffix_length = pointer_encoded_length(suffix);
         size_t path_length = strlen((const char*)path);
         unsigned char *full_path = (unsigned char*)cJSON_malloc(path_length + suffix_length + sizeof("/"));
+        cJSON_bool added = false;
 
+        if (full_path == NULL)
+        {
+            cJSON_Delete(patch);
+            return;
+        }
         sprintf((char*)full_path, "%s/", (const char*)path);
         encode_string_as_pointer(full_path + path_length + 1, suffix);
 
-        cJSON_AddItemToObject(patch, "path", cJSON_CreateString((const char*)full_path));
+        added = add_member_or_delete(patch, "path", cJSON_CreateString((const char*)full_path));
         cJSON_free(full_path);
+        if (!added)
+        {
+            cJSON_Delete(patch);
+            return;
+        }
     }
 
-    if (value != NULL)
+    if ((value != NULL) && !add_member_or_delete(patch, "value", cJSON_Duplicate(value, 1)))
     {
-        cJSON_AddItemToObject(patch, "value", cJSON_Duplicate(value, 1));
+        cJSON_Delete(patch);
+        return;
+    }
+    if (!cJSON_AddItemToArray(patches, patch))
+    {
+        cJSON_Delete(patch);
     }
-    cJSON_AddItemToArray(patches, patch);
 }
 
 CJSON_PUBLIC(void) cJSONUtils_AddPatchToArray(cJSON * const array, const char * const operation, const char * const path, const cJSON * const value)
@@ -1154,7 +1547,7 @@ static void create_patches(cJSON * const patches, const unsigned char * const pa
     switch (from->type & 0xFF)
     {
         case cJSON_Number:
-            if ((from->valueint != to->valueint) || !compare_double(from->valuedouble, to->valuedouble))
+            if (!compare_number(from, to))
             {
                 compose_patch(patches, (const unsigned char*)"replace", path, NULL, to);
             }
@@ -1371,7 +1764,11 @@ static cJSON *merge_patch(cJSON *target, const cJSON * const patch, const cJSON_
                 return NULL;
             }
 
-            cJSON_AddItemToObject(target, patch_child->string, replacement);
+            if (!add_member_or_delete(target, patch_child->string, replacement))
+            {
+                cJSON_Delete(target);
+                return NULL;
+            }
         }
         patch_child = patch_child->next;
     }
@@ -1435,14 +1832,22 @@ static cJSON *generate_merge_patch(cJSON * const from, cJSON * const to, const c
         if (diff < 0)
         {
             /* from has a value that to doesn't have -> remove */
-            cJSON_AddItemToObject(patch, from_child->string, cJSON_CreateNull());
+            if (!add_member_or_delete(patch, from_child->string, cJSON_CreateNull()))
+            {
+                cJSON_Delete(patch);
+                return NULL;
+            }
 
             from_child = from_child->next;
         }
         else if (diff > 0)
         {
             /* to has a value that from doesn't have -> add to patch */
-            cJSON_AddItemToObject(patch, to_child->string, cJSON_Duplicate(to_child, 1));
+            if (!add_member_or_delete(patch, to_child->string, cJSON_Duplicate(to_child, 1)))
+            {
+                cJSON_Delete(patch);
+                return NULL;
+            }
 
             to_child = to_child->next;
         }
@@ -1452,7 +1857,11 @@ static cJSON *generate_merge_patch(cJSON * const from, cJSON * const to, const c
             if (!compare_json(from_child, to_child, case_sensitive))
             {
                 /* not identical --> generate a patch */
-                cJSON_AddItemToObject(patch, to_child->string, cJSONUtils_GenerateMergePatch(from_child, to_child));
+                if (!add_member_or_delete(patch, to_child->string, cJSONUtils_GenerateMergePatch(from_child, to_child)))
+                {
+                    cJSON_Delete(patch);
+                    return NULL;
+                }
             }
 
             /* next key in the object */
@@ -1573,118 +1982,51 @@ static void cJSONUtils_Delete_Filter(Filter *filter) {
         {
             cJSON_Delete(filter->value.list_entry);
         }
-        else if (filter->type == RESULT)
-        {
-            cJSON_Delete(filter->value.results);
-        }
         cJSON_free(filter);
         filter = next;
     }
 }
 
-static void cJSONUtils_Free_Filter(Filter *filter)
+static Selector *cJSONUtils_New_Selector()
 {
-    if (filter != NULL)
+    Selector *selectors = (Selector *) cJSON_malloc(sizeof(Selector));
+    if (selectors)
     {
-        if (filter->type == EXISTS)
-        {
-            cJSON_Delete(filter->value.exists);
-        }
-        else if (filter->type == COMP)
-        {
-            cJSON_Delete(filter->value.comp.right);
-            cJSON_Delete(filter->value.comp.left);
-        }
-        else if (filter->type == LIST_ENTRY)
+        memset(selectors, '\0', sizeof(Selector));
+    }
+
+    return selectors;
+}
+
+CJSON_PUBLIC(void) cJSONUtils_Delete_Selector(Selector *selector)
+{
+    Selector *next = NULL;
+    while (selector != NULL) {
+        next = selector->next;
+        if (selector->type == DOT)
         {
-            cJSON_Delete(filter->value.list_entry);
+            cJSON_free(selector->value.path);
         }
-        else if (filter->type == RESULT)
+        else if (selector->type == LIST || selector->type == FILTER)
         {
-            cJSON_Delete(filter->value.results);
+            cJSONUtils_Delete_Filter(selector->value.filter);
         }
-        cJSON_free(filter);
+        cJSON_free(selector);
+        selector = next;
     }
 }
 
-static Filter *cJSONUtils_Duplicate_Filter(Filter *head)
+static cJSON *parse_comp_from_str(const char *str)
 {
-    if (head == NULL)
-    {
-        return NULL;
-    }
-
-    Filter *new_filter = cJSONUtils_New_Filter();
-    new_filter->type = head->type;
-    
-    if (new_filter->type == COMP)
-    {
-        new_filter->value.comp.type = head->value.comp.type;
-        new_filter->value.comp.right = cJSON_Duplicate(head->value.comp.right, false);
-        new_filter->value.comp.left = cJSON_Duplicate(head->value.comp.left, false);
-    }
-    else if (new_filter->type == EXISTS)
-    {
-        new_filter->value.exists = cJSON_Duplicate(head->value.exists, false);
-    }
-    else if (new_filter->type == RESULT)
-    {
-        new_filter->value.results = cJSON_Duplicate(head->value.results, false);
-    }
-    else if (new_filter->type == LIST_ENTRY)
-    {
-        new_filter->value.list_entry = cJSON_Duplicate(head->value.list_entry, false);
-    }
-
-    new_filter->next = cJSONUtils_Duplicate_Filter(head->next);
-    if (new_filter->next)
-    {
-        new_filter->next->prev = new_filter;
-    }
-    return new_filter;
-}
-
-static Selector *cJSONUtils_New_Selector()
-{
-    Selector *selectors = (Selector *) cJSON_malloc(sizeof(Selector));
-    if (selectors)
-    {
-        memset(selectors, '\0', sizeof(Selector));
-    }
-
-    return selectors;
-}
-
-CJSON_PUBLIC(void) cJSONUtils_Delete_Selector(Selector *selector)
-{
-    Selector *next = NULL;
-    while (selector != NULL) {
-        next = selector->next;
-        if (selector->type == DOT)
-        {
-            cJSON_free(selector->value.path);
-        }
-        else if (selector->type == LIST || selector->type == FILTER)
-        {
-            cJSONUtils_Delete_Filter(selector->value.filter);
-        }
-        cJSON_free(selector);
-        selector = next;
-    }
-}
-
-static cJSON *parse_comp_from_str(const char *str)
-{
-    cJSON *node = NULL;
-
-    if (str[0] == '@' || str[0] == '$')
+    cJSON *node = NULL;
+
+    if (str[0] == '@' || str[0] == '$')
     {
         if (str[1] != '.')
         {
             goto error;
         }
-        node = cJSON_CreateObject();
-        node->valuestring = (char *) cJSONUtils_strdup((const unsigned char *) str);
+        node = cJSON_CreateRaw(str);
     }
     else if (str[0] == '-' || isdigit(str[0]))
     {
@@ -1694,7 +2036,13 @@ static cJSON *parse_comp_from_str(const char *str)
         {
             goto error;
         }
-        node = cJSON_CreateNumber(d);
+        /* integral literals stay exact, like the numbers they are compared with */
+        node = cJSON_ParseWithOpts(str, NULL, true);
+        if (!cJSON_IsNumber(node))
+        {
+            cJSON_Delete(node);
+            node = cJSON_CreateNumber(d);
+        }
     }
     else if (str[0] == '\'' || str[0] == '\"')
     {
@@ -2361,64 +2709,115 @@ CJSON_PUBLIC(Selector *) cJSONUtils_CompileSelector(const char * const path)
     return compile_selector(path);
 }
 
-static cJSON *root_selector(const cJSON * const root)
+/* The nodes selected by a JSONPath step, each with the array or object it was
+ * found in. The steps read one set and fill the other, so a query allocates
+ * only when a set outgrows its buffer, never per candidate. */
+typedef struct
+{
+    const cJSON *node;
+    const cJSON *parent;
+} path_node;
+
+typedef struct
 {
-    cJSON *new_items = cJSON_CreateArray();
-    cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(root));
-    return new_items;
+    path_node *nodes;
+    size_t count;
+    size_t size;
+} path_nodes;
+
+static cJSON_bool path_nodes_push(path_nodes * const nodes, const cJSON * const node, const cJSON * const parent)
+{
+    if (nodes->count == nodes->size)
+    {
+        size_t size = (nodes->size == 0) ? 16 : (nodes->size * 2);
+        path_node *grown = (path_node*)cJSON_realloc(nodes->nodes, size * sizeof(path_node));
+        if (grown == NULL)
+        {
+            return false;
+        }
+        nodes->nodes = grown;
+        nodes->size = size;
+    }
+    nodes->nodes[nodes->count].node = node;
+    nodes->nodes[nodes->count].parent = parent;
+    nodes->count++;
+
+    return true;
 }
 
-static cJSON *dot_selector(cJSON *items, const char *path, const cJSON_bool case_sensitive)
+static cJSON_bool path_nodes_contain(const path_nodes * const nodes, const cJSON * const node)
 {
-    cJSON *item_a = NULL;
-    cJSON *item_b = NULL;
+    size_t i = 0;
 
-    cJSON *new_items = cJSON_CreateArray();
-    cJSON_ArrayForEach(item_a, items)
+    for (i = 0; i < nodes->count; i++)
     {
-        item_b = get_object_item(item_a->child, path, case_sensitive);
-        if (item_b)
+        if (nodes->nodes[i].node == node)
         {
-            cJSON *item = cJSON_CreateObjectReference(item_b);
-            item->valuestring = (char *) ((void *) (item_a->child));
-            cJSON_AddItemToArray(new_items, item);
+            return true;
         }
     }
-    return new_items;
+
+    return false;
+}
+
+static void path_nodes_free(path_nodes * const nodes)
+{
+    cJSON_free(nodes->nodes);
+    memset(nodes, '\0', sizeof(path_nodes));
 }
 
-static cJSON *dot_index_wild_selector(cJSON *items)
+static cJSON_bool dot_selector(const path_nodes * const items, path_nodes * const new_items, const char *path, const cJSON_bool case_sensitive)
 {
-    cJSON *item_a = NULL;
-    cJSON *item_b = NULL;
+    const cJSON *item = NULL;
+    size_t i = 0;
 
-    cJSON *new_items = cJSON_CreateArray();
-    cJSON_ArrayForEach(item_a, items)
+    for (i = 0; i < items->count; i++)
     {
-        item_b = item_a->child->child;
-        while (item_b != NULL)
+        item = get_object_item(items->nodes[i].node, path, case_sensitive);
+        if ((item != NULL) && !path_nodes_push(new_items, item, items->nodes[i].node))
         {
-            cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(item_b));
-            item_b = item_b->next;
+            return false;
         }
     }
-    return new_items;
+
+    return true;
 }
 
-static cJSON *index_selector(cJSON *array, Selector *selector)
+static cJSON_bool dot_index_wild_selector(const path_nodes * const items, path_nodes * const new_items)
 {
-    cJSON *new_items = cJSON_CreateArray();
-    int index = selector->value.index;
+    const cJSON *item = NULL;
+    size_t i = 0;
+
+    for (i = 0; i < items->count; i++)
+    {
+        for (item = cJSON_Child(items->nodes[i].node); item != NULL; item = item->next)
+        {
+            if (!path_nodes_push(new_items, item, items->nodes[i].node))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static cJSON_bool index_selector(const cJSON * const array, const int selected, path_nodes * const new_items)
+{
+    int index = selected;
+    const cJSON *item = NULL;
+
     if (index < 0)
     {
         index += cJSON_GetArraySize(array);
     }
-    cJSON *item = get_array_item(array, (size_t) index);
+    item = get_array_item(array, (size_t) index);
     if (item)
     {
-        cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(item));
+        return path_nodes_push(new_items, item, array);
     }
-    return new_items;
+
+    return true;
 }
 
 static int array_slice_normalize(int i, int size)
@@ -2452,10 +2851,8 @@ static void array_slice_bounds(int start, int end, int step, int len, int *lower
     }
 }
 
-static cJSON *array_slice_selector(cJSON *array, Selector *selector)
+static cJSON_bool array_slice_selector(const cJSON * const array, const Selector *selector, path_nodes * const new_items)
 {
-    cJSON *new_items = cJSON_CreateArray();
-
     int start = selector->value.slice[0];
     int end = selector->value.slice[1];
     int step = selector->value.slice[2];
@@ -2463,7 +2860,7 @@ static cJSON *array_slice_selector(cJSON *array, Selector *selector)
 
     if (step == 0)
     {
-        return new_items;
+        return true;
     }
 
     int lower, upper;
@@ -2472,7 +2869,7 @@ static cJSON *array_slice_selector(cJSON *array, Selector *selector)
 
     if (reverse)
     {
-        cJSON *prev = array->child;
+        const cJSON *prev = array->child;
         for (int i = size; i > upper; --i)
         {
             if (prev)
@@ -2482,9 +2879,9 @@ static cJSON *array_slice_selector(cJSON *array, Selector *selector)
         }
         for (; upper > lower; upper += step)
         {
-            if (prev)
+            if (prev && !path_nodes_push(new_items, prev, array))
             {
-                cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(prev));
+                return false;
             }
             for (int i = 0; i > step && fabs((double)i) < upper; --i)
             {
@@ -2497,7 +2894,7 @@ static cJSON *array_slice_selector(cJSON *array, Selector *selector)
     }
     else
     {
-        cJSON *next = array->child;
+        const cJSON *next = array->child;
         for (int i = 0; i < lower; ++i)
         {
             if (next)
@@ -2507,9 +2904,9 @@ static cJSON *array_slice_selector(cJSON *array, Selector *selector)
         }
         for (; lower < upper; lower += step)
         {
-            if (next)
+            if (next && !path_nodes_push(new_items, next, array))
             {
-                cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(next));
+                return false;
             }
             for (int i = 0; i < step && i < upper; ++i)
             {
@@ -2520,127 +2917,80 @@ static cJSON *array_slice_selector(cJSON *array, Selector *selector)
             }
         }
     }
-    return new_items;
+    return true;
 }
 
-static void add_all_decendant(cJSON *items, cJSON *node)
+/* node and everything below it, children before their parents */
+static cJSON_bool add_all_decendant(path_nodes * const new_items, const cJSON * const node, const cJSON * const parent)
 {
-    cJSON *next = NULL;
-    while (node != NULL)
+    const cJSON *child = NULL;
+
+    for (child = cJSON_Child(node); child != NULL; child = child->next)
     {
-        next = node->next;
-        if (node->child != NULL)
+        if (!add_all_decendant(new_items, child, node))
         {
-            add_all_decendant(items, node->child);
+            return false;
         }
-        cJSON_AddItemToArray(items, cJSON_CreateObjectReference(node));
-        node = next;
     }
+
+    return path_nodes_push(new_items, node, parent);
 }
 
-static cJSON *decendant_all_selector(cJSON *items) {
-    cJSON *item_a = NULL;
+static cJSON_bool decendant_all_selector(const path_nodes * const items, path_nodes * const new_items)
+{
+    size_t i = 0;
 
-    cJSON *new_items = cJSON_CreateArray();
-    cJSON_ArrayForEach(item_a, items)
+    for (i = 0; i < items->count; i++)
     {
-        cJSON *node = item_a->child;
-        add_all_decendant(new_items, node);
+        if (!add_all_decendant(new_items, items->nodes[i].node, items->nodes[i].parent))
+        {
+            return false;
+        }
     }
-    return new_items;
+
+    return true;
 }
 
-static cJSON *list_selector(cJSON *array, Selector *selector)
+static cJSON_bool list_selector(const cJSON * const array, const Selector *selector, path_nodes * const new_items)
 {
-    Filter *filter = cJSONUtils_Duplicate_Filter(selector->value.filter);
-    Filter *head = filter;
-    Filter *next = NULL;
-    filter = filter->next; // SKIP FIRST
-    cJSON *new_items = cJSON_CreateArray();
-    while (filter != NULL)
+    const Filter *filter = selector->value.filter->next; // SKIP FIRST
+
+    for (; filter != NULL; filter = filter->next)
     {
-        next = filter->next;
-        if (filter->type == LIST_ENTRY)
+        if ((filter->type != LIST_ENTRY) || !cJSON_IsNumber(filter->value.list_entry))
         {
-            cJSON *list_entry = filter->value.list_entry;
-            if (list_entry->type == cJSON_Number)
-            {
-                int index = list_entry->valueint;
-                if (index < 0)
-                {
-                    index += cJSON_GetArraySize(array);
-                }
-                cJSON *item = get_array_item(array, (size_t) index);
-                if (item)
-                {
-                    cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(item));
-                }
-            }
-            else
-            {
-                goto error;
-            }
+            return false;
         }
-        else
+        if (!index_selector(array, filter->value.list_entry->valueint, new_items))
         {
-            goto error;
+            return false;
         }
-        
-        filter = next;
     }
-    
-    cJSONUtils_Delete_Filter(head);
-    return new_items;
 
-error:
-    cJSON_Delete(new_items);
-    cJSONUtils_Delete_Filter(head);
-    return cJSON_CreateArray();
+    return true;
 }
 
-static cJSON *get_item_from_selector(const cJSON * const object, const Selector *selector, 
-                                     const cJSON_bool case_sensitive, const cJSON_bool reference);
-static cJSON *execute_filter_value(const cJSON * const root, cJSON *items, cJSON *node)
+/* -1, 0 or 1 as left is below, equal to or above right, exact between two integers */
+static int number_order(const cJSON *left, const cJSON *right)
 {
-    if (node->valuestring && node->valuestring[0] == '@')
-    {
-        size_t len = strlen(node->valuestring);
-        char path[len];
-        memset(path, '\0', len);
-        strncpy(path, node->valuestring + 2, len - 2);
-        return dot_selector(items, path, true);
-    }
-    else if (node->valuestring && node->valuestring[0] == '$')
+    double l = 0;
+    double r = 0;
+
+    if (left->type & right->type & cJSON_NumberIsInt)
     {
-        Selector *selector = compile_selector(node->valuestring);
-        if (selector == NULL)
-        {
-            return cJSON_CreateArray();
-        }
-        cJSON *results = get_item_from_selector(root, selector, true, true);
-        cJSONUtils_Delete_Selector(selector);
-        
-        if (results->child == NULL) {
-            return results;
-        }
-        
-        cJSON *child = (cJSON *)results->child->child;
-        if (child->type != cJSON_Array && child->type != cJSON_Object)
-        {
-            cJSON_Delete(results);
-            return child;
-        }
-        else 
-        {
-            return cJSON_CreateArray();
-        }
+        return (left->valueint64 > right->valueint64) - (left->valueint64 < right->valueint64);
     }
-    return node;
+    l = cJSON_ValueDouble(left);
+    r = cJSON_ValueDouble(right);
+    return (l > r) - (l < r);
 }
 
-static int filter_compare(cJSON *left, cJSON *right, enum CompType type)
+static int filter_compare(const cJSON *left, const cJSON *right, enum CompType type)
 {
-    if (left->type != right->type)
+    /* compare the value types only, a member name may be shared */
+    const int left_type = left->type & 0xFF;
+
+    if (left_type != (right->type & 0xFF))
     {
         return 0;
     }
@@ -2648,73 +2998,73 @@ static int filter_compare(cJSON *left, cJSON *right, enum CompType type)
     switch (type) {
         case GT:
         {
-            if (left->type == cJSON_String || left->type == cJSON_Raw)
+            if (left_type == cJSON_String || left_type == cJSON_Raw)
             {
                 return strcmp(left->valuestring, right->valuestring) > 0;
             }
-            else if (left->type == cJSON_Number)
+            else if (left_type == cJSON_Number)
             {
-                return left->valuedouble > right->valuedouble;
+                return number_order(left, right) > 0;
             }
             return 0;
         }
         case LT:
         {
-            if (left->type == cJSON_String || left->type == cJSON_Raw)
+            if (left_type == cJSON_String || left_type == cJSON_Raw)
             {
                 return strcmp(left->valuestring, right->valuestring) < 0;
             }
-            else if (left->type == cJSON_Number)
+            else if (left_type == cJSON_Number)
             {
-                return left->valuedouble < right->valuedouble;
+                return number_order(left, right) < 0;
             }
             return 0;
         }
         case GTE:
         {
-            if (left->type == cJSON_String || left->type == cJSON_Raw)
+            if (left_type == cJSON_String || left_type == cJSON_Raw)
             {
                 return strcmp(left->valuestring, right->valuestring) >= 0;
             }
-            else if (left->type == cJSON_Number)
+            else if (left_type == cJSON_Number)
             {
-                return left->valuedouble >= right->valuedouble;
+                return number_order(left, right) >= 0;
             }
             return 1;
         }
         case LTE:
         {
-            if (left->type == cJSON_String || left->type == cJSON_Raw)
+            if (left_type == cJSON_String || left_type == cJSON_Raw)
             {
                 return strcmp(left->valuestring, right->valuestring) <= 0;
             }
-            else if (left->type == cJSON_Number)
+            else if (left_type == cJSON_Number)
             {
-                return left->valuedouble <= right->valuedouble;
+                return number_order(left, right) <= 0;
             }
             return 1;
         }
         case EQ:
         {
-            if (left->type == cJSON_String || left->type == cJSON_Raw)
+            if (left_type == cJSON_String || left_type == cJSON_Raw)
             {
                 return strcmp(left->valuestring, right->valuestring) == 0;
             }
-            else if (left->type == cJSON_Number)
+            else if (left_type == cJSON_Number)
             {
-                return left->valuedouble == right->valuedouble;
+                return number_order(left, right) == 0;
             }
             return 1;
         }
         case NE:
         {
-            if (left->type == cJSON_String || left->type == cJSON_Raw)
+            if (left_type == cJSON_String || left_type == cJSON_Raw)
             {
                 return strcmp(left->valuestring, right->valuestring) != 0;
             }
-            else if (left->type == cJSON_Number)
+            else if (left_type == cJSON_Number)
             {
-                return left->valuedouble != right->valuedouble;
+                return number_order(left, right) != 0;
             }
             return 0;
         }
@@ -2722,497 +3072,447 @@ static int filter_compare(cJSON *left, cJSON *right, enum CompType type)
     return 0;
 }
 
-static Filter *execute_filter(const cJSON * const root, cJSON *items, Filter *f)
+/* Filters are evaluated on a copy of their token list: each bracketed group is
+ * reduced to a RESULT step holding the candidates it matched. */
+typedef struct filter_step
 {
-    Filter *result = cJSONUtils_New_Filter();
-    result->type = RESULT;
+    enum FilterType type;
+    const Filter *filter;
+    path_nodes results;
+    struct filter_step *next;
+    struct filter_step *prev;
+} filter_step;
 
-    if (f->type == EXISTS)
+typedef struct
+{
+    const cJSON *root;
+    const path_nodes *candidates;
+    /* the values a comparison reads, reused by every comparison */
+    path_nodes left;
+    path_nodes right;
+} filter_context;
+
+static const path_nodes *select_nodes(const cJSON * const object, const Selector *selector,
+                                      const cJSON_bool case_sensitive, path_nodes * const buffers);
+
+/* Either the values of the candidates' member for @.name, or one value. */
+static cJSON_bool execute_filter_value(filter_context * const context, const cJSON * const node,
+                                       path_nodes * const values, const cJSON ** const value)
+{
+    values->count = 0;
+    *value = NULL;
+    if (cJSON_ValueString(node) && node->valuestring[0] == '@')
     {
-        cJSON *item_a = NULL;
-        cJSON *item_b = NULL;
-        size_t len = strlen(f->value.exists->valuestring);
-        char path[len];
-        memset(path, '\0', len);
-        strncpy(path, f->value.exists->valuestring + 2, len - 2);
-        result->value.results = cJSON_CreateArray();
-        cJSON_ArrayForEach(item_a, items)
-        {
-            item_b = get_object_item(item_a->child, path, true);
-            if (item_b)
-            {
-                // we add item_a, because @ means parent node
-                cJSON_AddItemToArray(result->value.results, cJSON_CreateObjectReference(item_a->child));
-            }
-        }
+        /* a bare @ names no member */
+        return (node->valuestring[1] == '\0') || dot_selector(context->candidates, values, node->valuestring + 2, true);
     }
-    else if (f->type == COMP)
+    else if (cJSON_ValueString(node) && node->valuestring[0] == '$')
     {
-        cJSON *left_values = execute_filter_value(root, items, f->value.comp.left);
-        cJSON *right_values = execute_filter_value(root, items, f->value.comp.right);
-        cJSON *new_items = cJSON_CreateArray();
-        if (cJSON_IsArray(left_values) && cJSON_IsArray(right_values))
-        {
-            cJSON *lnode = left_values->child;
-            cJSON *rnode = right_values->child;
-            while (lnode && rnode)
-            {
-                if (filter_compare(lnode->child, rnode->child, f->value.comp.type))
-                {
-                    // we need add lnode->valuestring, which means father node
-                    cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference((cJSON *)((void *)lnode->valuestring)));
-                }
-                lnode = lnode->next;
-                rnode = rnode->next;
-            }
-            cJSON_Delete(left_values);
-            cJSON_Delete(right_values);
-            result->value.results = new_items;
-        }
-        else if (cJSON_IsArray(left_values) && !cJSON_IsArray(right_values))
+        path_nodes buffers[2];
+        const path_nodes *results = NULL;
+        Selector *selector = compile_selector(node->valuestring);
+        if (selector == NULL)
         {
-            cJSON *lnode = left_values->child;
-            cJSON *rnode = right_values;
-            while (lnode)
-            {
-                if (filter_compare(lnode->child, rnode, f->value.comp.type))
-                {
-                    // we need add lnode->valuestring, which means father node
-                    cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference((cJSON *)((void *)lnode->valuestring)));
-                }
-                lnode = lnode->next;
-            }
-            cJSON_Delete(left_values);
-            result->value.results = new_items;
+            return true;
         }
-        else if (!cJSON_IsArray(left_values) && cJSON_IsArray(right_values))
-        {
-            cJSON *lnode = left_values;
-            cJSON *rnode = right_values->child;
-            while (rnode)
-            {
-                if (filter_compare(lnode, rnode->child, f->value.comp.type))
-                {
-                    // we need add rnode->valuestring, which means father node
-                    cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference((cJSON *)((void *)rnode->valuestring)));
-                }
-                rnode = rnode->next;
-            }
-            cJSON_Delete(right_values);
-            result->value.results = new_items;
-        }
-        else
+        memset(buffers, '\0', sizeof(buffers));
+        results = select_nodes(context->root, selector, true, buffers);
+        cJSONUtils_Delete_Selector(selector);
+
+        /* only the first value, and only if it is a scalar */
+        if ((results->count > 0) && !cJSON_IsArray(results->nodes[0].node) && !cJSON_IsObject(results->nodes[0].node))
         {
-            goto error;
+            *value = results->nodes[0].node;
         }
-    }
-    else
-    {
-        goto error;
+        path_nodes_free(&buffers[0]);
+        path_nodes_free(&buffers[1]);
+        return true;
     }
 
-    return result;
-
-error:
-    cJSONUtils_Delete_Filter(result);
-    return NULL;
+    *value = node;
+    return true;
 }
 
-static Filter *execute_filter_and(const cJSON * const root, cJSON *items, Filter *left, Filter *right)
+static cJSON_bool execute_filter(filter_context * const context, const Filter * const f, path_nodes * const results)
 {
-    Filter *lef = NULL;
-    Filter *ref = NULL;
-    int lneedfree = 0;
-    int rneedfree = 0;
-
-    if (left->type == RESULT)
-    {
-        lef = left;
-    }
-    else
-    {
-        lef = execute_filter(root, items, left);
-        lneedfree = 1;
-    }
+    size_t i = 0;
 
-    if (right->type == RESULT)
+    if (f->type == EXISTS)
     {
-        ref = right;
+        if ((cJSON_ValueString(f->value.exists) == NULL) || (strlen(f->value.exists->valuestring) < 2))
+        {
+            return false;
+        }
+        for (i = 0; i < context->candidates->count; i++)
+        {
+            const cJSON *candidate = context->candidates->nodes[i].node;
+            // we add the candidate, because @ means parent node
+            if (get_object_item(candidate, f->value.exists->valuestring + 2, true) &&
+                !path_nodes_push(results, candidate, NULL))
+            {
+                return false;
+            }
+        }
+        return true;
     }
-    else
+    else if (f->type == COMP)
     {
-        ref = execute_filter(root, items, right);
-        rneedfree = 1;
-    }
+        const cJSON *lvalue = NULL;
+        const cJSON *rvalue = NULL;
+        path_nodes *lvalues = &context->left;
+        path_nodes *rvalues = &context->right;
 
-    if (lef == NULL || ref == NULL)
-    {
-        return NULL;
-    }
+        if (!execute_filter_value(context, f->value.comp.left, lvalues, &lvalue) ||
+            !execute_filter_value(context, f->value.comp.right, rvalues, &rvalue))
+        {
+            return false;
+        }
+        if ((lvalue != NULL) && (rvalue != NULL))
+        {
+            return false;
+        }
 
-    cJSON *new_items = cJSON_CreateArray();
-    for (cJSON *l = lef->value.results->child; l != NULL; l = l->next)
-    {
-        cJSON *r = NULL;
-        for (r = ref->value.results->child; r != NULL; r = r->next)
+        // we need add the father node of the member compared
+        for (i = 0; (lvalue == NULL) && (i < lvalues->count); i++)
         {
-            if (l->child == r->child)
+            if (rvalue == NULL && i >= rvalues->count)
             {
                 break;
             }
+            if (filter_compare(lvalues->nodes[i].node, rvalue ? rvalue : rvalues->nodes[i].node, f->value.comp.type) &&
+                !path_nodes_push(results, lvalues->nodes[i].parent, NULL))
+            {
+                return false;
+            }
         }
-        if (r != NULL)
+        for (i = 0; (lvalue != NULL) && (i < rvalues->count); i++)
         {
-            cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(r->child));
+            if (filter_compare(lvalue, rvalues->nodes[i].node, f->value.comp.type) &&
+                !path_nodes_push(results, rvalues->nodes[i].parent, NULL))
+            {
+                return false;
+            }
         }
+        return true;
     }
 
-    if (lneedfree)
-    {
-        cJSONUtils_Delete_Filter(lef);
-    }
-    if (rneedfree)
-    {
-        cJSONUtils_Delete_Filter(ref);
-    }
-
-    Filter *result = cJSONUtils_New_Filter();
-    result->type = RESULT;
-    result->value.results = new_items;
-    return result;
+    return false;
 }
 
-static Filter *execute_filter_or(const cJSON * const root, cJSON *items, Filter *left, Filter *right)
+/* Makes step a RESULT, evaluating it if it is a test. */
+static cJSON_bool execute_filter_step(filter_context * const context, filter_step * const step)
 {
-    Filter *lef = NULL;
-    Filter *ref = NULL;
-    int lneedfree = 0;
-    int rneedfree = 0;
-
-    if (left->type == RESULT)
-    {
-        lef = left;
-    }
-    else
+    if (step->type == RESULT)
     {
-        lef = execute_filter(root, items, left);
-        lneedfree = 1;
+        return true;
     }
-
-    if (right->type == RESULT)
+    if ((step->type != EXISTS) && (step->type != COMP))
     {
-        ref = right;
+        return false;
     }
-    else
+    if (!execute_filter(context, step->filter, &step->results))
     {
-        ref = execute_filter(root, items, right);
-        rneedfree = 1;
+        return false;
     }
+    step->type = RESULT;
 
-    if (lef == NULL || ref == NULL)
-    {
-        return NULL;
-    }
+    return true;
+}
 
-    cJSON *new_items = cJSON_CreateArray();
-    for (cJSON *r = ref->value.results->child; r != NULL; r = r->next)
+/* Reduces left op right to a RESULT in the op step. */
+static cJSON_bool execute_filter_operator(filter_context * const context, filter_step * const f)
+{
+    const path_nodes *left = NULL;
+    const path_nodes *right = NULL;
+    size_t i = 0;
+
+    if ((f->prev == NULL) || (f->next == NULL) ||
+        !execute_filter_step(context, f->prev) || !execute_filter_step(context, f->next))
     {
-        cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(r->child));
+        return false;
     }
-    for (cJSON *l = lef->value.results->child; l != NULL; l = l->next)
+    left = &f->prev->results;
+    right = &f->next->results;
+
+    if (f->type == OR)
     {
-        cJSON *r = NULL;
-        for (r = ref->value.results->child; r != NULL; r = r->next)
+        for (i = 0; i < right->count; i++)
         {
-            if (l->child == r->child)
+            if (!path_nodes_push(&f->results, right->nodes[i].node, NULL))
             {
-                break;
+                return false;
             }
         }
-        if (r == NULL)
+    }
+    for (i = 0; i < left->count; i++)
+    {
+        cJSON_bool in_right = path_nodes_contain(right, left->nodes[i].node);
+        if (((f->type == AND) == in_right) && !path_nodes_push(&f->results, left->nodes[i].node, NULL))
         {
-            cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(l->child));
+            return false;
         }
     }
+    f->type = RESULT;
 
-    if (lneedfree)
+    f->prev = f->prev->prev;
+    f->prev->next = f;
+    f->next = f->next->next;
+    if (f->next)
     {
-        cJSONUtils_Delete_Filter(lef);
-    }
-    if (rneedfree)
-    {
-        cJSONUtils_Delete_Filter(ref);
+        f->next->prev = f;
     }
 
-    Filter *result = cJSONUtils_New_Filter();
-    result->type = RESULT;
-    result->value.results = new_items;
-    return result;
+    return true;
 }
 
-static Filter *execute_filter_unit(const cJSON * const root, cJSON *items, Filter *start, Filter *end)
+static filter_step *execute_filter_unit(filter_context * const context, filter_step * const start, filter_step * const end)
 {
-    // First we handle &&
-    Filter *f = NULL;
+    filter_step *f = NULL;
+
+    // First we handle &&, then ||
     for (f = start; f != end; f = f->next)
     {
-        if (f->type == AND)
+        if ((f->type == AND) && !execute_filter_operator(context, f))
         {
-            if (f->prev && f->next)
-            {
-                Filter *result = execute_filter_and(root, items, f->prev, f->next);
-                if (result == NULL)
-                {
-                    goto error;
-                }
-                else
-                {
-                    f->prev->prev->next = result;
-                    result->prev = f->prev->prev;
-                    result->next = f->next->next;
-                    f->next->next->prev = result;
-
-                    cJSONUtils_Free_Filter(f->prev);
-                    cJSONUtils_Free_Filter(f);
-                    cJSONUtils_Free_Filter(f->next);
-                    f = result;
-                }
-            }
-            else
-            {
-                goto error;
-            }
+            return NULL;
         }
     }
-
-    // Then we handle ||
     for (f = start; f != end; f = f->next)
     {
-        if (f->type == OR)
+        if ((f->type == OR) && !execute_filter_operator(context, f))
         {
-            if (f->prev && f->next)
-            {
-                Filter *result = execute_filter_or(root, items, f->prev, f->next);
-                if (result == NULL)
-                {
-                    goto error;
-                }
-                else
-                {
-                    f->prev->prev->next = result;
-                    result->prev = f->prev->prev;
-                    result->next = f->next->next;
-                    f->next->next->prev = result;
-
-                    cJSONUtils_Free_Filter(f->prev);
-                    cJSONUtils_Free_Filter(f);
-                    cJSONUtils_Free_Filter(f->next);
-                    f = result;
-                }
-            }
-            else
-            {
-                goto error;
-            }
+            return NULL;
         }
     }
 
     if (start->type != LEFT_BRACKETS || end->type != RIGHT_BRACKETS || start->next->next != end)
     {
-        goto error;
+        return NULL;
     }
-
-    if (start->next->type != RESULT && (start->next->type == EXISTS || start->next->type == COMP))
+    if (!execute_filter_step(context, start->next))
     {
-        Filter *result = execute_filter(root, items, start->next);
-        cJSONUtils_Free_Filter(start->next);
-        start->next = result;
-        result->prev = start;
-        result->next = end;
-        end->prev = result;
+        return NULL;
     }
 
     return start->next;
-
-error:
-    return NULL;
 }
 
-static cJSON *filter_selector(const cJSON * const root, cJSON *items, Selector *selector)
+static cJSON_bool filter_selector(const cJSON * const root, const path_nodes * const items, const Selector *selector,
+                                  path_nodes * const new_items)
 {
-    Filter *filter = cJSONUtils_Duplicate_Filter(selector->value.filter);
-    Filter *head = filter;
-    Filter *next = NULL;
-    Filter *prev = NULL;
-    while (filter != NULL)
+    filter_context context;
+    filter_step *steps = NULL;
+    filter_step *head = NULL;
+    filter_step *filter = NULL;
+    filter_step *next = NULL;
+    filter_step *prev = NULL;
+    const Filter *f = NULL;
+    cJSON_bool successful = false;
+    size_t count = 0;
+    size_t i = 0;
+
+    memset(&context, '\0', sizeof(context));
+    context.root = root;
+    context.candidates = items;
+
+    for (f = selector->value.filter; f != NULL; f = f->next)
+    {
+        count++;
+    }
+    steps = (filter_step*)cJSON_malloc(count * sizeof(filter_step));
+    if (steps == NULL)
+    {
+        return false;
+    }
+    memset(steps, '\0', count * sizeof(filter_step));
+    for (f = selector->value.filter, i = 0; f != NULL; f = f->next, i++)
+    {
+        steps[i].type = f->type;
+        steps[i].filter = f;
+        steps[i].prev = (i > 0) ? &steps[i - 1] : NULL;
+        steps[i].next = (i + 1 < count) ? &steps[i + 1] : NULL;
+    }
+    head = steps;
+
+    for (filter = head; filter != NULL; filter = next)
     {
         next = filter->next;
-        prev = filter;
         if (filter->type == RIGHT_BRACKETS)
         {
-            while (prev->type != LEFT_BRACKETS)
+            for (prev = filter; (prev != NULL) && (prev->type != LEFT_BRACKETS); prev = prev->prev)
             {
-                prev = prev->prev;
             }
-            Filter *result = execute_filter_unit(root, items, prev, filter);
+            if ((prev == NULL) || (prev->prev == NULL))
+            {
+                goto end;
+            }
+            filter_step *result = execute_filter_unit(&context, prev, filter);
             if (result == NULL)
             {
-                goto error;
+                goto end;
             }
-            else {
-                prev->prev->next = result;
-                result->prev = prev->prev;
-                result->next = next;
-                if (next)
-                {
-                    next->prev = result;
-                }
-                cJSONUtils_Free_Filter(prev);
-                cJSONUtils_Free_Filter(filter);
+            prev->prev->next = result;
+            result->prev = prev->prev;
+            result->next = next;
+            if (next)
+            {
+                next->prev = result;
             }
         }
-
-        filter = next;
     }
 
-    if (head->next->next != NULL || head->next->type != RESULT)
+    if (head->next == NULL || head->next->next != NULL || head->next->type != RESULT)
     {
-        goto error;
+        goto end;
     }
 
-    cJSON *new_items = cJSON_CreateArray();
-    for (cJSON *r = head->next->value.results->child; r != NULL; r = r->next)
+    successful = true;
+    for (i = 0; successful && (i < head->next->results.count); i++)
     {
-        cJSON_AddItemToArray(new_items, cJSON_CreateObjectReference(r->child));
+        successful = path_nodes_push(new_items, head->next->results.nodes[i].node, NULL);
     }
 
-    cJSONUtils_Delete_Filter(head);
-    return new_items;
-
-error:
-    cJSONUtils_Delete_Filter(head);
-    return cJSON_CreateArray();
+end:
+    for (i = 0; i < count; i++)
+    {
+        path_nodes_free(&steps[i].results);
+    }
+    cJSON_free(steps);
+    path_nodes_free(&context.left);
+    path_nodes_free(&context.right);
+    return successful;
 }
 
-static cJSON *get_item_from_selector(const cJSON * const object, const Selector *selector,
-                                     const cJSON_bool case_sensitive, const cJSON_bool reference)
+/* Runs the selector on object with the two buffers, returning the one holding
+ * the nodes selected. It is empty if the selector doesn't apply. */
+static const path_nodes *select_nodes(const cJSON * const object, const Selector *selector,
+                                      const cJSON_bool case_sensitive, path_nodes * const buffers)
 {
-    if (selector == NULL)
+    path_nodes *items = &buffers[0];
+    path_nodes *new_items = &buffers[1];
+    path_nodes *swap = NULL;
+    const Selector *next_selector = selector;
+    cJSON_bool successful = true;
+
+    items->count = 0;
+    if (!path_nodes_push(items, object, NULL)) // Automatically create ROOT selector.
     {
-        return NULL;
+        return items;
     }
-    cJSON *items = root_selector(object); // Automatically create ROOT selector.
-    Selector *next_selector = (Selector *)selector;
     while (next_selector != NULL)
     {
+        new_items->count = 0;
         switch (next_selector->type) {
             case HEAD:
             case ROOT:
             {
-                break; // do nothing
+                next_selector = next_selector->next;
+                continue; // do nothing
             }
             case DOT:
             {
-                cJSON *new_items = dot_selector(items, next_selector->value.path, case_sensitive);
-                cJSON_Delete(items);
-                items = new_items;
+                successful = dot_selector(items, new_items, next_selector->value.path, case_sensitive);
                 break;
             }
             case DOT_WILD:
             case INDEX_WILD:
             {
-                cJSON *new_items = dot_index_wild_selector(items);
-                cJSON_Delete(items);
-                items = new_items;
+                successful = dot_index_wild_selector(items, new_items);
                 break;
             }
             case INDEX:
+            case ARRAY_SLICE:
+            case LIST:
             {
-                // We assume that for INDEX, only one operand is allowed, and it must be an array type.
-                cJSON *array = items->child->child;
-                if (cJSON_GetArraySize(items) != 1 || !cJSON_IsArray(array))
+                // We assume that for these, only one operand is allowed, and it must be an array type.
+                const cJSON *array = items->nodes[0].node;
+                if (items->count != 1 || !cJSON_IsArray(array))
                 {
-                    goto error;
+                    successful = false;
                 }
-                cJSON *new_items = index_selector(array, next_selector);
-                cJSON_Delete(items);
-                items = new_items;
-                break;
-            }
-            case ARRAY_SLICE:
-            {
-                // We assume that for ARRAY_SLICE, only one operand is allowed, and it must be an array type.
-                cJSON *array = items->child->child;
-                if (cJSON_GetArraySize(items) != 1 || !cJSON_IsArray(array))
+                else if (next_selector->type == INDEX)
                 {
-                    goto error;
+                    successful = index_selector(array, next_selector->value.index, new_items);
+                }
+                else if (next_selector->type == ARRAY_SLICE)
+                {
+                    successful = array_slice_selector(array, next_selector, new_items);
+                }
+                else
+                {
+                    successful = list_selector(array, next_selector, new_items);
                 }
-                cJSON *new_items = array_slice_selector(array, next_selector);
-                cJSON_Delete(items);
-                items = new_items;
                 break;
             }
             case DECENDANT:
             {
-                cJSON *new_items = decendant_all_selector(items);
-                cJSON_Delete(items);
-                items = new_items;
-                break;
-            }
-            case LIST:
-            {
-                // We assume that for LIST, only one operand is allowed, and it must be an array type.
-                cJSON *array = items->child->child;
-                if (cJSON_GetArraySize(items) != 1 || !cJSON_IsArray(array))
-                {
-                    goto error;
-                }
-                cJSON *new_items = list_selector(array, next_selector);
-                cJSON_Delete(items);
-                items = new_items;
+                successful = decendant_all_selector(items, new_items);
                 break;
             }
             case FILTER:
             {
-                // execute split first
-                if (cJSON_GetArraySize(items) != 1)
+                // execute split first, the filter picks from the children
+                if (items->count != 1 || !dot_index_wild_selector(items, new_items))
                 {
-                    goto error;
+                    successful = false;
+                    break;
                 }
-                cJSON *new_items = dot_index_wild_selector(items);
-                cJSON_Delete(items);
-                items = new_items;
-
-                new_items = filter_selector(object, items, next_selector);
-                cJSON_Delete(items);
+                swap = items;
                 items = new_items;
+                new_items = swap;
+                new_items->count = 0;
+                successful = filter_selector(object, items, next_selector, new_items);
                 break;
             }
         }
 
-        if (cJSON_GetArraySize(items) == 0) {
+        swap = items;
+        items = new_items;
+        new_items = swap;
+        if (!successful)
+        {
+            items->count = 0;
+        }
+        if (items->count == 0)
+        {
             return items;
         }
         next_selector = next_selector->next;
     }
 
-    if (reference)
+    return items;
+}
+
+static cJSON *get_item_from_selector(const cJSON * const object, const Selector *selector,
+                                     const cJSON_bool case_sensitive, const cJSON_bool reference)
+{
+    path_nodes buffers[2];
+    const path_nodes *items = NULL;
+    cJSON *results = NULL;
+    size_t i = 0;
+
+    if (selector == NULL)
     {
-        return items;
+        return NULL;
     }
-    
-    cJSON *item = NULL;
-    cJSON *dup_array = cJSON_CreateArray();
-    cJSON_ArrayForEach(item, items)
+    memset(buffers, '\0', sizeof(buffers));
+    items = select_nodes(object, selector, case_sensitive, buffers);
+
+    results = cJSON_CreateArray();
+    for (i = 0; (results != NULL) && (i < items->count); i++)
     {
-        cJSON_AddItemToArray(dup_array, cJSON_Duplicate(item->child, true));
+        cJSON *item = reference ? cJSON_CreateObjectReference(items->nodes[i].node) : cJSON_Duplicate(items->nodes[i].node, true);
+        if (!cJSON_AddItemToArray(results, item))
+        {
+            cJSON_Delete(item);
+            cJSON_Delete(results);
+            results = NULL;
+        }
     }
-    cJSON_Delete(items);
-    return dup_array;
 
-error:
-    cJSON_Delete(items);
-    return cJSON_CreateArray();
+    path_nodes_free(&buffers[0]);
+    path_nodes_free(&buffers[1]);
+    return results;
 }
 
 CJSON_PUBLIC(cJSON *) cJSONUtils_GetSelector(const cJSON * const object, const Selector *selector)
@@ -3220,6 +3520,40 @@ CJSON_PUBLIC(cJSON *) cJSONUtils_GetSelector(const cJSON * const object, const S
     return get_item_from_selector(object, selector, true, false);
 }
 
+CJSON_PUBLIC(size_t) cJSONUtils_PrintSelector(const cJSON * const object, const Selector *selector, char **buffer, size_t *size, size_t hint, const cJSON_bool format)
+{
+    path_nodes buffers[2];
+    const path_nodes *items = NULL;
+    const cJSON **nodes = NULL;
+    size_t length = 0;
+    size_t i = 0;
+
+    if (selector == NULL)
+    {
+        return 0;
+    }
+    memset(buffers, '\0', sizeof(buffers));
+    items = select_nodes(object, selector, true, buffers);
+
+    if (items->count > 0)
+    {
+        nodes = (const cJSON**)cJSON_malloc(items->count * sizeof(cJSON*));
+    }
+    if ((items->count == 0) || (nodes != NULL))
+    {
+        for (i = 0; i < items->count; i++)
+        {
+            nodes[i] = items->nodes[i].node;
+        }
+        length = cJSON_PrintItemsToBuffer(nodes, items->count, buffer, size, hint, format);
+    }
+
+    cJSON_free(nodes);
+    path_nodes_free(&buffers[0]);
+    path_nodes_free(&buffers[1]);
+    return length;
+}
+
 CJSON_PUBLIC(cJSON *) cJSONUtils_GetPath(const cJSON * const object, const char * const path)
 {
     Selector *selector = compile_selector(path);
@@ -44,6 +44,50 @@ CJSON_PUBLIC(void) cJSONUtils_AddPatchToArray(cJSON * const array, const char *
 CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * const patches);
 CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, const cJSON * const patches);
 
+/* Where a JSON pointer leads, resolved once for writing there. */
+typedef struct cJSONUtils_Location
+{
+    cJSON *parent;     /* the array or object the pointer ends in, NULL for the root */
+    cJSON *item;       /* the item there, NULL if there is none yet */
+    const char *token; /* the last token of the pointer, points into the pointer */
+    size_t index;      /* the index in an array parent, its size for "-" */
+    cJSON_bool decoded; /* token is decoded already, it is still encoded in a pointer string */
+} cJSONUtils_Location;
+
+/* A token of a compiled JSON pointer. */
+typedef struct cJSONUtils_Token
+{
+    const char *name;      /* ~0 and ~1 decoded */
+    size_t index;          /* the array index name stands for, if is_index */
+    cJSON_bool is_index;
+    cJSON_bool valid_name; /* false after an invalid escape, such a name matches no member */
+} cJSONUtils_Token;
+
+/* A JSON pointer split into tokens that are decoded once, to be followed any number of times.
+ * A relative pointer doesn't start with '/', it leads to the object itself and nothing can be added there. */
+typedef struct cJSONUtils_Pointer
+{
+    cJSONUtils_Token *tokens;
+    size_t count;
+    cJSON_bool relative;
+} cJSONUtils_Pointer;
+
+/* Resolves pointer in a single walk. Returns 0, or the ApplyPatches status of an "add" there:
+ * 9 if there is no array or object to add to, 11 for a malformed array index. */
+CJSON_PUBLIC(int) cJSONUtils_LocateCaseSensitive(cJSON * const object, const char * const pointer, cJSONUtils_Location * const location);
+/* Puts value at location: a "replace" patch if there is an item there, an "add" otherwise.
+ * value is taken over: it is part of object afterwards, or deleted on failure.
+ * Returns 0, or 10 for an array index past the end. */
+CJSON_PUBLIC(int) cJSONUtils_SetAtLocation(cJSON * const object, const cJSONUtils_Location * const location, cJSON * const value);
+/* Detaches the item at location, NULL for the root or if there is none. */
+CJSON_PUBLIC(cJSON *) cJSONUtils_DetachAtLocation(const cJSONUtils_Location * const location);
+
+/* Compiles pointer, the result is a single block to free with cJSON_free. NULL if out of memory. */
+CJSON_PUBLIC(cJSONUtils_Pointer *) cJSONUtils_CompilePointer(const char * const pointer);
+/* Same as GetPointerCaseSensitive and LocateCaseSensitive, following a compiled pointer. */
+CJSON_PUBLIC(cJSON *) cJSONUtils_GetCompiledPointer(cJSON * const object, const cJSONUtils_Pointer * const pointer);
+CJSON_PUBLIC(int) cJSONUtils_LocateCompiledPointer(cJSON * const object, const cJSONUtils_Pointer * const pointer, cJSONUtils_Location * const location);
+
 /*
 // Note that ApplyPatches is NOT atomic on failure. To implement an atomic ApplyPatches, use:
 //int cJSONUtils_AtomicApplyPatches(cJSON **object, cJSON *patches)
@@ -97,7 +141,6 @@ typedef struct Filter
             cJSON *right;
         } comp;
         cJSON *exists;
-        cJSON *results;
         cJSON *list_entry;
     } value;
     struct Filter *next;
@@ -124,6 +167,8 @@ typedef struct Selector
 CJSON_PUBLIC(Selector *) cJSONUtils_CompileSelector(const char * const path);
 CJSON_PUBLIC(void) cJSONUtils_Delete_Selector(Selector *selector);
 CJSON_PUBLIC(cJSON *) cJSONUtils_GetSelector(const cJSON * const object, const Selector *selector);
+/* Prints what cJSONUtils_GetSelector would return, straight from the nodes of object, see cJSON_PrintToBuffer. */
+CJSON_PUBLIC(size_t) cJSONUtils_PrintSelector(const cJSON * const object, const Selector *selector, char **buffer, size_t *size, size_t hint, const cJSON_bool format);
 CJSON_PUBLIC(cJSON *) cJSONUtils_GetPath(const cJSON * const object, const char * const path);
 CJSON_PUBLIC(cJSON *) cJSONUtils_GetPathReference(const cJSON * const object, const char * const path);
 
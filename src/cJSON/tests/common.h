@@ -27,11 +27,11 @@
 
 void reset(cJSON *item);
 void reset(cJSON *item) {
-    if ((item != NULL) && (item->child != NULL))
+    if (cJSON_Child(item) != NULL)
     {
         cJSON_Delete(item->child);
     }
-    if ((item->valuestring != NULL) && !(item->type & cJSON_IsReference))
+    if ((cJSON_ValueString(item) != NULL) && !(item->type & cJSON_IsReference))
     {
         global_hooks.deallocate(item->valuestring);
     }
@@ -104,14 +104,14 @@ cleanup:
 #define assert_has_no_reference(item) TEST_ASSERT_BITS_MESSAGE(cJSON_IsReference, 0, item->type, "Item should not have a string as reference.")
 #define assert_has_no_const_string(item) TEST_ASSERT_BITS_MESSAGE(cJSON_StringIsConst, 0, item->type, "Item should not have a const string.")
 #define assert_has_valuestring(item) TEST_ASSERT_NOT_NULL_MESSAGE(item->valuestring, "Valuestring is NULL.")
-#define assert_has_no_valuestring(item) TEST_ASSERT_NULL_MESSAGE(item->valuestring, "Valuestring is not NULL.")
+#define assert_has_no_valuestring(item) TEST_ASSERT_NULL_MESSAGE(cJSON_ValueString(item), "Valuestring is not NULL.")
 #define assert_has_string(item) TEST_ASSERT_NOT_NULL_MESSAGE(item->string, "String is NULL")
 #define assert_has_no_string(item) TEST_ASSERT_NULL_MESSAGE(item->string, "String is not NULL.")
 #define assert_not_in_list(item) \
 	TEST_ASSERT_NULL_MESSAGE(item->next, "Linked list next pointer is not NULL.");\
 	TEST_ASSERT_NULL_MESSAGE(item->prev, "Linked list previous pointer is not NULL.")
 #define assert_has_child(item) TEST_ASSERT_NOT_NULL_MESSAGE(item->child, "Item doesn't have a child.")
-#define assert_has_no_child(item) TEST_ASSERT_NULL_MESSAGE(item->child, "Item has a child.")
+#define assert_has_no_child(item) TEST_ASSERT_NULL_MESSAGE(cJSON_Child(item), "Item has a child.")
 #define assert_is_invalid(item) \
 	assert_has_type(item, cJSON_Invalid);\
 	assert_not_in_list(item);\
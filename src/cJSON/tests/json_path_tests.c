@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "unity/src/unity.h"
 #include "common.h"
@@ -319,6 +320,74 @@ static void book_store_test_11(void)
     cJSON_Delete(book_store);
 }
 
+static void assert_path(const cJSON * const document, const char * const path, const char * const expected)
+{
+    cJSON *items = cJSONUtils_GetPath(document, path);
+    char *actual = cJSON_PrintUnformatted(items);
+    TEST_ASSERT_NOT_NULL_MESSAGE(actual, "Failed to print items, items may be null");
+
+    TEST_ASSERT_EQUAL_STRING(expected, actual);
+
+    cJSON_free(actual);
+    cJSON_Delete(items);
+}
+
+static void assert_print_selector(const cJSON * const document, const char * const path, const cJSON_bool format)
+{
+    Selector *selector = cJSONUtils_CompileSelector(path);
+    cJSON *items = cJSONUtils_GetSelector(document, selector);
+    char *expected = cJSON_PrintBuffered(items, 256, format);
+    char *buffer = NULL;
+    size_t size = 0;
+
+    TEST_ASSERT_EQUAL_UINT(strlen(expected), cJSONUtils_PrintSelector(document, selector, &buffer, &size, 0, format));
+    TEST_ASSERT_EQUAL_STRING(expected, buffer);
+
+    cJSON_free(buffer);
+    cJSON_free(expected);
+    cJSON_Delete(items);
+    cJSONUtils_Delete_Selector(selector);
+}
+
+static void print_selector_tests(void)
+{
+    cJSON *book_store = parse_test_file("json-path-tests/book_store.json");
+
+    assert_print_selector(book_store, "$", false);
+    assert_print_selector(book_store, "$..book[*]", false);
+    assert_print_selector(book_store, "$..book[*]", true);
+    assert_print_selector(book_store, "$..price", false);
+    assert_print_selector(book_store, "$.store.book[?(@.price < 10)].title", false);
+    assert_print_selector(book_store, "$.nothing", false);
+    TEST_ASSERT_EQUAL_UINT(0, cJSONUtils_PrintSelector(book_store, NULL, NULL, NULL, 0, false));
+
+    cJSON_Delete(book_store);
+}
+
+static void path_nodes_tests(void)
+{
+    cJSON *document = cJSON_Parse("{\"a\":{\"x\":1,\"b\":[{\"x\":2},{\"y\":3}]},\"c\":{\"x\":4}}");
+    cJSON *references = NULL;
+    TEST_ASSERT_NOT_NULL(document);
+
+    /* the descendants of a member don't reach into its siblings */
+    assert_path(document, "$.a..x", "[2,1]");
+    assert_path(document, "$..x", "[2,1,4]");
+    assert_path(document, "$.a.b[?(@.x && @.x > 1)]", "[{\"x\":2}]");
+    assert_path(document, "$.a.b[?(@.x || @.y)]", "[{\"y\":3},{\"x\":2}]");
+    assert_path(document, "$.a.b[?(@.x > $.a.x)]", "[{\"x\":2}]");
+    assert_path(document, "$.a.b[?(@.x > $.a)]", "[]");
+    assert_path(document, "$.*[1]", "[]");
+
+    references = cJSONUtils_GetPathReference(document, "$.*.x");
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetArraySize(references));
+    TEST_ASSERT_TRUE(cJSON_GetArrayItem(references, 0)->child == cJSON_GetObjectItem(cJSON_GetObjectItem(document, "a"), "x"));
+    TEST_ASSERT_TRUE(cJSON_GetArrayItem(references, 1)->child == cJSON_GetObjectItem(cJSON_GetObjectItem(document, "c"), "x"));
+    cJSON_Delete(references);
+
+    cJSON_Delete(document);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -334,6 +403,8 @@ int main(void)
     RUN_TEST(book_store_test_9);
     RUN_TEST(book_store_test_10);
     RUN_TEST(book_store_test_11);
+    RUN_TEST(path_nodes_tests);
+    RUN_TEST(print_selector_tests);
 
     RUN_TEST(cts_tests);
     
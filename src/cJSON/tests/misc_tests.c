@@ -78,15 +78,15 @@ static void cjson_get_object_item_should_get_object_items(void)
 
     found = cJSON_GetObjectItem(item, "one");
     TEST_ASSERT_NOT_NULL_MESSAGE(found, "Failed to find first item.");
-    TEST_ASSERT_EQUAL_DOUBLE(found->valuedouble, 1);
+    TEST_ASSERT_EQUAL_DOUBLE(cJSON_GetNumberValue(found), 1);
 
     found = cJSON_GetObjectItem(item, "tWo");
     TEST_ASSERT_NOT_NULL_MESSAGE(found, "Failed to find first item.");
-    TEST_ASSERT_EQUAL_DOUBLE(found->valuedouble, 2);
+    TEST_ASSERT_EQUAL_DOUBLE(cJSON_GetNumberValue(found), 2);
 
     found = cJSON_GetObjectItem(item, "three");
     TEST_ASSERT_NOT_NULL_MESSAGE(found, "Failed to find item.");
-    TEST_ASSERT_EQUAL_DOUBLE(found->valuedouble, 3);
+    TEST_ASSERT_EQUAL_DOUBLE(cJSON_GetNumberValue(found), 3);
 
     found = cJSON_GetObjectItem(item, "four");
     TEST_ASSERT_NULL_MESSAGE(found, "Should not find something that isn't there.");
@@ -109,15 +109,15 @@ static void cjson_get_object_item_case_sensitive_should_get_object_items(void)
 
     found = cJSON_GetObjectItemCaseSensitive(item, "one");
     TEST_ASSERT_NOT_NULL_MESSAGE(found, "Failed to find first item.");
-    TEST_ASSERT_EQUAL_DOUBLE(found->valuedouble, 1);
+    TEST_ASSERT_EQUAL_DOUBLE(cJSON_GetNumberValue(found), 1);
 
     found = cJSON_GetObjectItemCaseSensitive(item, "Two");
     TEST_ASSERT_NOT_NULL_MESSAGE(found, "Failed to find first item.");
-    TEST_ASSERT_EQUAL_DOUBLE(found->valuedouble, 2);
+    TEST_ASSERT_EQUAL_DOUBLE(cJSON_GetNumberValue(found), 2);
 
     found = cJSON_GetObjectItemCaseSensitive(item, "tHree");
     TEST_ASSERT_NOT_NULL_MESSAGE(found, "Failed to find item.");
-    TEST_ASSERT_EQUAL_DOUBLE(found->valuedouble, 3);
+    TEST_ASSERT_EQUAL_DOUBLE(cJSON_GetNumberValue(found), 3);
 
     found = cJSON_GetObjectItemCaseSensitive(item, "One");
     TEST_ASSERT_NULL_MESSAGE(found, "Should not find something that isn't there.");
@@ -221,7 +221,7 @@ static void cjson_should_not_parse_to_deeply_nested_jsons(void)
 
 static void cjson_set_number_value_should_set_numbers(void)
 {
-    cJSON number[1] = {{NULL, NULL, NULL, cJSON_Number, NULL, 0, 0, NULL}};
+    cJSON number[1] = {{NULL, NULL, {NULL}, NULL, cJSON_Number, 0}};
 
     cJSON_SetNumberValue(number, 1.5);
     TEST_ASSERT_EQUAL(1, number->valueint);
@@ -240,12 +240,33 @@ static void cjson_set_number_value_should_set_numbers(void)
     TEST_ASSERT_EQUAL_DOUBLE(-1 + (double)INT_MIN, number->valuedouble);
 }
 
+static void cjson_set_number_value_should_not_touch_other_types(void)
+{
+    const int numbers[] = {1, 2};
+    cJSON *string = cJSON_CreateString("abc");
+    cJSON *array = cJSON_CreateIntArray(numbers, 2);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, cJSON_SetNumberValue(string, 1.5));
+    TEST_ASSERT_EQUAL(3, cJSON_SetIntValue(string, 3));
+    TEST_ASSERT_EQUAL(4, cJSON_SetInt64Value(array, 4));
+    TEST_ASSERT_EQUAL_DOUBLE(5, cJSON_SetNumberValue(array, 5));
+    TEST_ASSERT_TRUE(cJSON_IsString(string));
+    TEST_ASSERT_EQUAL_STRING("abc", string->valuestring);
+    TEST_ASSERT_TRUE(cJSON_IsArray(array));
+    TEST_ASSERT_EQUAL(2, cJSON_GetArraySize(array));
+    TEST_ASSERT_EQUAL(2, cJSON_GetArrayItem(array, 1)->valueint);
+
+    cJSON_Delete(string);
+    cJSON_Delete(array);
+}
+
 static void cjson_detach_item_via_pointer_should_detach_items(void)
 {
     cJSON list[4];
     cJSON parent[1];
 
     memset(list, '\0', sizeof(list));
+    memset(parent, '\0', sizeof(parent));
 
     /* link the list */
     list[0].next = &(list[1]);
@@ -328,7 +349,7 @@ static void cjson_replace_item_via_pointer_should_replace_items(void)
 
 static void cjson_replace_item_in_object_should_preserve_name(void)
 {
-    cJSON root[1] = {{NULL, NULL, NULL, 0, NULL, 0, 0, NULL}};
+    cJSON root[1] = {{NULL, NULL, {NULL}, NULL, cJSON_Object, 0}};
     cJSON *child = NULL;
     cJSON *replacement = NULL;
     cJSON_bool flag = false;
@@ -351,6 +372,8 @@ static void cjson_replace_item_in_object_should_preserve_name(void)
 static void cjson_functions_should_not_crash_with_null_pointers(void)
 {
     char buffer[10];
+    char *printed = NULL;
+    size_t size = 0;
     cJSON *item = cJSON_CreateString("item");
     cJSON *array = cJSON_CreateArray();
     cJSON *item1 = cJSON_CreateString("item1");
@@ -374,6 +397,9 @@ static void cjson_functions_should_not_crash_with_null_pointers(void)
     TEST_ASSERT_NULL(cJSON_PrintBuffered(NULL, 10, true));
     TEST_ASSERT_FALSE(cJSON_PrintPreallocated(NULL, buffer, sizeof(buffer), true));
     TEST_ASSERT_FALSE(cJSON_PrintPreallocated(item, NULL, 1, true));
+    TEST_ASSERT_EQUAL_UINT(0, cJSON_PrintToBuffer(NULL, &printed, &size, 0, true));
+    TEST_ASSERT_EQUAL_UINT(0, cJSON_PrintToBuffer(item, NULL, &size, 0, true));
+    TEST_ASSERT_EQUAL_UINT(0, cJSON_PrintToBuffer(item, &printed, NULL, 0, true));
     cJSON_Delete(NULL);
     cJSON_GetArraySize(NULL);
     TEST_ASSERT_NULL(cJSON_GetArrayItem(NULL, 0));
@@ -415,6 +441,7 @@ static void cjson_functions_should_not_crash_with_null_pointers(void)
     TEST_ASSERT_NULL(cJSON_DetachItemViaPointer(NULL, item));
     TEST_ASSERT_NULL(cJSON_DetachItemViaPointer(item, NULL));
     TEST_ASSERT_NULL(cJSON_DetachItemFromArray(NULL, 0));
+    TEST_ASSERT_NULL(cJSON_DetachItemsFromArray(NULL, 0, 1));
     cJSON_DeleteItemFromArray(NULL, 0);
     TEST_ASSERT_NULL(cJSON_DetachItemFromObject(NULL, "item"));
     TEST_ASSERT_NULL(cJSON_DetachItemFromObject(item, NULL));
@@ -428,6 +455,8 @@ static void cjson_functions_should_not_crash_with_null_pointers(void)
     TEST_ASSERT_FALSE(cJSON_InsertItemInArray(array, 1, item));
     TEST_ASSERT_FALSE(cJSON_InsertItemInArray(NULL, 0, item));
     TEST_ASSERT_FALSE(cJSON_InsertItemInArray(item, 0, NULL));
+    TEST_ASSERT_FALSE(cJSON_InsertItemsInArray(NULL, 0, item));
+    TEST_ASSERT_FALSE(cJSON_InsertItemsInArray(array, 0, NULL));
     TEST_ASSERT_FALSE(cJSON_ReplaceItemViaPointer(NULL, item, item));
     TEST_ASSERT_FALSE(cJSON_ReplaceItemViaPointer(item, NULL, item));
     TEST_ASSERT_FALSE(cJSON_ReplaceItemViaPointer(item, item, NULL));
@@ -446,8 +475,7 @@ static void cjson_functions_should_not_crash_with_null_pointers(void)
     TEST_ASSERT_NULL(cJSON_SetValuestring(corruptedString, "test"));
     TEST_ASSERT_NULL(cJSON_SetValuestring(item, NULL));
     cJSON_Minify(NULL);
-    /* skipped because it is only used via a macro that checks for NULL */
-    /* cJSON_SetNumberHelper(NULL, 0); */
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, cJSON_SetNumberHelper(NULL, 1.5));
 
     /* restore corrupted item2 to delete it */
     item2->prev = originalPrev;
@@ -472,6 +500,65 @@ static void ensure_should_fail_on_failed_realloc(void)
     TEST_ASSERT_NULL_MESSAGE(ensure(&buffer, 200), "Ensure didn't fail with failing realloc.");
 }
 
+static void print_to_buffer_should_reuse_the_buffer(void)
+{
+    cJSON *small = cJSON_Parse("{\"a\":[1,2,\"x\"]}");
+    cJSON *large = cJSON_CreateArray();
+    char *buffer = NULL;
+    char *kept = NULL;
+    size_t size = 0;
+    int i = 0;
+
+    TEST_ASSERT_EQUAL_UINT(15, cJSON_PrintToBuffer(small, &buffer, &size, 0, false));
+    TEST_ASSERT_EQUAL_STRING("{\"a\":[1,2,\"x\"]}", buffer);
+    kept = buffer;
+    TEST_ASSERT_EQUAL_UINT(15, cJSON_PrintToBuffer(small, &buffer, &size, 0, false));
+    TEST_ASSERT_TRUE(buffer == kept);
+
+    for (i = 0; i < 1000; i++)
+    {
+        cJSON_AddItemToArray(large, cJSON_CreateNumber(i));
+    }
+    /* grown while printing */
+    TEST_ASSERT_EQUAL_UINT(3891, cJSON_PrintToBuffer(large, &buffer, &size, 0, false));
+    TEST_ASSERT_EQUAL_UINT(3891, strlen(buffer));
+    TEST_ASSERT_TRUE(size > 3891);
+    free(buffer);
+
+    /* sized up front from the hint */
+    buffer = NULL;
+    size = 0;
+    TEST_ASSERT_EQUAL_UINT(3891, cJSON_PrintToBuffer(large, &buffer, &size, 4000, false));
+    TEST_ASSERT_EQUAL_UINT(4001, size);
+    TEST_ASSERT_EQUAL_UINT(21, cJSON_PrintToBuffer(small, &buffer, &size, 0, true));
+    TEST_ASSERT_EQUAL_STRING("{\n\t\"a\":\t[1, 2, \"x\"]\n}", buffer);
+    free(buffer);
+
+    cJSON_Delete(small);
+    cJSON_Delete(large);
+}
+
+static void print_items_to_buffer_should_print_an_array(void)
+{
+    cJSON *object = cJSON_Parse("{\"a\":{\"b\":1},\"c\":\"x\"}");
+    const cJSON *items[2];
+    char *buffer = NULL;
+    size_t size = 0;
+
+    items[0] = cJSON_GetObjectItem(object, "c");
+    items[1] = cJSON_GetObjectItem(object, "a");
+    TEST_ASSERT_EQUAL_UINT(13, cJSON_PrintItemsToBuffer(items, 2, &buffer, &size, 0, false));
+    TEST_ASSERT_EQUAL_STRING("[\"x\",{\"b\":1}]", buffer);
+    TEST_ASSERT_EQUAL_UINT(20, cJSON_PrintItemsToBuffer(items, 2, &buffer, &size, 0, true));
+    TEST_ASSERT_EQUAL_STRING("[\"x\", {\n\t\t\"b\":\t1\n\t}]", buffer);
+    TEST_ASSERT_EQUAL_UINT(2, cJSON_PrintItemsToBuffer(NULL, 0, &buffer, &size, 0, false));
+    TEST_ASSERT_EQUAL_STRING("[]", buffer);
+    TEST_ASSERT_EQUAL_UINT(0, cJSON_PrintItemsToBuffer(NULL, 1, &buffer, &size, 0, false));
+    free(buffer);
+
+    cJSON_Delete(object);
+}
+
 static void skip_utf8_bom_should_skip_bom(void)
 {
     const unsigned char string[] = "\xEF\xBB\xBF{}";
@@ -605,6 +692,76 @@ static void cjson_add_item_to_object_should_not_use_after_free_when_string_is_al
     cJSON_Delete(object);
 }
 
+static void cjson_integers_should_stay_exact(void)
+{
+    cJSON *parsed = cJSON_Parse("[9007199254740993,9007199254740992,1.5]");
+    cJSON *copy = cJSON_Duplicate(parsed, true);
+    cJSON *big = cJSON_CreateInt64((cJSON_int64)9007199254740992.0 + 1);
+    char *printed = NULL;
+
+    TEST_ASSERT_TRUE(cJSON_Compare(parsed, copy, true));
+    TEST_ASSERT_TRUE(cJSON_Compare(parsed->child, big, true));
+    /* the doubles nearest to both are the same, the integers are not */
+    TEST_ASSERT_FALSE(cJSON_Compare(parsed->child, parsed->child->next, true));
+    TEST_ASSERT_EQUAL_DOUBLE(9007199254740992.0, cJSON_GetNumberValue(big));
+    TEST_ASSERT_EQUAL_INT(INT_MAX, big->valueint);
+
+    printed = cJSON_PrintUnformatted(copy);
+    TEST_ASSERT_EQUAL_STRING("[9007199254740993,9007199254740992,1.5]", printed);
+    free(printed);
+
+    /* setting a double drops the integer */
+    cJSON_SetNumberValue(big, 2.5);
+    TEST_ASSERT_BITS(cJSON_NumberIsInt, 0, big->type);
+    TEST_ASSERT_EQUAL_DOUBLE(2.5, cJSON_GetNumberValue(big));
+    cJSON_SetInt64Value(big, -3);
+    TEST_ASSERT_EQUAL_DOUBLE(-3, cJSON_GetNumberValue(big));
+    TEST_ASSERT_EQUAL_INT(-3, big->valueint);
+
+    cJSON_Delete(big);
+    cJSON_Delete(copy);
+    cJSON_Delete(parsed);
+}
+
+static void cjson_detach_and_insert_items_should_splice_ranges(void)
+{
+    cJSON *array = cJSON_Parse("[0,1,2,3,4,5,6,7,8,9]");
+    cJSON *run = NULL;
+    cJSON *tail = NULL;
+    char *printed = NULL;
+
+    run = cJSON_DetachItemsFromArray(array, 2, 3);
+    TEST_ASSERT_EQUAL_DOUBLE(2, cJSON_GetNumberValue(run));
+    TEST_ASSERT_EQUAL_DOUBLE(4, cJSON_GetNumberValue(run->prev));
+    TEST_ASSERT_NULL(run->prev->next);
+    printed = cJSON_PrintUnformatted(array);
+    TEST_ASSERT_EQUAL_STRING("[0,1,5,6,7,8,9]", printed);
+    free(printed);
+
+    /* a count past the end stops at the end */
+    tail = cJSON_DetachItemsFromArray(array, 5, 100);
+    TEST_ASSERT_EQUAL_DOUBLE(8, cJSON_GetNumberValue(tail));
+    TEST_ASSERT_EQUAL_PTR(array->child->prev->next, NULL);
+    TEST_ASSERT_EQUAL_DOUBLE(7, cJSON_GetNumberValue(array->child->prev));
+    TEST_ASSERT_NULL(cJSON_DetachItemsFromArray(array, 5, 1));
+    TEST_ASSERT_NULL(cJSON_DetachItemsFromArray(array, 0, 0));
+
+    TEST_ASSERT_TRUE(cJSON_InsertItemsInArray(array, 1, run));
+    TEST_ASSERT_TRUE(cJSON_InsertItemsInArray(array, 8, tail));
+    printed = cJSON_PrintUnformatted(array);
+    TEST_ASSERT_EQUAL_STRING("[0,2,3,4,1,5,6,7,8,9]", printed);
+    free(printed);
+
+    /* the whole array, then back in */
+    run = cJSON_DetachItemsFromArray(array, 0, 10);
+    TEST_ASSERT_NULL(array->child);
+    TEST_ASSERT_TRUE(cJSON_InsertItemsInArray(array, 0, run));
+    TEST_ASSERT_EQUAL_INT(10, cJSON_GetArraySize(array));
+    TEST_ASSERT_EQUAL_DOUBLE(9, cJSON_GetNumberValue(array->child->prev));
+
+    cJSON_Delete(array);
+}
+
 static void cjson_delete_item_from_array_should_not_broken_list_structure(void)
 {
     const char expected_json1[] = "{\"rd\":[{\"a\":\"123\"}]}";
@@ -749,6 +906,233 @@ static void deallocated_pointers_should_be_set_to_null(void)
 #endif
 }
 
+static void cjson_value_accessors_should_check_type(void)
+{
+    cJSON *number = cJSON_CreateNumber(1.5);
+    cJSON *string = cJSON_CreateString("item");
+    cJSON *array = cJSON_CreateArray();
+    cJSON *copy = NULL;
+
+    /* child, valuestring and valuedouble share storage */
+    TEST_ASSERT_TRUE(sizeof(cJSON) <= 3 * sizeof(void*) + sizeof(double) + 2 * sizeof(int));
+
+    TEST_ASSERT_NULL(cJSON_Child(number));
+    TEST_ASSERT_NULL(cJSON_ValueString(number));
+    TEST_ASSERT_NULL(cJSON_Child(string));
+    TEST_ASSERT_EQUAL_STRING("item", cJSON_ValueString(string));
+    TEST_ASSERT_NULL(cJSON_Child(array));
+    TEST_ASSERT_NULL(cJSON_ValueString(array));
+    TEST_ASSERT_EQUAL_INT(0, cJSON_GetArraySize(string));
+    TEST_ASSERT_FALSE(cJSON_AddItemToArray(number, string));
+
+    TEST_ASSERT_TRUE(cJSON_AddItemToArray(array, number));
+    TEST_ASSERT_TRUE(cJSON_AddItemToArray(array, string));
+    TEST_ASSERT_EQUAL_PTR(number, cJSON_Child(array));
+
+    copy = cJSON_Duplicate(array, false);
+    TEST_ASSERT_NULL(cJSON_Child(copy));
+    cJSON_Delete(copy);
+    copy = cJSON_Duplicate(number, false);
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, copy->valuedouble);
+    cJSON_Delete(copy);
+
+    cJSON_Delete(array);
+}
+
+static char shared_name[] = "name";
+
+static char * CJSON_CDECL intern_name(const char *key)
+{
+    return (strcmp(key, shared_name) == 0) ? shared_name : NULL;
+}
+
+static void cjson_intern_hook_should_share_member_names(void)
+{
+    cJSON *object = NULL;
+    cJSON *copy = NULL;
+
+    cJSON_InitInternHook(intern_name);
+    object = cJSON_Parse("{\"name\":\"a\",\"other\":1}");
+    TEST_ASSERT_NOT_NULL(object);
+    TEST_ASSERT_TRUE(cJSON_AddStringToObject(object, "name", "b") != NULL);
+    copy = cJSON_Duplicate(object, true);
+    cJSON_InitInternHook(NULL);
+
+    TEST_ASSERT_EQUAL_PTR(shared_name, object->child->string);
+    TEST_ASSERT_BITS(cJSON_StringIsConst, cJSON_StringIsConst, object->child->type);
+    TEST_ASSERT_TRUE(cJSON_IsString(object->child));
+    TEST_ASSERT_FALSE(object->child->next->type & cJSON_StringIsConst);
+    TEST_ASSERT_EQUAL_PTR(shared_name, object->child->prev->string);
+    TEST_ASSERT_EQUAL_PTR(shared_name, copy->child->string);
+    TEST_ASSERT_EQUAL_PTR(object->child, cJSON_GetObjectItemCaseSensitive(object, shared_name));
+
+    cJSON_Delete(copy);
+    cJSON_Delete(object);
+    TEST_ASSERT_EQUAL_STRING("name", shared_name);
+}
+
+static int index_builds = 0;
+static int index_finds = 0;
+static int index_ats = 0;
+static int index_links = 0;
+static int index_unlinks = 0;
+
+static cJSON_bool CJSON_CDECL index_build(cJSON *object)
+{
+    index_builds++;
+    object->type |= cJSON_IsIndexed;
+    return true;
+}
+
+static cJSON * CJSON_CDECL index_find(const cJSON *object, const char *name)
+{
+    cJSON *member = object->child;
+
+    index_finds++;
+    while ((member != NULL) && (strcmp(member->string, name) != 0))
+    {
+        member = member->next;
+    }
+    return member;
+}
+
+static cJSON * CJSON_CDECL index_at(const cJSON *array, size_t index)
+{
+    cJSON *member = array->child;
+
+    index_ats++;
+    while ((member != NULL) && (index-- > 0))
+    {
+        member = member->next;
+    }
+    return member;
+}
+
+static size_t CJSON_CDECL index_size(const cJSON *item)
+{
+    cJSON *member = item->child;
+    size_t size = 0;
+
+    while (member != NULL)
+    {
+        size++;
+        member = member->next;
+    }
+    return size;
+}
+
+static void CJSON_CDECL index_link(cJSON *object, cJSON *item)
+{
+    (void)object;
+    (void)item;
+    index_links++;
+}
+
+static void CJSON_CDECL index_unlink(cJSON *object, cJSON *item)
+{
+    (void)object;
+    (void)item;
+    index_unlinks++;
+}
+
+static void CJSON_CDECL index_drop(cJSON *object)
+{
+    object->type &= ~cJSON_IsIndexed;
+}
+
+static void cjson_index_hooks_should_follow_wide_objects(void)
+{
+    cJSON_IndexHooks hooks = { index_build, index_find, index_at, index_size, index_link, index_unlink, index_drop };
+    cJSON *object = cJSON_CreateObject();
+    cJSON *copy = NULL;
+    cJSON *references = NULL;
+    char name[16];
+    int i = 0;
+
+    cJSON_InitIndexHooks(&hooks);
+    for (i = 0; i < CJSON_INDEX_MIN_MEMBERS + 1; i++)
+    {
+        sprintf(name, "k%d", i);
+        cJSON_AddNumberToObject(object, name, i);
+    }
+    TEST_ASSERT_EQUAL_INT(0, index_builds);
+
+    /* a lookup walking far enough indexes the object */
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItemCaseSensitive(object, "k32"));
+    TEST_ASSERT_EQUAL_INT(1, index_builds);
+    TEST_ASSERT_TRUE(cJSON_IsObject(object));
+    TEST_ASSERT_BITS(cJSON_IsIndexed, cJSON_IsIndexed, object->type);
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItemCaseSensitive(object, "k1"));
+    TEST_ASSERT_EQUAL_INT(2, index_finds);
+
+    cJSON_AddNullToObject(object, "added");
+    TEST_ASSERT_EQUAL_INT(1, index_links);
+    cJSON_DeleteItemFromObjectCaseSensitive(object, "k0");
+    TEST_ASSERT_EQUAL_INT(1, index_unlinks);
+    cJSON_ReplaceItemInObjectCaseSensitive(object, "k1", cJSON_CreateTrue());
+    TEST_ASSERT_EQUAL_INT(2, index_links);
+    TEST_ASSERT_EQUAL_INT(2, index_unlinks);
+
+    /* copies are indexed on their own, references never */
+    copy = cJSON_Duplicate(object, true);
+    TEST_ASSERT_EQUAL_INT(2, index_builds);
+    references = cJSON_CreateArray();
+    cJSON_AddItemReferenceToArray(references, object);
+    TEST_ASSERT_FALSE(references->child->type & cJSON_IsIndexed);
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItemCaseSensitive(references->child, "k32"));
+    TEST_ASSERT_EQUAL_INT(2, index_builds);
+
+    cJSON_InitIndexHooks(NULL);
+    cJSON_Delete(references);
+    cJSON_Delete(copy);
+    cJSON_Delete(object);
+}
+
+static void cjson_index_hooks_should_follow_wide_arrays(void)
+{
+    cJSON_IndexHooks hooks = { index_build, index_find, index_at, index_size, index_link, index_unlink, index_drop };
+    cJSON *array = cJSON_CreateArray();
+    cJSON *parsed = NULL;
+    int i = 0;
+
+    index_builds = index_ats = index_links = index_unlinks = 0;
+    cJSON_InitIndexHooks(&hooks);
+    for (i = 0; i < CJSON_INDEX_MIN_MEMBERS; i++)
+    {
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(i));
+    }
+    TEST_ASSERT_EQUAL_INT(0, index_builds);
+
+    /* counting the members indexes a wide array, positions come from the index after that */
+    TEST_ASSERT_EQUAL_INT(CJSON_INDEX_MIN_MEMBERS, cJSON_GetArraySize(array));
+    TEST_ASSERT_EQUAL_INT(1, index_builds);
+    TEST_ASSERT_BITS(cJSON_IsIndexed, cJSON_IsIndexed, array->type);
+    TEST_ASSERT_EQUAL_DOUBLE(5, cJSON_GetNumberValue(cJSON_GetArrayItem(array, 5)));
+    TEST_ASSERT_EQUAL_INT(1, index_ats);
+    TEST_ASSERT_NULL(cJSON_GetArrayItem(array, -1));
+    TEST_ASSERT_EQUAL_INT(1, index_ats);
+
+    cJSON_AddItemToArray(array, cJSON_CreateNull());
+    TEST_ASSERT_EQUAL_INT(1, index_links);
+    cJSON_InsertItemInArray(array, 0, cJSON_CreateTrue());
+    TEST_ASSERT_EQUAL_INT(2, index_links);
+    cJSON_DeleteItemFromArray(array, 1);
+    TEST_ASSERT_EQUAL_INT(1, index_unlinks);
+    cJSON_ReplaceItemInArray(array, 1, cJSON_CreateFalse());
+    TEST_ASSERT_EQUAL_INT(3, index_links);
+    TEST_ASSERT_EQUAL_INT(2, index_unlinks);
+    TEST_ASSERT_EQUAL_INT(CJSON_INDEX_MIN_MEMBERS + 1, cJSON_GetArraySize(array));
+
+    /* wide arrays are indexed as they are parsed */
+    parsed = cJSON_Parse("[0,1,2,3,4,5,6,7,8,9,0,1,2,3,4,5,6,7,8,9,0,1,2,3,4,5,6,7,8,9,0,1,2,3,4,5,6,7,8,9]");
+    TEST_ASSERT_EQUAL_INT(2, index_builds);
+    TEST_ASSERT_BITS(cJSON_IsIndexed, cJSON_IsIndexed, parsed->type);
+
+    cJSON_InitIndexHooks(NULL);
+    cJSON_Delete(parsed);
+    cJSON_Delete(array);
+}
+
 int CJSON_CDECL main(void)
 {
     UNITY_BEGIN();
@@ -762,11 +1146,14 @@ int CJSON_CDECL main(void)
     RUN_TEST(typecheck_functions_should_check_type);
     RUN_TEST(cjson_should_not_parse_to_deeply_nested_jsons);
     RUN_TEST(cjson_set_number_value_should_set_numbers);
+    RUN_TEST(cjson_set_number_value_should_not_touch_other_types);
     RUN_TEST(cjson_detach_item_via_pointer_should_detach_items);
     RUN_TEST(cjson_replace_item_via_pointer_should_replace_items);
     RUN_TEST(cjson_replace_item_in_object_should_preserve_name);
     RUN_TEST(cjson_functions_should_not_crash_with_null_pointers);
     RUN_TEST(ensure_should_fail_on_failed_realloc);
+    RUN_TEST(print_to_buffer_should_reuse_the_buffer);
+    RUN_TEST(print_items_to_buffer_should_print_an_array);
     RUN_TEST(skip_utf8_bom_should_skip_bom);
     RUN_TEST(skip_utf8_bom_should_not_skip_bom_if_not_at_beginning);
     RUN_TEST(cjson_get_string_value_should_get_a_string);
@@ -777,9 +1164,15 @@ int CJSON_CDECL main(void)
     RUN_TEST(cjson_add_item_to_object_or_array_should_not_add_itself);
     RUN_TEST(cjson_add_item_to_object_should_not_use_after_free_when_string_is_aliased);
     RUN_TEST(cjson_delete_item_from_array_should_not_broken_list_structure);
+    RUN_TEST(cjson_detach_and_insert_items_should_splice_ranges);
+    RUN_TEST(cjson_integers_should_stay_exact);
     RUN_TEST(cjson_set_valuestring_to_object_should_not_leak_memory);
     RUN_TEST(cjson_set_bool_value_must_not_break_objects);
     RUN_TEST(deallocated_pointers_should_be_set_to_null);
+    RUN_TEST(cjson_value_accessors_should_check_type);
+    RUN_TEST(cjson_intern_hook_should_share_member_names);
+    RUN_TEST(cjson_index_hooks_should_follow_wide_objects);
+    RUN_TEST(cjson_index_hooks_should_follow_wide_arrays);
 
     return UNITY_END();
 }
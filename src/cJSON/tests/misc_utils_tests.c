@@ -32,6 +32,7 @@
 static void cjson_utils_functions_shouldnt_crash_with_null_pointers(void)
 {
     cJSON *item = cJSON_CreateString("item");
+    cJSONUtils_Location location;
     TEST_ASSERT_NOT_NULL(item);
 
     TEST_ASSERT_NULL(cJSONUtils_GetPointer(item, NULL));
@@ -66,15 +67,171 @@ static void cjson_utils_functions_shouldnt_crash_with_null_pointers(void)
     TEST_ASSERT_NULL(cJSONUtils_FindPointerFromObjectTo(NULL, item));
     cJSONUtils_SortObject(NULL);
     cJSONUtils_SortObjectCaseSensitive(NULL);
+    TEST_ASSERT_EQUAL_INT(9, cJSONUtils_LocateCaseSensitive(NULL, "", &location));
+    TEST_ASSERT_EQUAL_INT(9, cJSONUtils_LocateCaseSensitive(item, NULL, &location));
+    TEST_ASSERT_EQUAL_INT(9, cJSONUtils_LocateCaseSensitive(item, "", NULL));
+    TEST_ASSERT_EQUAL_INT(7, cJSONUtils_SetAtLocation(item, NULL, NULL));
+    TEST_ASSERT_NULL(cJSONUtils_DetachAtLocation(NULL));
 
     cJSON_Delete(item);
 }
 
+static void cjson_utils_add_patch_should_decode_escaped_keys(void)
+{
+    cJSON *object = cJSON_Parse("{\"a\":{}}");
+    cJSON *patches = cJSON_Parse("[{\"op\":\"add\",\"path\":\"/a/b~1c~0d\",\"value\":1},"
+                                 "{\"op\":\"add\",\"path\":\"/~0~1\",\"value\":2}]");
+    char *printed = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_ApplyPatchesCaseSensitive(object, patches));
+    printed = cJSON_PrintUnformatted(object);
+    TEST_ASSERT_EQUAL_STRING("{\"a\":{\"b/c~d\":1},\"~/\":2}", printed);
+    TEST_ASSERT_NOT_NULL(cJSONUtils_GetPointerCaseSensitive(object, "/a/b~1c~0d"));
+
+    cJSON_free(printed);
+    cJSON_Delete(patches);
+    cJSON_Delete(object);
+}
+
+static void assert_set_at_pointer(const char * const json, const char * const pointer, const char * const value, int status, const char * const expected)
+{
+    cJSON *object = cJSON_Parse(json);
+    cJSONUtils_Location location;
+    cJSONUtils_Pointer *compiled = NULL;
+    char *printed = NULL;
+    int located = cJSONUtils_LocateCaseSensitive(object, pointer, &location);
+
+    if (located == 0)
+    {
+        located = cJSONUtils_SetAtLocation(object, &location, cJSON_Parse(value));
+    }
+    TEST_ASSERT_EQUAL_INT(status, located);
+    printed = cJSON_PrintUnformatted(object);
+    TEST_ASSERT_EQUAL_STRING(expected, printed);
+
+    cJSON_free(printed);
+    cJSON_Delete(object);
+
+    /* a compiled pointer gives the same result */
+    object = cJSON_Parse(json);
+    compiled = cJSONUtils_CompilePointer(pointer);
+    TEST_ASSERT_NOT_NULL(compiled);
+    located = cJSONUtils_LocateCompiledPointer(object, compiled, &location);
+    if (located == 0)
+    {
+        located = cJSONUtils_SetAtLocation(object, &location, cJSON_Parse(value));
+    }
+    TEST_ASSERT_EQUAL_INT(status, located);
+    printed = cJSON_PrintUnformatted(object);
+    TEST_ASSERT_EQUAL_STRING(expected, printed);
+
+    cJSON_free(printed);
+    cJSON_free(compiled);
+    cJSON_Delete(object);
+}
+
+static void cjson_utils_set_at_location_should_move_the_value(void)
+{
+    assert_set_at_pointer("{\"a\":[1,2]}", "/b", "{\"c\":[3]}", 0, "{\"a\":[1,2],\"b\":{\"c\":[3]}}");
+    assert_set_at_pointer("{\"a\":[1,2],\"b\":0}", "/a", "true", 0, "{\"b\":0,\"a\":true}");
+    assert_set_at_pointer("{\"a\":[1,2]}", "/a/1", "\"x\"", 0, "{\"a\":[1,\"x\"]}");
+    assert_set_at_pointer("{\"a\":[1,2]}", "/a/2", "\"x\"", 0, "{\"a\":[1,2,\"x\"]}");
+    assert_set_at_pointer("{\"a\":[1,2]}", "/a/-", "null", 0, "{\"a\":[1,2,null]}");
+    assert_set_at_pointer("{\"a\":[1,2]}", "", "[3]", 0, "[3]");
+    assert_set_at_pointer("{}", "/a~1b~0", "1", 0, "{\"a/b~\":1}");
+    assert_set_at_pointer("{\"a/b\":0,\"c\":1}", "/a~1b", "2", 0, "{\"c\":1,\"a/b\":2}");
+    assert_set_at_pointer("{\"a\":[1,2]}", "/a/5", "1", 10, "{\"a\":[1,2]}");
+    assert_set_at_pointer("{\"a\":[1,2]}", "/a/x", "1", 11, "{\"a\":[1,2]}");
+    assert_set_at_pointer("{\"a\":[1,2]}", "/b/c", "1", 9, "{\"a\":[1,2]}");
+    assert_set_at_pointer("{\"a\":[1,2]}", "a", "1", 9, "{\"a\":[1,2]}");
+}
+
+static void cjson_utils_detach_at_location_should_detach_existing_items(void)
+{
+    cJSON *object = cJSON_Parse("{\"a\":[1,2],\"b\":3}");
+    cJSONUtils_Location location;
+    cJSON *detached = NULL;
+    char *printed = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_LocateCaseSensitive(object, "/a/0", &location));
+    detached = cJSONUtils_DetachAtLocation(&location);
+    TEST_ASSERT_EQUAL_DOUBLE(1, cJSON_GetNumberValue(detached));
+    cJSON_Delete(detached);
+
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_LocateCaseSensitive(object, "/c", &location));
+    TEST_ASSERT_NULL(location.item);
+    TEST_ASSERT_NULL(cJSONUtils_DetachAtLocation(&location));
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_LocateCaseSensitive(object, "", &location));
+    TEST_ASSERT_TRUE(location.item == object);
+    TEST_ASSERT_NULL(cJSONUtils_DetachAtLocation(&location));
+
+    printed = cJSON_PrintUnformatted(object);
+    TEST_ASSERT_EQUAL_STRING("{\"a\":[2],\"b\":3}", printed);
+
+    cJSON_free(printed);
+    cJSON_Delete(object);
+}
+
+static void assert_compiled_pointer(cJSON * const object, const char * const pointer)
+{
+    cJSONUtils_Pointer *compiled = cJSONUtils_CompilePointer(pointer);
+
+    TEST_ASSERT_NOT_NULL(compiled);
+    TEST_ASSERT_TRUE(cJSONUtils_GetPointerCaseSensitive(object, pointer) == cJSONUtils_GetCompiledPointer(object, compiled));
+
+    cJSON_free(compiled);
+}
+
+static void cjson_utils_compiled_pointer_should_match_get_pointer(void)
+{
+    cJSON *object = cJSON_Parse("{\"a\":[1,{\"b\":2}],\"c/d\":3,\"e~f\":4,\"~x\":5,\"\":6,\"7\":8}");
+    cJSONUtils_Pointer *compiled = NULL;
+    cJSONUtils_Location location;
+
+    assert_compiled_pointer(object, "");
+    assert_compiled_pointer(object, "/a");
+    assert_compiled_pointer(object, "/a/1/b");
+    assert_compiled_pointer(object, "/a/2");
+    assert_compiled_pointer(object, "/a/-");
+    assert_compiled_pointer(object, "/a/01");
+    assert_compiled_pointer(object, "/c~1d");
+    assert_compiled_pointer(object, "/e~0f");
+    assert_compiled_pointer(object, "/~x");
+    assert_compiled_pointer(object, "/");
+    assert_compiled_pointer(object, "/7");
+    assert_compiled_pointer(object, "/a/1/b/c");
+
+    compiled = cJSONUtils_CompilePointer("/a/1/b");
+    TEST_ASSERT_NOT_NULL(compiled);
+    TEST_ASSERT_EQUAL_UINT(3, compiled->count);
+    TEST_ASSERT_FALSE(compiled->relative);
+    TEST_ASSERT_TRUE(compiled->tokens[1].is_index);
+    TEST_ASSERT_EQUAL_UINT(1, compiled->tokens[1].index);
+    TEST_ASSERT_EQUAL_STRING("b", compiled->tokens[2].name);
+    cJSON_free(compiled);
+
+    compiled = cJSONUtils_CompilePointer("a/b");
+    TEST_ASSERT_NOT_NULL(compiled);
+    TEST_ASSERT_TRUE(compiled->relative);
+    TEST_ASSERT_EQUAL_INT(9, cJSONUtils_LocateCompiledPointer(object, compiled, &location));
+    cJSON_free(compiled);
+
+    TEST_ASSERT_NULL(cJSONUtils_CompilePointer(NULL));
+    TEST_ASSERT_NULL(cJSONUtils_GetCompiledPointer(object, NULL));
+    TEST_ASSERT_EQUAL_INT(9, cJSONUtils_LocateCompiledPointer(object, NULL, &location));
+
+    cJSON_Delete(object);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
 
     RUN_TEST(cjson_utils_functions_shouldnt_crash_with_null_pointers);
+    RUN_TEST(cjson_utils_add_patch_should_decode_escaped_keys);
+    RUN_TEST(cjson_utils_set_at_location_should_move_the_value);
+    RUN_TEST(cjson_utils_detach_at_location_should_detach_existing_items);
+    RUN_TEST(cjson_utils_compiled_pointer_should_match_get_pointer);
 
     return UNITY_END();
 }
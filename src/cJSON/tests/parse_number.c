@@ -52,7 +52,19 @@ static void assert_parse_number(const char *string, int integer, double real)
     TEST_ASSERT_TRUE(parse_number(item, &buffer));
     assert_is_number(item);
     TEST_ASSERT_EQUAL_INT(integer, item->valueint);
-    TEST_ASSERT_EQUAL_DOUBLE(real, item->valuedouble);
+    TEST_ASSERT_EQUAL_DOUBLE(real, cJSON_GetNumberValue(item));
+}
+
+static void assert_parse_int64(const char *string, cJSON_int64 integer)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    buffer.content = (const unsigned char*)string;
+    buffer.length = strlen(string) + sizeof("");
+
+    TEST_ASSERT_TRUE(parse_number(item, &buffer));
+    assert_is_number(item);
+    TEST_ASSERT_BITS(cJSON_NumberIsInt, cJSON_NumberIsInt, item->type);
+    TEST_ASSERT_TRUE(integer == item->valueint64);
 }
 
 static void parse_number_should_parse_zero(void)
@@ -96,6 +108,120 @@ static void parse_number_should_parse_negative_reals(void)
     assert_parse_number("-123e-128", 0, -123e-128);
 }
 
+static void parse_number_should_parse_int64_exactly(void)
+{
+    const cJSON_int64 two_to_the_53 = (cJSON_int64)9007199254740992.0;
+    const cJSON_int64 two_to_the_62 = (cJSON_int64)4611686018427387904.0;
+
+    assert_parse_int64("9007199254740993", two_to_the_53 + 1);
+    assert_parse_int64("-9007199254740993", -two_to_the_53 - 1);
+    assert_parse_int64("9223372036854775807", (two_to_the_62 - 1) * 2 + 1);
+    TEST_ASSERT_EQUAL_INT(INT_MAX, item->valueint);
+    assert_parse_int64("-9223372036854775808", -two_to_the_62 * 2);
+    TEST_ASSERT_EQUAL_INT(INT_MIN, item->valueint);
+}
+
+static void parse_number_should_parse_other_numbers_as_doubles(void)
+{
+    /* out of the 64 bit range, or not written as an integer */
+    assert_parse_number("9223372036854775808", INT_MAX, 9223372036854775808.0);
+    assert_parse_number("-9223372036854775809", INT_MIN, -9223372036854775809.0);
+    assert_parse_number("1.0", 1, 1.0);
+    assert_parse_number("1e3", 1000, 1000.0);
+    TEST_ASSERT_BITS(cJSON_NumberIsInt, 0, item->type);
+}
+
+/* the double strtod makes of the string, and the length it consumes */
+static void assert_parse_number_like_strtod(const char *string)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    char *end = NULL;
+    double expected = strtod(string, &end);
+    double parsed = 0;
+
+    buffer.content = (const unsigned char*)string;
+    buffer.length = strlen(string) + sizeof("");
+
+    TEST_ASSERT_TRUE_MESSAGE(parse_number(item, &buffer), string);
+    TEST_ASSERT_EQUAL_UINT_MESSAGE((size_t)(end - string), buffer.offset, string);
+    parsed = cJSON_GetNumberValue(item);
+    /* compare bits, so that -0.0 and 0.0 differ */
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&expected, &parsed, sizeof(double), string);
+}
+
+static void parse_number_should_round_correctly(void)
+{
+    /* smallest subnormal, halfway to it, largest double and the boundary of normals */
+    assert_parse_number_like_strtod("4.9406564584124654e-324");
+    assert_parse_number_like_strtod("2.4703282292062328e-324");
+    assert_parse_number_like_strtod("1.7976931348623157e308");
+    assert_parse_number_like_strtod("2.2250738585072011e-308");
+    assert_parse_number_like_strtod("2.2250738585072014e-308");
+    /* halfway between 1 and the next double, exactly, just below and just above */
+    assert_parse_number_like_strtod("1.00000000000000011102230246251565404236316680908203125");
+    assert_parse_number_like_strtod("1.00000000000000011102230246251565404236316680908203124");
+    assert_parse_number_like_strtod("1.00000000000000011102230246251565404236316680908203126");
+    assert_parse_number_like_strtod("9007199254740993.0");
+    assert_parse_number_like_strtod("123456789012345678901234567890");
+    assert_parse_number_like_strtod("0.1");
+    assert_parse_number_like_strtod("-0.0");
+    assert_parse_number_like_strtod("1e-400");
+    assert_parse_number_like_strtod("0e999");
+}
+
+static void parse_number_should_stop_where_strtod_stops(void)
+{
+    assert_parse_number_like_strtod("1e");
+    assert_parse_number_like_strtod("1e+,");
+    assert_parse_number_like_strtod("5.");
+    assert_parse_number_like_strtod(".5");
+    assert_parse_number_like_strtod("+5");
+    assert_parse_number_like_strtod("1-2");
+    assert_parse_number_like_strtod("1.5.3");
+    /* unlike strtod, no hexadecimal */
+    assert_parse_number("0x10", 0, 0);
+}
+
+static void parse_number_should_match_strtod_on_random_numbers(void)
+{
+    unsigned long seed = 1;
+    char string[64];
+    int i = 0;
+
+    for (i = 0; i < 200000; i++)
+    {
+        unsigned long high = 0;
+        unsigned long low = 0;
+        double number = 0;
+
+        seed = seed * 1103515245UL + 12345UL;
+        high = (seed >> 4) & 0xFFFFFFUL;
+        seed = seed * 1103515245UL + 12345UL;
+        low = (seed >> 4) & 0xFFFFFFUL;
+
+        switch (i % 4)
+        {
+            case 0:
+                /* any double, at full and at reduced precision */
+                number = ldexp((double)high * 16777216.0 + (double)low, (int)(seed % 2000) - 1074);
+                sprintf(string, "%.17g", number);
+                assert_parse_number_like_strtod(string);
+                sprintf(string, "%.*g", (int)(low % 17) + 1, number);
+                break;
+            case 1:
+                sprintf(string, "%lu.%lue%d", high, low, (int)(seed % 700) - 350);
+                break;
+            case 2:
+                sprintf(string, "-%lu.%06lu", high % 100000, low % 1000000);
+                break;
+            default:
+                sprintf(string, "%lu%lu%lue-%lu", high, low, seed % 1000, (seed >> 8) % 40);
+                break;
+        }
+        assert_parse_number_like_strtod(string);
+    }
+}
+
 int CJSON_CDECL main(void)
 {
     /* initialize cJSON item */
@@ -106,5 +232,10 @@ int CJSON_CDECL main(void)
     RUN_TEST(parse_number_should_parse_positive_integers);
     RUN_TEST(parse_number_should_parse_positive_reals);
     RUN_TEST(parse_number_should_parse_negative_reals);
+    RUN_TEST(parse_number_should_parse_int64_exactly);
+    RUN_TEST(parse_number_should_parse_other_numbers_as_doubles);
+    RUN_TEST(parse_number_should_round_correctly);
+    RUN_TEST(parse_number_should_stop_where_strtod_stops);
+    RUN_TEST(parse_number_should_match_strtod_on_random_numbers);
     return UNITY_END();
 }
@@ -119,6 +119,36 @@ static void parse_string_should_parse_bug_94(void)
     reset(item);
 }
 
+static void parse_string_should_unescape_at_every_position(void)
+{
+    /* long enough for the 16 and 32 byte scanners and their scalar tails */
+    char string[80];
+    char expected[80];
+    size_t position = 0;
+
+    for (position = 0; position < 70; position++)
+    {
+        string[0] = '\"';
+        memset(string + 1, 'a', 71);
+        string[1 + position] = '\\';
+        string[2 + position] = '\"';
+        string[72] = '\"';
+        string[73] = '\0';
+
+        memset(expected, 'a', 70);
+        expected[position] = '\"';
+        expected[70] = '\0';
+
+        assert_parse_string(string, expected);
+    }
+    reset(item);
+
+    /* the closing quote or backslash right at the end of the input */
+    assert_not_parse_string("\"0123456789abcdef0123456789abcdef0123456789abcdef");
+    assert_not_parse_string("\"0123456789abcdef0123456789abcdef0123456789abcde\\");
+    reset(item);
+}
+
 int CJSON_CDECL main(void)
 {
     /* initialize cJSON item and error pointer */
@@ -131,5 +161,6 @@ int CJSON_CDECL main(void)
     RUN_TEST(parse_string_should_not_parse_invalid_backslash);
     RUN_TEST(parse_string_should_parse_bug_94);
     RUN_TEST(parse_string_should_not_overflow_with_closing_backslash);
+    RUN_TEST(parse_string_should_unescape_at_every_position);
     return UNITY_END();
 }
@@ -97,6 +97,132 @@ static void parse_with_opts_should_parse_utf8_bom(void)
     cJSON_Delete(without_bom);
 }
 
+static void assert_parse_large_like_parse_with_opts(const char * const json, size_t length, cJSON_bool require_null_terminated)
+{
+    const char *expected_end = NULL;
+    const char *expected_error = NULL;
+    const char *actual_end = NULL;
+    cJSON *expected = NULL;
+    cJSON *actual = NULL;
+
+    expected = cJSON_ParseWithLengthOpts(json, length, &expected_end, require_null_terminated);
+    expected_error = cJSON_GetErrorPtr();
+    actual = cJSON_ParseLargeWithLengthOpts(json, length, &actual_end, require_null_terminated);
+
+    TEST_ASSERT_EQUAL_PTR(expected_end, actual_end);
+    TEST_ASSERT_EQUAL_PTR(expected_error, cJSON_GetErrorPtr());
+    if (expected == NULL)
+    {
+        TEST_ASSERT_NULL(actual);
+    }
+    else
+    {
+        char *expected_printed = NULL;
+        char *actual_printed = NULL;
+
+        TEST_ASSERT_NOT_NULL(actual);
+        expected_printed = cJSON_PrintUnformatted(expected);
+        actual_printed = cJSON_PrintUnformatted(actual);
+        TEST_ASSERT_EQUAL_STRING(expected_printed, actual_printed);
+        cJSON_free(expected_printed);
+        cJSON_free(actual_printed);
+    }
+
+    cJSON_Delete(expected);
+    cJSON_Delete(actual);
+}
+
+static void parse_large_should_parse_like_parse_with_opts(void)
+{
+    static const char * const inputs[] = {
+        "",
+        "   ",
+        "{}",
+        "[]",
+        "null",
+        "  -12.5e3  ",
+        "\"string\"",
+        "\xEF\xBB\xBF{\"bom\": true}",
+        "[1, 2.5, -3e-2, true, false, null, \"four\", [], {}]",
+        "{\"name\": \"value\", \"escaped \\\"name\\\"\": \"tab\\there \\u00e9 \\ud83d\\ude00\", \"nested\": {\"array\": [[[]]]}}",
+        "{\"a\":1,\"a\":2}",
+        "[1, 2,]",
+        "[1 2]",
+        "{\"a\" 1}",
+        "{\"a\": }",
+        "{1: 2}",
+        "[truex]",
+        "[1x, 2]",
+        "[\"a\"\"b\"]",
+        "[\"unterminated]",
+        "[\"bad \\q escape\"]",
+        "[\"\\\\\", \"\\\\\\\"\"]",
+        "{} trailing",
+        "[{]",
+        "{]",
+        "[nul]",
+        "[-]"
+    };
+    char long_string[300];
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(inputs) / sizeof(inputs[0])); i++)
+    {
+        assert_parse_large_like_parse_with_opts(inputs[i], strlen(inputs[i]) + sizeof(""), false);
+        assert_parse_large_like_parse_with_opts(inputs[i], strlen(inputs[i]) + sizeof(""), true);
+        if (inputs[i][0] != '\0')
+        {
+            assert_parse_large_like_parse_with_opts(inputs[i], strlen(inputs[i]), false);
+        }
+    }
+
+    /* escapes and quotes on every side of the 64 byte blocks */
+    for (i = 0; (i + 2 + 8 + 3) <= sizeof(long_string); i++)
+    {
+        memset(long_string, ' ', sizeof(long_string));
+        memcpy(long_string, "[\"", 2);
+        memcpy(long_string + i + 2, "\\\\\\\"\", \"", 8);
+        memcpy(long_string + sizeof(long_string) - 3, "\"]", 3);
+        assert_parse_large_like_parse_with_opts(long_string, sizeof(long_string), true);
+    }
+}
+
+static void parse_large_should_parse_the_examples(void)
+{
+    static const char * const files[] = {
+        "inputs/test1", "inputs/test2", "inputs/test3", "inputs/test4", "inputs/test5", "inputs/test6",
+        "inputs/test7", "inputs/test8", "inputs/test9", "inputs/test10", "inputs/test11"
+    };
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(files) / sizeof(files[0])); i++)
+    {
+        char *content = read_file(files[i]);
+        TEST_ASSERT_NOT_NULL(content);
+        assert_parse_large_like_parse_with_opts(content, strlen(content) + sizeof(""), false);
+        free(content);
+    }
+}
+
+static void parse_large_should_limit_nesting(void)
+{
+    char json[(2 * (CJSON_NESTING_LIMIT + 1)) + 1];
+    cJSON *item = NULL;
+
+    memset(json, '[', CJSON_NESTING_LIMIT);
+    memset(json + CJSON_NESTING_LIMIT, ']', CJSON_NESTING_LIMIT);
+    json[2 * CJSON_NESTING_LIMIT] = '\0';
+    item = cJSON_ParseLargeWithLengthOpts(json, (2 * CJSON_NESTING_LIMIT) + 1, NULL, true);
+    TEST_ASSERT_NOT_NULL(item);
+    cJSON_Delete(item);
+
+    memset(json, '[', CJSON_NESTING_LIMIT + 1);
+    memset(json + CJSON_NESTING_LIMIT + 1, ']', CJSON_NESTING_LIMIT + 1);
+    json[2 * (CJSON_NESTING_LIMIT + 1)] = '\0';
+    assert_parse_large_like_parse_with_opts(json, sizeof(json), true);
+    TEST_ASSERT_NULL(cJSON_ParseLargeWithLengthOpts(json, sizeof(json), NULL, true));
+}
+
 int CJSON_CDECL main(void)
 {
     UNITY_BEGIN();
@@ -107,6 +233,9 @@ int CJSON_CDECL main(void)
     RUN_TEST(parse_with_opts_should_require_null_if_requested);
     RUN_TEST(parse_with_opts_should_return_parse_end);
     RUN_TEST(parse_with_opts_should_parse_utf8_bom);
+    RUN_TEST(parse_large_should_parse_like_parse_with_opts);
+    RUN_TEST(parse_large_should_parse_the_examples);
+    RUN_TEST(parse_large_should_limit_nesting);
 
     return UNITY_END();
 }
@@ -40,6 +40,7 @@ static void assert_print_number(const char *expected, double input)
 
     memset(item, 0, sizeof(item));
     memset(new_buffer, 0, sizeof(new_buffer));
+    item->type = cJSON_Number;
     cJSON_SetNumberValue(item, input);
     TEST_ASSERT_TRUE_MESSAGE(print_number(item, &buffer), "Failed to print number.");
     
@@ -88,7 +89,15 @@ static void print_number_should_print_positive_reals(void)
     assert_print_number("1000000000000", 10e11);
     assert_print_number("1.23e+129", 123e+127);
     assert_print_number("1.23e-126", 123e-128);
-    assert_print_number("3.1415926535897931", 3.1415926535897931);
+    assert_print_number("3.141592653589793", 3.1415926535897931);
+    assert_print_number("0.1", 0.1);
+    assert_print_number("0.30000000000000004", 0.1 + 0.2);
+    assert_print_number("79.810454", 79.810454);
+    assert_print_number("1e+15", 1e15);
+    assert_print_number("123456789012345.6", 123456789012345.6);
+    assert_print_number("0.0001", 1e-4);
+    assert_print_number("1.7976931348623157e+308", 1.7976931348623157e308);
+    assert_print_number("5e-324", 4.9406564584124654e-324);
 }
 
 static void print_number_should_print_negative_reals(void)
@@ -100,6 +109,36 @@ static void print_number_should_print_negative_reals(void)
     assert_print_number("-1.23e-126", -123e-128);
 }
 
+static void assert_print_int64(const char *expected, cJSON_int64 input)
+{
+    unsigned char printed[26];
+    cJSON item[1];
+    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    buffer.buffer = printed;
+    buffer.length = sizeof(printed);
+    buffer.offset = 0;
+    buffer.noalloc = true;
+    buffer.hooks = global_hooks;
+
+    memset(item, 0, sizeof(item));
+    memset(printed, 0, sizeof(printed));
+    item->type = cJSON_Number;
+    cJSON_SetInt64Value(item, input);
+    TEST_ASSERT_TRUE_MESSAGE(print_number(item, &buffer), "Failed to print number.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, buffer.buffer, "Printed number is not as expected.");
+}
+
+static void print_number_should_print_int64_exactly(void)
+{
+    const cJSON_int64 two_to_the_62 = (cJSON_int64)4611686018427387904.0;
+
+    assert_print_int64("0", 0);
+    assert_print_int64("-42", -42);
+    assert_print_int64("9007199254740993", (cJSON_int64)9007199254740992.0 + 1);
+    assert_print_int64("9223372036854775807", (two_to_the_62 - 1) * 2 + 1);
+    assert_print_int64("-9223372036854775808", -two_to_the_62 * 2);
+}
+
 static void print_number_should_print_non_number(void)
 {
     TEST_IGNORE();
@@ -119,6 +158,7 @@ int CJSON_CDECL main(void)
     RUN_TEST(print_number_should_print_positive_integers);
     RUN_TEST(print_number_should_print_positive_reals);
     RUN_TEST(print_number_should_print_negative_reals);
+    RUN_TEST(print_number_should_print_int64_exactly);
     RUN_TEST(print_number_should_print_non_number);
 
     return UNITY_END();
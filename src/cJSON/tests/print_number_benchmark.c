@@ -0,0 +1,145 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* Microbenchmark of print_number against the former sprintf/sscanf rendering.
+ * Not part of the test suite, run it by hand:
+ *
+ *     ./print_number_benchmark [count] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common.h"
+
+/* the rendering print_number used before it had print_double */
+static int legacy_print_double(unsigned char *buffer, double d)
+{
+    unsigned char decimal_point = get_decimal_point();
+    double test = 0.0;
+    int length = sprintf((char*)buffer, "%1.15g", d);
+    int i = 0;
+
+    if ((sscanf((char*)buffer, "%lg", &test) != 1) || !compare_double(test, d))
+    {
+        length = sprintf((char*)buffer, "%1.17g", d);
+    }
+    for (i = 0; i < length; i++)
+    {
+        if (buffer[i] == decimal_point)
+        {
+            buffer[i] = '.';
+        }
+    }
+
+    return length;
+}
+
+static double seconds_since(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    size_t count = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 10) : 100000;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 20;
+    double *numbers = NULL;
+    unsigned char printed[32];
+    unsigned char buffer_space[32];
+    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    cJSON item[1];
+    unsigned long seed = 42;
+    size_t checksum = 0;
+    double legacy = 0;
+    double current = 0;
+    clock_t start;
+    size_t i = 0;
+    int round = 0;
+
+    numbers = (double*)malloc(count * sizeof(double));
+    if ((numbers == NULL) || (count == 0) || (rounds <= 0))
+    {
+        free(numbers);
+        return EXIT_FAILURE;
+    }
+
+    /* prices, measurements and full precision ratios, as found in documents */
+    for (i = 0; i < count; i++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        switch (i % 3)
+        {
+            case 0:
+                numbers[i] = (double)(seed % 1000000) / 100.0;
+                break;
+            case 1:
+                numbers[i] = (double)(seed % 100000000) / 1e6 - 50.0;
+                break;
+            default:
+                numbers[i] = (double)(seed % 1000003) / 7.0 + 0.5;
+                break;
+        }
+    }
+
+    start = clock();
+    for (round = 0; round < rounds; round++)
+    {
+        for (i = 0; i < count; i++)
+        {
+            checksum += (size_t)legacy_print_double(printed, numbers[i]);
+        }
+    }
+    legacy = seconds_since(start);
+
+    memset(item, 0, sizeof(item));
+    item->type = cJSON_Number;
+    buffer.buffer = buffer_space;
+    buffer.length = sizeof(buffer_space);
+    buffer.noalloc = true;
+    buffer.hooks = global_hooks;
+    start = clock();
+    for (round = 0; round < rounds; round++)
+    {
+        for (i = 0; i < count; i++)
+        {
+            cJSON_SetNumberValue(item, numbers[i]);
+            buffer.offset = 0;
+            if (!print_number(item, &buffer))
+            {
+                free(numbers);
+                return EXIT_FAILURE;
+            }
+            checksum += buffer.offset;
+        }
+    }
+    current = seconds_since(start);
+
+    printf("%lu numbers x %d rounds (checksum %lu)\n", (unsigned long)count, rounds, (unsigned long)checksum);
+    printf("sprintf/sscanf: %8.1f ns per number\n", legacy * 1e9 / ((double)count * rounds));
+    printf("print_number:   %8.1f ns per number\n", current * 1e9 / ((double)count * rounds));
+
+    free(numbers);
+    return EXIT_SUCCESS;
+}
@@ -65,6 +65,29 @@ static void print_string_should_print_utf8(void)
     assert_print_string("\"ü猫慕\"", "ü猫慕");
 }
 
+static void print_string_should_escape_at_every_position(void)
+{
+    /* long enough for the 16 and 32 byte scanners and their scalar tails */
+    char input[80];
+    char expected[90];
+    size_t position = 0;
+
+    for (position = 0; position < 70; position++)
+    {
+        memset(input, 'a', 70);
+        input[70] = '\0';
+        input[position] = '\x1f';
+
+        expected[0] = '\"';
+        memset(expected + 1, 'a', 75);
+        memcpy(expected + 1 + position, "\\u001f", 6);
+        expected[76] = '\"';
+        expected[77] = '\0';
+
+        assert_print_string(expected, input);
+    }
+}
+
 int CJSON_CDECL main(void)
 {
     /* initialize cJSON item */
@@ -73,6 +96,7 @@ int CJSON_CDECL main(void)
     RUN_TEST(print_string_should_print_empty_strings);
     RUN_TEST(print_string_should_print_ascii);
     RUN_TEST(print_string_should_print_utf8);
+    RUN_TEST(print_string_should_escape_at_every_position);
 
     return UNITY_END();
 }
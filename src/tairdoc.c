@@ -8,9 +8,12 @@
 #include <math.h>
 #include <ctype.h>
 #include <assert.h>
+#include <stdint.h>
+#include <limits.h>
+#include <pthread.h>
 
 static ValkeyModuleType *TairDocType;
-#define TAIRDOC_ENC_VER 0
+#define TAIRDOC_ENC_VER 2
 
 void debugPrint(ValkeyModuleCtx *ctx, char *name, cJSON *root) {
     VALKEYMODULE_NOT_USED(ctx);
@@ -19,23 +22,1090 @@ void debugPrint(ValkeyModuleCtx *ctx, char *name, cJSON *root) {
 #ifdef JSON_DEBUG
     char *print = cJSON_Print(root);
     ValkeyModule_Log(ctx, "notice", "%s : %s", name, print);
-    ValkeyModule_Free(print);
+    cJSON_free(print);
 #endif
 }
 
+/* ========================== TairDoc arena ======================= */
+
+/*
+ * Documents built in one go from a large input (a JSON.SET creating the key,
+ * an RDB load) get an arena instead of one allocation per node and string.
+ *
+ * Blocks up to TAIRDOC_ARENA_MAX_SLOT bytes are slots carved out of slabs,
+ * each slab serving one 8 byte size class: building the tree is a bump of the
+ * current slab of the class, and a freed slot goes to the free list of its
+ * class for the next allocation of the same size. Larger blocks are allocated
+ * one by one behind a header that links them to the arena. Freeing the
+ * document is one free per slab and per large block, without walking the
+ * tree, see releaseTairDocObj().
+ *
+ * Slabs are only returned with the document, a document that shrinks keeps
+ * its slots for later writes. Small documents would mostly pay for the slack
+ * of a slab per size class and keep using plain allocations.
+ *
+ * A block is found to be a slot by looking up its slab, so a block owned by
+ * the document must be allocated and freed while it is the charged document,
+ * which the memory accounting below already relies on.
+ */
+#define TAIRDOC_ARENA_MIN_INPUT (4 * 1024)   /* smaller inputs get no arena */
+#define TAIRDOC_ARENA_MAX_SLOT 256
+#define TAIRDOC_ARENA_CLASSES (TAIRDOC_ARENA_MAX_SLOT / 8)
+#define TAIRDOC_ARENA_MIN_SLOTS 16           /* slots in the first slab of a class */
+#define TAIRDOC_ARENA_MAX_SLAB (256 * 1024)
+
+typedef struct arenaSlab {
+    char *start;
+    char *end;
+    size_t slot;
+} arenaSlab;
+
+typedef struct arenaLarge {
+    struct arenaLarge *prev;
+    struct arenaLarge *next;
+} arenaLarge;
+
+typedef struct tairDocArena {
+    arenaSlab *slabs;       /* sorted by address */
+    size_t nslabs;
+    size_t cap;
+    arenaLarge *large;
+    struct {
+        char *pos;          /* bump range of the current slab */
+        char *end;
+        void *free;         /* freed slots, linked through their first word */
+        size_t next;        /* size of the next slab */
+    } cls[TAIRDOC_ARENA_CLASSES];
+} tairDocArena;
+
+static void arenaCharge(TairDocObj *doc, void *ptr) {
+    doc->memory += ValkeyModule_MallocSize(ptr);
+    doc->allocs++;
+}
+
+static void arenaDischarge(TairDocObj *doc, void *ptr) {
+    doc->memory -= ValkeyModule_MallocSize(ptr);
+    doc->allocs--;
+}
+
+static void arenaCreate(TairDocObj *doc) {
+    tairDocArena *arena = ValkeyModule_Calloc(1, sizeof(*arena));
+    for (int i = 0; i < TAIRDOC_ARENA_CLASSES; i++) {
+        arena->cls[i].next = (size_t) (i + 1) * 8 * TAIRDOC_ARENA_MIN_SLOTS;
+    }
+    arenaCharge(doc, arena);
+    doc->arena = arena;
+}
+
+/* Returns the slab ptr was carved from, NULL for a large block. */
+static arenaSlab *arenaFindSlab(tairDocArena *arena, const void *ptr) {
+    const char *p = ptr;
+    size_t lo = 0, hi = arena->nslabs;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (p < arena->slabs[mid].start) {
+            hi = mid;
+        } else if (p >= arena->slabs[mid].end) {
+            lo = mid + 1;
+        } else {
+            return &arena->slabs[mid];
+        }
+    }
+    return NULL;
+}
+
+static void arenaNewSlab(TairDocObj *doc, int c) {
+    tairDocArena *arena = doc->arena;
+    size_t size = arena->cls[c].next, i;
+    char *slab = ValkeyModule_Alloc(size);
+
+    arenaCharge(doc, slab);
+    if (arena->nslabs == arena->cap) {
+        if (arena->slabs) arenaDischarge(doc, arena->slabs);
+        arena->cap = arena->cap ? arena->cap * 2 : 16;
+        arena->slabs = ValkeyModule_Realloc(arena->slabs, sizeof(arenaSlab) * arena->cap);
+        arenaCharge(doc, arena->slabs);
+    }
+    for (i = arena->nslabs; i > 0 && arena->slabs[i - 1].start > slab; i--) {
+        arena->slabs[i] = arena->slabs[i - 1];
+    }
+    arena->slabs[i].start = slab;
+    arena->slabs[i].end = slab + size;
+    arena->slabs[i].slot = (size_t) (c + 1) * 8;
+    arena->nslabs++;
+
+    arena->cls[c].pos = slab;
+    arena->cls[c].end = slab + size;
+    if (size * 2 <= TAIRDOC_ARENA_MAX_SLAB) arena->cls[c].next = size * 2;
+}
+
+static void *arenaAlloc(TairDocObj *doc, size_t size) {
+    tairDocArena *arena = doc->arena;
+    void *ptr;
+
+    if (size > TAIRDOC_ARENA_MAX_SLOT) {
+        arenaLarge *large = ValkeyModule_Alloc(sizeof(*large) + size);
+        arenaCharge(doc, large);
+        large->prev = NULL;
+        large->next = arena->large;
+        if (large->next) large->next->prev = large;
+        arena->large = large;
+        return large + 1;
+    }
+
+    int c = size ? (int) ((size - 1) / 8) : 0;
+    if ((ptr = arena->cls[c].free) != NULL) {
+        arena->cls[c].free = *(void **) ptr;
+        return ptr;
+    }
+    if (arena->cls[c].pos == arena->cls[c].end) arenaNewSlab(doc, c);
+    ptr = arena->cls[c].pos;
+    arena->cls[c].pos += (size_t) (c + 1) * 8;
+    return ptr;
+}
+
+static void arenaFree(TairDocObj *doc, void *ptr) {
+    tairDocArena *arena = doc->arena;
+    arenaSlab *slab = arenaFindSlab(arena, ptr);
+
+    if (slab != NULL) {
+        int c = (int) (slab->slot / 8) - 1;
+        *(void **) ptr = arena->cls[c].free;
+        arena->cls[c].free = ptr;
+        return;
+    }
+
+    arenaLarge *large = (arenaLarge *) ptr - 1;
+    if (large->prev) {
+        large->prev->next = large->next;
+    } else {
+        arena->large = large->next;
+    }
+    if (large->next) large->next->prev = large->prev;
+    arenaDischarge(doc, large);
+    ValkeyModule_Free(large);
+}
+
+/* Puts a large block that has been moved by realloc or defrag back in place. */
+static void *arenaRelink(tairDocArena *arena, arenaLarge *large) {
+    if (large->prev) {
+        large->prev->next = large;
+    } else {
+        arena->large = large;
+    }
+    if (large->next) large->next->prev = large;
+    return large + 1;
+}
+
+static void *arenaRealloc(TairDocObj *doc, void *ptr, size_t size) {
+    arenaSlab *slab;
+    void *moved;
+
+    if (ptr == NULL) return arenaAlloc(doc, size);
+    if ((slab = arenaFindSlab(doc->arena, ptr)) != NULL) {
+        if (size <= slab->slot) return ptr;
+        moved = arenaAlloc(doc, size);
+        memcpy(moved, ptr, slab->slot);
+        arenaFree(doc, ptr);
+        return moved;
+    }
+
+    arenaLarge *large = (arenaLarge *) ptr - 1;
+    arenaDischarge(doc, large);
+    large = ValkeyModule_Realloc(large, sizeof(*large) + size);
+    arenaCharge(doc, large);
+    return arenaRelink(doc->arena, large);
+}
+
+/* Drops the arena with every block it holds. */
+static void arenaRelease(TairDocObj *doc) {
+    tairDocArena *arena = doc->arena;
+    arenaLarge *large, *next;
+
+    for (size_t i = 0; i < arena->nslabs; i++) ValkeyModule_Free(arena->slabs[i].start);
+    for (large = arena->large; large != NULL; large = next) {
+        next = large->next;
+        ValkeyModule_Free(large);
+    }
+    if (arena->slabs) ValkeyModule_Free(arena->slabs);
+    ValkeyModule_Free(arena);
+    doc->arena = NULL;
+    doc->memory = doc->allocs = 0;
+}
+
+/* ========================== TairDoc memory accounting ======================= */
+
+/*
+ * Every tair-json key keeps the number of bytes and allocations owned by its
+ * tree in TairDocObj, so that MEMORY USAGE, eviction and free_effort can be
+ * answered in O(1).
+ *
+ * The counter is maintained by the cJSON hooks below: a command that is about
+ * to change a document makes it the charged document, and every allocation
+ * and free done by cJSON until the charge is cleared is added to or subtracted
+ * from its counter. Temporary allocations (patches, printed strings) made and
+ * released inside such a window cancel out, whatever is left belongs to the
+ * document. Values parsed from command arguments before the window opens and
+ * freed after it closes are never counted. A document with an arena is
+ * charged for its slabs and large blocks instead, see arenaAlloc().
+ *
+ * Any change also drops a half done defrag walk of the document, see
+ * TairDocTypeDefrag().
+ *
+ * The charged document is per thread: documents released by the lazyfree
+ * thread go through the same hooks and must never touch the counters of
+ * whatever the main thread is working on.
+ */
+static __thread TairDocObj *chargedDoc = NULL;
+
+static void dropDefragState(TairDocObj *doc);
+
+static void *tairDocAlloc(size_t size) {
+    void *ptr;
+    if (chargedDoc == NULL) return ValkeyModule_Alloc(size);
+    if (chargedDoc->defrag) dropDefragState(chargedDoc);
+    if (chargedDoc->arena) return arenaAlloc(chargedDoc, size);
+    ptr = ValkeyModule_Alloc(size);
+    chargedDoc->memory += ValkeyModule_MallocSize(ptr);
+    chargedDoc->allocs++;
+    return ptr;
+}
+
+static void tairDocFree(void *ptr) {
+    if (ptr == NULL) return;
+    if (chargedDoc == NULL) {
+        ValkeyModule_Free(ptr);
+        return;
+    }
+    if (chargedDoc->defrag) dropDefragState(chargedDoc);
+    if (chargedDoc->arena) {
+        arenaFree(chargedDoc, ptr);
+        return;
+    }
+    chargedDoc->memory -= ValkeyModule_MallocSize(ptr);
+    chargedDoc->allocs--;
+    ValkeyModule_Free(ptr);
+}
+
+static void *tairDocRealloc(void *ptr, size_t size) {
+    size_t oldsize;
+    if (chargedDoc == NULL) return ValkeyModule_Realloc(ptr, size);
+    if (chargedDoc->defrag) dropDefragState(chargedDoc);
+    if (chargedDoc->arena) return arenaRealloc(chargedDoc, ptr, size);
+    oldsize = ptr ? ValkeyModule_MallocSize(ptr) : 0;
+    if (ptr == NULL) chargedDoc->allocs++;
+    ptr = ValkeyModule_Realloc(ptr, size);
+    chargedDoc->memory += ValkeyModule_MallocSize(ptr) - oldsize;
+    return ptr;
+}
+
+/* ========================== TairDoc shared keys ======================= */
+
+/*
+ * Object member names are kept once in a module wide table, and the nodes of
+ * every document using a name point to that copy, flagged cJSON_StringIsConst
+ * so cJSON never frees it. An array of a million records, or a million small
+ * documents, with the same handful of field names store those names once.
+ *
+ * Nodes don't count references: a document takes one reference to a name the
+ * first time one of its nodes uses it and gives them all back when it is
+ * freed, so an arena is still dropped without walking the tree. A name that
+ * is deleted from a document stays referenced until the document goes away.
+ *
+ * Only names of up to TAIRDOC_KEY_MAX_LEN bytes, and the first
+ * TAIRDOC_KEYS_PER_DOC names of a document, are shared. Documents keyed by
+ * ids copy their names into the nodes as before instead of filling the table.
+ * Names are only shared while a document is charged, values parsed from
+ * command arguments keep their own copies.
+ *
+ * The table is locked, documents are also freed by the lazyfree thread. The
+ * names a document holds are looked up without the lock, in a small open
+ * addressing set charged to the document.
+ */
+#define TAIRDOC_KEY_MAX_LEN 64
+#define TAIRDOC_KEYS_PER_DOC 1024
+#define TAIRDOC_KEYS_MIN_SIZE 16
+
+typedef struct sharedKey {
+    struct sharedKey *next;  /* next name in the same bucket */
+    uint64_t hash;
+    size_t refs;             /* documents holding the name */
+    size_t len;
+    char str[];
+} sharedKey;
+
+static struct {
+    pthread_mutex_t lock;
+    sharedKey **buckets;
+    size_t size;             /* power of two, 0 before the first name */
+    size_t count;
+} sharedKeys = {PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0};
+
+typedef struct tairDocKeys {
+    size_t size;             /* power of two, at most 3/4 full */
+    size_t count;
+    sharedKey *slots[];
+} tairDocKeys;
+
+static uint64_t sharedKeyHash(const char *key, size_t len) {
+    uint64_t hash = 14695981039346656037ULL; /* FNV-1a */
+    while (len--) hash = (hash ^ (unsigned char) *key++) * 1099511628211ULL;
+    return hash;
+}
+
+static int sharedKeyIs(const sharedKey *sk, const char *key, size_t len, uint64_t hash) {
+    return sk->hash == hash && sk->len == len && memcmp(sk->str, key, len) == 0;
+}
+
+/* Doubles the buckets of the table, the lock must be held. */
+static void sharedKeysGrow(void) {
+    size_t size = sharedKeys.size ? sharedKeys.size * 2 : 1024, i;
+    sharedKey **buckets = ValkeyModule_Calloc(size, sizeof(*buckets)), *sk;
+
+    for (i = 0; i < sharedKeys.size; i++) {
+        while ((sk = sharedKeys.buckets[i]) != NULL) {
+            sharedKeys.buckets[i] = sk->next;
+            sk->next = buckets[sk->hash & (size - 1)];
+            buckets[sk->hash & (size - 1)] = sk;
+        }
+    }
+    ValkeyModule_Free(sharedKeys.buckets);
+    sharedKeys.buckets = buckets;
+    sharedKeys.size = size;
+}
+
+/* Returns the shared copy of key, adding it if needed, with one more reference. */
+static sharedKey *sharedKeyRetain(const char *key, size_t len, uint64_t hash) {
+    sharedKey *sk;
+
+    pthread_mutex_lock(&sharedKeys.lock);
+    if (sharedKeys.count >= sharedKeys.size) sharedKeysGrow();
+    for (sk = sharedKeys.buckets[hash & (sharedKeys.size - 1)]; sk != NULL; sk = sk->next) {
+        if (sharedKeyIs(sk, key, len, hash)) break;
+    }
+    if (sk == NULL) {
+        sk = ValkeyModule_Alloc(sizeof(*sk) + len + 1);
+        sk->hash = hash;
+        sk->refs = 0;
+        sk->len = len;
+        memcpy(sk->str, key, len + 1);
+        sk->next = sharedKeys.buckets[hash & (sharedKeys.size - 1)];
+        sharedKeys.buckets[hash & (sharedKeys.size - 1)] = sk;
+        sharedKeys.count++;
+    }
+    sk->refs++;
+    pthread_mutex_unlock(&sharedKeys.lock);
+    return sk;
+}
+
+static void docKeysInsert(tairDocKeys *keys, sharedKey *sk) {
+    size_t i = sk->hash & (keys->size - 1);
+    while (keys->slots[i] != NULL) i = (i + 1) & (keys->size - 1);
+    keys->slots[i] = sk;
+    keys->count++;
+}
+
+/* Doubles the name set of doc, its memory is charged to doc. */
+static void docKeysGrow(TairDocObj *doc) {
+    tairDocKeys *old = doc->keys, *keys;
+    size_t size = old ? old->size * 2 : TAIRDOC_KEYS_MIN_SIZE, i;
+
+    keys = ValkeyModule_Calloc(1, sizeof(*keys) + size * sizeof(sharedKey *));
+    keys->size = size;
+    doc->memory += ValkeyModule_MallocSize(keys);
+    if (old) {
+        for (i = 0; i < old->size; i++) {
+            if (old->slots[i]) docKeysInsert(keys, old->slots[i]);
+        }
+        doc->memory -= ValkeyModule_MallocSize(old);
+        ValkeyModule_Free(old);
+    } else {
+        doc->allocs++;
+    }
+    doc->keys = keys;
+}
+
+/*
+ * cJSON intern hook: returns the shared copy of key for the charged document,
+ * or NULL when the name is to be copied into the node.
+ */
+static char *tairDocInternKey(const char *key) {
+    TairDocObj *doc = chargedDoc;
+    tairDocKeys *keys;
+    sharedKey *sk;
+    uint64_t hash;
+    size_t len, i;
+
+    if (doc == NULL || (len = strlen(key)) > TAIRDOC_KEY_MAX_LEN) return NULL;
+    hash = sharedKeyHash(key, len);
+    if ((keys = doc->keys) != NULL) {
+        for (i = hash & (keys->size - 1); (sk = keys->slots[i]) != NULL; i = (i + 1) & (keys->size - 1)) {
+            if (sharedKeyIs(sk, key, len, hash)) return sk->str;
+        }
+        if (keys->count >= TAIRDOC_KEYS_PER_DOC) return NULL;
+    }
+    if (keys == NULL || (keys->count + 1) * 4 > keys->size * 3) docKeysGrow(doc);
+
+    sk = sharedKeyRetain(key, len, hash);
+    docKeysInsert(doc->keys, sk);
+    return sk->str;
+}
+
+/* Gives back the names held by doc, dropping those no other document uses. */
+static void releaseDocKeys(TairDocObj *doc) {
+    tairDocKeys *keys = doc->keys;
+    sharedKey *sk, **link;
+    size_t i;
+
+    if (keys == NULL) return;
+    pthread_mutex_lock(&sharedKeys.lock);
+    for (i = 0; i < keys->size; i++) {
+        if ((sk = keys->slots[i]) == NULL || --sk->refs) continue;
+        link = &sharedKeys.buckets[sk->hash & (sharedKeys.size - 1)];
+        while (*link != sk) link = &(*link)->next;
+        *link = sk->next;
+        sharedKeys.count--;
+        ValkeyModule_Free(sk);
+    }
+    pthread_mutex_unlock(&sharedKeys.lock);
+    ValkeyModule_Free(keys);
+    doc->keys = NULL;
+}
+
+/* ========================== TairDoc member index ======================= */
+
+/*
+ * Arrays and objects with CJSON_INDEX_MIN_MEMBERS members or more get an
+ * index of their members, so a JSON.GET or JSON.SET into an object of 50k
+ * members doesn't strcmp its way down the member list, and $[40000] or
+ * JSON.ARRLEN of a long array doesn't walk it. cJSON decides when a node is
+ * wide enough (when it is parsed, duplicated, or a lookup walks that far)
+ * and keeps the index up to date through the hooks below, see
+ * cJSON_InitIndexHooks().
+ *
+ * Objects are indexed by name in an open addressing hash table. Arrays keep
+ * their members in order in a vector with room at both ends, so pushing,
+ * popping and inserting near either end only moves the members on the short
+ * side. The member list stays the way it is, the vector only sits beside it.
+ *
+ * There is no room left in a node, so an index is found by its node in a
+ * module wide table. It belongs to a document all the same: it is only built
+ * while the document is charged, its memory is counted in the document, and
+ * the indexes of a document are freed with it without walking the tree.
+ * Lookups don't need the document, reads use the indexes built by the
+ * writes, loads and SETs before them. The table is locked since documents
+ * are also freed by the lazyfree thread.
+ *
+ * Objects with two members of the same name are not indexed, the index
+ * couldn't tell which of them comes first.
+ */
+typedef struct nodeIndex {
+    cJSON *node;
+    TairDocObj *doc;
+    struct nodeIndex *next;       /* next index in the same bucket */
+    struct nodeIndex *docprev;    /* indexes of the same document */
+    struct nodeIndex *docnext;
+    size_t size;                  /* objects: power of two, at most 3/4 full */
+    size_t count;
+    size_t start;                 /* arrays: slot of the first member */
+    size_t hint;                  /* arrays: position of the last member looked up */
+    cJSON **slots;                /* object members hashed by name, or array members in order */
+} nodeIndex;
+
+static struct {
+    pthread_mutex_t lock;
+    nodeIndex **buckets;
+    size_t size;                  /* power of two, 0 before the first index */
+    size_t count;
+} nodeIndexes = {PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0};
+
+static size_t nodeIndexBucket(const cJSON *node) {
+    return (size_t) (((uintptr_t) node >> 4) * 0x9E3779B97F4A7C15ULL >> 16) & (nodeIndexes.size - 1);
+}
+
+/* The index of node, the lock must be held. */
+static nodeIndex *nodeIndexFind(const cJSON *node) {
+    nodeIndex *idx;
+    if (nodeIndexes.size == 0) return NULL;
+    for (idx = nodeIndexes.buckets[nodeIndexBucket(node)]; idx != NULL; idx = idx->next) {
+        if (idx->node == node) return idx;
+    }
+    return NULL;
+}
+
+/* Adds idx to the table, the lock must be held. */
+static void nodeIndexAdd(nodeIndex *idx) {
+    nodeIndex **bucket;
+    if (nodeIndexes.count >= nodeIndexes.size) {
+        nodeIndex **old = nodeIndexes.buckets, *moved;
+        size_t oldsize = nodeIndexes.size, i;
+        nodeIndexes.size = oldsize ? oldsize * 2 : 64;
+        nodeIndexes.buckets = ValkeyModule_Calloc(nodeIndexes.size, sizeof(*old));
+        for (i = 0; i < oldsize; i++) {
+            while ((moved = old[i]) != NULL) {
+                old[i] = moved->next;
+                bucket = &nodeIndexes.buckets[nodeIndexBucket(moved->node)];
+                moved->next = *bucket;
+                *bucket = moved;
+            }
+        }
+        ValkeyModule_Free(old);
+    }
+    bucket = &nodeIndexes.buckets[nodeIndexBucket(idx->node)];
+    idx->next = *bucket;
+    *bucket = idx;
+    nodeIndexes.count++;
+}
+
+/* Takes idx out of the table, the lock must be held. */
+static void nodeIndexRemove(nodeIndex *idx) {
+    nodeIndex **link = &nodeIndexes.buckets[nodeIndexBucket(idx->node)];
+    while (*link != idx) link = &(*link)->next;
+    *link = idx->next;
+    nodeIndexes.count--;
+}
+
+/* Takes idx out of the table and its document and frees it, the lock must be held. */
+static void nodeIndexFree(nodeIndex *idx) {
+    TairDocObj *doc = idx->doc;
+
+    nodeIndexRemove(idx);
+    if (idx->docprev) {
+        idx->docprev->docnext = idx->docnext;
+    } else {
+        doc->indexes = idx->docnext;
+    }
+    if (idx->docnext) idx->docnext->docprev = idx->docprev;
+    idx->node->type &= ~cJSON_IsIndexed;
+
+    doc->memory -= ValkeyModule_MallocSize(idx->slots) + ValkeyModule_MallocSize(idx);
+    doc->allocs -= 2;
+    ValkeyModule_Free(idx->slots);
+    ValkeyModule_Free(idx);
+}
+
+static size_t nodeIndexHome(const nodeIndex *idx, const char *name) {
+    return (size_t) sharedKeyHash(name, strlen(name)) & (idx->size - 1);
+}
+
+/* Slot holding the member named name, or the empty slot where it goes. */
+static cJSON **nodeIndexProbe(const nodeIndex *idx, const char *name) {
+    size_t i = nodeIndexHome(idx, name);
+    while (idx->slots[i] != NULL && strcmp(idx->slots[i]->string, name) != 0) {
+        i = (i + 1) & (idx->size - 1);
+    }
+    return &idx->slots[i];
+}
+
+/* Indexes member, returns 0 if it has no name or shares it with another member. */
+static int nodeIndexLink(nodeIndex *idx, cJSON *member) {
+    cJSON **slot;
+
+    if (member->string == NULL) return 0;
+    if ((idx->count + 1) * 4 > idx->size * 3) {
+        cJSON **old = idx->slots;
+        size_t oldsize = idx->size, i;
+        idx->doc->memory -= ValkeyModule_MallocSize(old);
+        idx->size *= 2;
+        idx->slots = ValkeyModule_Calloc(idx->size, sizeof(*old));
+        idx->doc->memory += ValkeyModule_MallocSize(idx->slots);
+        for (i = 0; i < oldsize; i++) {
+            if (old[i]) *nodeIndexProbe(idx, old[i]->string) = old[i];
+        }
+        ValkeyModule_Free(old);
+    }
+    slot = nodeIndexProbe(idx, member->string);
+    if (*slot != NULL) return 0;
+    *slot = member;
+    idx->count++;
+    return 1;
+}
+
+/* Removes member from idx, closing the gap so no probe sequence is cut short. */
+static void nodeIndexUnlink(nodeIndex *idx, cJSON *member) {
+    size_t mask = idx->size - 1, i, j, home;
+
+    if (member->string == NULL) return;
+    i = nodeIndexProbe(idx, member->string) - idx->slots;
+    if (idx->slots[i] != member) return;
+    idx->slots[i] = NULL;
+    idx->count--;
+    for (j = (i + 1) & mask; idx->slots[j] != NULL; j = (j + 1) & mask) {
+        home = nodeIndexHome(idx, idx->slots[j]->string);
+        /* the member at j may fill the hole at i unless its home lies in (i, j] */
+        if ((i <= j) ? (home <= i || home > j) : (home <= i && home > j)) {
+            idx->slots[i] = idx->slots[j];
+            idx->slots[j] = NULL;
+            i = j;
+        }
+    }
+}
+
+/* Moves the members of an array index to a new vector with room on both sides. */
+static void nodeIndexResize(nodeIndex *idx) {
+    size_t size = idx->count + idx->count / 2 + 16;
+    size_t start = (size - idx->count) / 2;
+    cJSON **slots = ValkeyModule_Alloc(size * sizeof(cJSON *));
+
+    if (idx->slots) {
+        memcpy(slots + start, idx->slots + idx->start, idx->count * sizeof(cJSON *));
+        idx->doc->memory -= ValkeyModule_MallocSize(idx->slots);
+        ValkeyModule_Free(idx->slots);
+    }
+    idx->doc->memory += ValkeyModule_MallocSize(slots);
+    idx->slots = slots;
+    idx->size = size;
+    idx->start = start;
+}
+
+/*
+ * Position of member in an array index, or count if it isn't there. Members
+ * are mostly looked up at the ends or next to the one before, so the search
+ * goes out from there. Only compares pointers, member may be freed already.
+ */
+static size_t nodeIndexPosition(nodeIndex *idx, const cJSON *member) {
+    cJSON **members = idx->slots + idx->start;
+    size_t n = idx->count, h = idx->hint < n ? idx->hint : 0, d;
+
+    if (n == 0) return 0;
+    if (members[0] == member) return idx->hint = 0;
+    if (members[n - 1] == member) return idx->hint = n - 1;
+    for (d = 0; d < n; d++) {
+        if (h + d < n && members[h + d] == member) return idx->hint = h + d;
+        if (d <= h && members[h - d] == member) return idx->hint = h - d;
+        if (h + d >= n && d > h) break;
+    }
+    return n;
+}
+
+/* Puts member, already linked in the list, at its place in an array index. */
+static int nodeIndexInsert(nodeIndex *idx, cJSON *member) {
+    size_t pos = member->next ? nodeIndexPosition(idx, member->next) : idx->count;
+
+    if (pos == idx->count && member->next != NULL) return 0;
+    if (pos < idx->count / 2) {
+        if (idx->start == 0) nodeIndexResize(idx);
+        memmove(idx->slots + idx->start - 1, idx->slots + idx->start, pos * sizeof(cJSON *));
+        idx->start--;
+    } else {
+        if (idx->start + idx->count == idx->size) nodeIndexResize(idx);
+        memmove(idx->slots + idx->start + pos + 1, idx->slots + idx->start + pos,
+                (idx->count - pos) * sizeof(cJSON *));
+    }
+    idx->slots[idx->start + pos] = member;
+    idx->count++;
+    idx->hint = pos;
+    return 1;
+}
+
+/* Takes member out of an array index, shrinking the vector once it is mostly empty. */
+static void nodeIndexErase(nodeIndex *idx, cJSON *member) {
+    size_t pos = nodeIndexPosition(idx, member);
+
+    if (pos == idx->count) return;
+    if (pos < idx->count / 2) {
+        memmove(idx->slots + idx->start + 1, idx->slots + idx->start, pos * sizeof(cJSON *));
+        idx->start++;
+    } else {
+        memmove(idx->slots + idx->start + pos, idx->slots + idx->start + pos + 1,
+                (idx->count - pos - 1) * sizeof(cJSON *));
+    }
+    idx->count--;
+    if (idx->size > 64 && idx->count * 4 < idx->size) nodeIndexResize(idx);
+}
+
+static cJSON_bool tairDocIndexBuild(cJSON *node) {
+    TairDocObj *doc = chargedDoc;
+    nodeIndex *idx;
+    cJSON *member;
+    size_t members = 0;
+
+    if (doc == NULL) return 0;
+    if (node->type & cJSON_IsIndexed) return 1;
+    for (member = node->child; member != NULL; member = member->next) members++;
+
+    idx = ValkeyModule_Alloc(sizeof(*idx));
+    idx->node = node;
+    idx->doc = doc;
+    idx->count = 0;
+    idx->hint = 0;
+    if (cJSON_IsArray(node)) {
+        idx->slots = NULL;
+        idx->count = members;
+        nodeIndexResize(idx);
+        idx->count = 0;
+        for (member = node->child; member != NULL; member = member->next) {
+            idx->slots[idx->start + idx->count++] = member;
+        }
+        doc->memory += ValkeyModule_MallocSize(idx);
+        doc->allocs += 2;
+    } else {
+        for (idx->size = 16; idx->size * 3 < members * 4; idx->size *= 2);
+        idx->slots = ValkeyModule_Calloc(idx->size, sizeof(cJSON *));
+        doc->memory += ValkeyModule_MallocSize(idx->slots) + ValkeyModule_MallocSize(idx);
+        doc->allocs += 2;
+        for (member = node->child; member != NULL; member = member->next) {
+            if (!nodeIndexLink(idx, member)) {
+                doc->memory -= ValkeyModule_MallocSize(idx->slots) + ValkeyModule_MallocSize(idx);
+                doc->allocs -= 2;
+                ValkeyModule_Free(idx->slots);
+                ValkeyModule_Free(idx);
+                return 0;
+            }
+        }
+    }
+
+    pthread_mutex_lock(&nodeIndexes.lock);
+    nodeIndexAdd(idx);
+    idx->docprev = NULL;
+    idx->docnext = doc->indexes;
+    if (doc->indexes) doc->indexes->docprev = idx;
+    doc->indexes = idx;
+    node->type |= cJSON_IsIndexed;
+    pthread_mutex_unlock(&nodeIndexes.lock);
+    return 1;
+}
+
+static cJSON *tairDocIndexFind(const cJSON *object, const char *name) {
+    nodeIndex *idx;
+    cJSON *member = NULL;
+
+    pthread_mutex_lock(&nodeIndexes.lock);
+    if ((idx = nodeIndexFind(object)) != NULL) member = *nodeIndexProbe(idx, name);
+    pthread_mutex_unlock(&nodeIndexes.lock);
+    return member;
+}
+
+static cJSON *tairDocIndexAt(const cJSON *array, size_t index) {
+    nodeIndex *idx;
+    cJSON *member = NULL;
+
+    pthread_mutex_lock(&nodeIndexes.lock);
+    if ((idx = nodeIndexFind(array)) != NULL && index < idx->count) {
+        member = idx->slots[idx->start + index];
+        idx->hint = index;
+    }
+    pthread_mutex_unlock(&nodeIndexes.lock);
+    return member;
+}
+
+static size_t tairDocIndexSize(const cJSON *node) {
+    nodeIndex *idx;
+    size_t count = 0;
+
+    pthread_mutex_lock(&nodeIndexes.lock);
+    if ((idx = nodeIndexFind(node)) != NULL) count = idx->count;
+    pthread_mutex_unlock(&nodeIndexes.lock);
+    return count;
+}
+
+static void tairDocIndexLink(cJSON *node, cJSON *member) {
+    nodeIndex *idx;
+    int linked;
+
+    pthread_mutex_lock(&nodeIndexes.lock);
+    if ((idx = nodeIndexFind(node)) != NULL) {
+        linked = cJSON_IsArray(node) ? nodeIndexInsert(idx, member) : nodeIndexLink(idx, member);
+        if (!linked) nodeIndexFree(idx);
+    }
+    pthread_mutex_unlock(&nodeIndexes.lock);
+}
+
+static void tairDocIndexUnlink(cJSON *node, cJSON *member) {
+    nodeIndex *idx;
+
+    pthread_mutex_lock(&nodeIndexes.lock);
+    if ((idx = nodeIndexFind(node)) != NULL) {
+        if (cJSON_IsArray(node)) {
+            nodeIndexErase(idx, member);
+        } else {
+            nodeIndexUnlink(idx, member);
+        }
+    }
+    pthread_mutex_unlock(&nodeIndexes.lock);
+}
+
+static void tairDocIndexDrop(cJSON *node) {
+    nodeIndex *idx;
+
+    pthread_mutex_lock(&nodeIndexes.lock);
+    if ((idx = nodeIndexFind(node)) != NULL) nodeIndexFree(idx);
+    pthread_mutex_unlock(&nodeIndexes.lock);
+    node->type &= ~cJSON_IsIndexed;
+}
+
+/*
+ * Defrag moved old to moved: points the index of parent, and the index of the
+ * node itself, at the new copy. old is freed already, only its address is used.
+ */
+static void nodeIndexMoved(cJSON *parent, cJSON *old, cJSON *moved) {
+    nodeIndex *idx;
+    size_t i;
+
+    pthread_mutex_lock(&nodeIndexes.lock);
+    if (parent && (parent->type & cJSON_IsIndexed) && (idx = nodeIndexFind(parent)) != NULL) {
+        if (cJSON_IsArray(parent)) {
+            i = nodeIndexPosition(idx, old);
+            if (i < idx->count) idx->slots[idx->start + i] = moved;
+        } else if (moved->string != NULL) {
+            for (i = nodeIndexHome(idx, moved->string); idx->slots[i] != NULL; i = (i + 1) & (idx->size - 1)) {
+                if (idx->slots[i] == old) {
+                    idx->slots[i] = moved;
+                    break;
+                }
+            }
+        }
+    }
+    if ((moved->type & cJSON_IsIndexed) && (idx = nodeIndexFind(old)) != NULL) {
+        nodeIndexRemove(idx);
+        idx->node = moved;
+        nodeIndexAdd(idx);
+    }
+    pthread_mutex_unlock(&nodeIndexes.lock);
+}
+
+/* Frees every index of doc, the nodes they belong to may be gone already. */
+static void releaseDocIndexes(TairDocObj *doc) {
+    nodeIndex *idx;
+
+    if (doc->indexes == NULL) return;
+    pthread_mutex_lock(&nodeIndexes.lock);
+    while ((idx = doc->indexes) != NULL) {
+        nodeIndexRemove(idx);
+        doc->indexes = idx->docnext;
+        ValkeyModule_Free(idx->slots);
+        ValkeyModule_Free(idx);
+    }
+    pthread_mutex_unlock(&nodeIndexes.lock);
+}
+
+/*
+ * JSON.GET and JSON.MGET keep the text of the node of a document they print
+ * twice in a row, as long as no write comes in between, so a hot document or
+ * subtree is copied into the reply instead of printed again. Texts longer than
+ * printCacheMax (the print-cache-max load argument, 0 turns the cache off) are
+ * never kept.
+ */
+#define TAIRDOC_PRINT_CACHE_MAX (8 * 1024 * 1024)
+static size_t printCacheMax = TAIRDOC_PRINT_CACHE_MAX;
+static unsigned long long printCacheHits = 0, printCacheMisses = 0;
+
+/* Forgets the node printed last along with its text. */
+static void dropPrintCache(TairDocObj *doc) {
+    if (doc->cachedText) ValkeyModule_Free(doc->cachedText);
+    doc->cached = NULL;
+    doc->cachedText = NULL;
+    doc->cachedLen = 0;
+}
+
+static TairDocObj *createTairDocObj(void) {
+    TairDocObj *doc = ValkeyModule_Alloc(sizeof(*doc));
+    doc->root = NULL;
+    doc->memory = 0;
+    doc->allocs = 0;
+    doc->defrag = NULL;
+    doc->arena = NULL;
+    doc->keys = NULL;
+    doc->indexes = NULL;
+    doc->printed = 0;
+    doc->cached = NULL;
+    doc->cachedText = NULL;
+    doc->cachedLen = 0;
+    return doc;
+}
+
+/* Frees doc with its tree, an arena goes away without walking the tree. */
+static void releaseTairDocObj(TairDocObj *doc) {
+    TairDocObj *charged = chargedDoc;
+
+    /* The whole tree goes away, there is nothing left to account for. */
+    chargedDoc = NULL;
+    releaseDocIndexes(doc);
+    if (doc->arena) {
+        arenaRelease(doc);
+    } else {
+        cJSON_Delete(doc->root);
+    }
+    releaseDocKeys(doc);
+    dropDefragState(doc);
+    dropPrintCache(doc);
+    ValkeyModule_Free(doc);
+    chargedDoc = charged == doc ? NULL : charged;
+}
+
+/* ========================== TairDoc compiled paths ======================= */
+
+/*
+ * Commands compile their path argument before following it: a JSON pointer or
+ * a dotted path into the tokens of a cJSONUtils_Pointer, a JSONPath into a
+ * Selector list. Clients send the same few hundred paths over and over, so
+ * the last paths compiled are kept in a cache for each kind, and the least
+ * recently used one makes room for a new one. Following a compiled path only
+ * reads it, so one is shared by every command using it.
+ *
+ * The caches keep up to selector-cache-max JSONPaths and pointer-cache-max
+ * pointers (load arguments, 0 turns a cache off). Paths longer than
+ * TAIRDOC_PATH_CACHE_MAX_LEN bytes are compiled every time. Only commands use
+ * the caches, they take no lock, and their memory belongs to no document.
+ */
+#define TAIRDOC_SELECTOR_CACHE_MAX 1024
+#define TAIRDOC_POINTER_CACHE_MAX 1024
+#define TAIRDOC_PATH_CACHE_MAX_LEN 256
+#define TAIRDOC_PATH_CACHE_BUCKETS_MAX (64 * 1024)
+
+typedef struct cachedPath {
+    struct cachedPath *next;                /* next path in the same bucket */
+    struct cachedPath *newer, *older;       /* LRU order */
+    void *compiled;
+    uint64_t hash;
+    size_t len;
+    char path[];
+} cachedPath;
+
+typedef struct pathCache {
+    cachedPath **buckets;
+    size_t size;                            /* power of two, 0 before the first path */
+    size_t count;
+    size_t max;                             /* paths kept at most, 0 for none */
+    cachedPath *newest, *oldest;
+    void (*release)(void *compiled);
+    unsigned long long hits, misses;
+} pathCache;
+
+static void releaseSelector(void *compiled) {
+    cJSONUtils_Delete_Selector(compiled);
+}
+
+static void releasePointer(void *compiled) {
+    cJSON_free(compiled);
+}
+
+static pathCache selectorCache = {NULL, 0, 0, TAIRDOC_SELECTOR_CACHE_MAX, NULL, NULL, releaseSelector, 0, 0};
+static pathCache pointerCache = {NULL, 0, 0, TAIRDOC_POINTER_CACHE_MAX, NULL, NULL, releasePointer, 0, 0};
+
+static void pathCacheUnlink(pathCache *cache, cachedPath *cp) {
+    if (cp->newer) cp->newer->older = cp->older; else cache->newest = cp->older;
+    if (cp->older) cp->older->newer = cp->newer; else cache->oldest = cp->newer;
+}
+
+static void pathCachePush(pathCache *cache, cachedPath *cp) {
+    cp->newer = NULL;
+    cp->older = cache->newest;
+    if (cache->newest) cache->newest->newer = cp; else cache->oldest = cp;
+    cache->newest = cp;
+}
+
+/* Drops the least recently used path. */
+static void pathCacheEvict(pathCache *cache) {
+    cachedPath *cp = cache->oldest, **link;
+
+    link = &cache->buckets[cp->hash & (cache->size - 1)];
+    while (*link != cp) link = &(*link)->next;
+    *link = cp->next;
+    pathCacheUnlink(cache, cp);
+    cache->count--;
+    cache->release(cp->compiled);
+    ValkeyModule_Free(cp);
+}
+
+/*
+ * Returns path compiled by compile, or NULL if that fails. The result stays
+ * valid until the next path is compiled: it is the cache's, or if it isn't
+ * kept it is freed on the next call.
+ */
+static void *compileCachedPath(pathCache *cache, const char *path, size_t len, void *(*compile)(const char *)) {
+    static pathCache *uncachedFrom = NULL;
+    static void *uncached = NULL;
+    cachedPath *cp;
+    void *compiled;
+    uint64_t hash;
+
+    // compiled paths are allocated with the cJSON hooks, for no document
+    assert(chargedDoc == NULL);
+    if (uncached) {
+        uncachedFrom->release(uncached);
+        uncached = NULL;
+    }
+    if (cache->max == 0 || len > TAIRDOC_PATH_CACHE_MAX_LEN) {
+        uncachedFrom = cache;
+        return uncached = compile(path);
+    }
+
+    hash = sharedKeyHash(path, len);
+    if (cache->size) {
+        for (cp = cache->buckets[hash & (cache->size - 1)]; cp != NULL; cp = cp->next) {
+            if (cp->hash == hash && cp->len == len && memcmp(cp->path, path, len) == 0) {
+                cache->hits++;
+                pathCacheUnlink(cache, cp);
+                pathCachePush(cache, cp);
+                return cp->compiled;
+            }
+        }
+    }
+
+    cache->misses++;
+    if ((compiled = compile(path)) == NULL) return NULL;
+    if (cache->size == 0) {
+        // about one path per bucket, the table never grows
+        cache->size = 16;
+        while (cache->size < cache->max && cache->size < TAIRDOC_PATH_CACHE_BUCKETS_MAX) cache->size *= 2;
+        cache->buckets = ValkeyModule_Calloc(cache->size, sizeof(*cache->buckets));
+    }
+    if (cache->count >= cache->max) pathCacheEvict(cache);
+
+    cp = ValkeyModule_Alloc(sizeof(*cp) + len + 1);
+    cp->compiled = compiled;
+    cp->hash = hash;
+    cp->len = len;
+    memcpy(cp->path, path, len + 1);
+    cp->next = cache->buckets[hash & (cache->size - 1)];
+    cache->buckets[hash & (cache->size - 1)] = cp;
+    pathCachePush(cache, cp);
+    cache->count++;
+    return compiled;
+}
+
+static void *compileSelector(const char *path) {
+    return cJSONUtils_CompileSelector(path);
+}
+
+/* Returns the JSONPath path compiled, NULL if it isn't valid. */
+static const Selector *compileJsonPath(const char *path, size_t len) {
+    return compileCachedPath(&selectorCache, path, len, compileSelector);
+}
+
 /* ========================== TairDoc function methods ======================= */
 
-#define PATH_TO_POINTER(ctx, path, rpointer)                              \
-    if (pathToPointer((ctx), (path), &(rpointer)) != 0) {                 \
+#define COMPILE_PATH(ctx, path, cpointer)                                 \
+    if (((cpointer) = compilePath((path))) == NULL) {                     \
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_PATH_TO_POINTER_ERROR);    \
         return VALKEYMODULE_ERR;                                           \
     }
 
+/* If the compiled cpointer is "", the whole document. */
+#define IS_ROOT_POINTER(cpointer) ((cpointer)->count == 0 && !(cpointer)->relative)
+
+/*
+ * Inputs from TAIRDOC_LARGE_JSON_MIN_INPUT bytes on are parsed by indexing
+ * their tokens first, which only pays off once the input is way past the
+ * caches. Both parsers give the same tree and the same error position.
+ */
+#define TAIRDOC_LARGE_JSON_MIN_INPUT (256 * 1024)
+
+static cJSON *parseJson(const char *json, cJSON_bool require_null_terminated) {
+    size_t len = strlen(json);
+
+    if (len >= TAIRDOC_LARGE_JSON_MIN_INPUT) {
+        return cJSON_ParseLargeWithLengthOpts(json, len + 1, NULL, require_null_terminated);
+    }
+    return cJSON_ParseWithLengthOpts(json, len + 1, NULL, require_null_terminated);
+}
+
 /*
  * create node from json
  */
 int createNodeFromJson(cJSON **node, const char *json, ValkeyModuleString **jerr) {
-    *node = cJSON_ParseWithOpts(json, NULL, 1);
+    *node = parseJson(json, 1);
     if (*node == NULL) {
         *jerr = ValkeyModule_CreateStringPrintf(NULL, "ERR json lexer error at position '%s'", cJSON_GetErrorPtr());
         return VALKEYMODULE_ERR;
@@ -44,28 +1114,91 @@ int createNodeFromJson(cJSON **node, const char *json, ValkeyModuleString **jerr
     return VALKEYMODULE_OK;
 }
 
-int composePatch(cJSON *const patches, const unsigned char *const operation, const char *const path,
-                 const cJSON *const value) {
-    cJSON *patch = NULL;
-    if ((patches == NULL) || (operation == NULL) || (path == NULL)) {
-        return VALKEYMODULE_ERR;
-    }
+/*
+ * Replies are printed into one buffer that is kept from command to command, so
+ * printing doesn't allocate once it is big enough. A buffer grown beyond
+ * TAIRDOC_PRINT_BUFFER_KEEP by a large reply is freed after that reply.
+ */
+#define TAIRDOC_PRINT_BUFFER_KEEP (1024 * 1024)
+static char *printBuffer = NULL;
+static size_t printBufferSize = 0;
+
+/* Prints node unformatted into printBuffer and returns the length, hint is the
+ * length expected or 0. */
+static size_t printJson(const cJSON *node, size_t hint) {
+    size_t len;
+
+    // the buffer belongs to no document
+    assert(chargedDoc == NULL);
+    // some room past the hint, for a value that has grown a little since
+    if (hint) hint += hint / 16 + 64;
+    len = cJSON_PrintToBuffer(node, &printBuffer, &printBufferSize, hint, 0);
+    assert(len != 0);
+    return len;
+}
 
-    patch = cJSON_CreateObject();
-    if (patch == NULL) {
-        return VALKEYMODULE_ERR;
+/* Done with printBuffer's text, a buffer that is too large isn't kept. */
+static void printDone(void) {
+    if (printBufferSize > TAIRDOC_PRINT_BUFFER_KEEP) {
+        cJSON_free(printBuffer);
+        printBuffer = NULL;
+        printBufferSize = 0;
     }
-    cJSON_AddItemToObject(patch, "op", cJSON_CreateString((const char *) operation));
-    cJSON_AddItemToObject(patch, "path", cJSON_CreateString(path));
-    if (value != NULL) {
-        cJSON_AddItemToObject(patch, "value", cJSON_Duplicate(value, 1));
+}
+
+/* Replies with the array of the values selector selects in root, printed from the nodes themselves. */
+static void replyWithJsonPath(ValkeyModuleCtx *ctx, const cJSON *root, const Selector *selector) {
+    size_t len;
+
+    assert(chargedDoc == NULL);
+    len = cJSONUtils_PrintSelector(root, selector, &printBuffer, &printBufferSize, 0, 0);
+    assert(len != 0);
+    ValkeyModule_ReplyWithStringBuffer(ctx, printBuffer, len);
+    printDone();
+}
+
+/*
+ * Replies with the JSON text of node. When node belongs to doc the text comes
+ * from the print cache if it can, and the root is printed into a buffer sized
+ * from its last print. doc is NULL for nodes that aren't part of a document.
+ */
+static void replyWithJson(ValkeyModuleCtx *ctx, TairDocObj *doc, const cJSON *node) {
+    int isRoot = doc != NULL && node == doc->root;
+    size_t len;
+
+    if (doc && doc->cachedText && doc->cached == node) {
+        printCacheHits++;
+        ValkeyModule_ReplyWithStringBuffer(ctx, doc->cachedText, doc->cachedLen);
+        return;
+    }
+
+    len = printJson(node, isRoot ? doc->printed : 0);
+    ValkeyModule_ReplyWithStringBuffer(ctx, printBuffer, len);
+    if (doc) {
+        printCacheMisses++;
+        if (isRoot) doc->printed = len;
+        if (doc->cached == node && len <= printCacheMax) {
+            // second print in a row, the node is read more than it is written
+            doc->cachedText = ValkeyModule_Alloc(len);
+            memcpy(doc->cachedText, printBuffer, len);
+            doc->cachedLen = len;
+        } else {
+            dropPrintCache(doc);
+            doc->cached = node;
+        }
     }
-    cJSON_AddItemToArray(patches, patch);
-    return VALKEYMODULE_OK;
+    printDone();
 }
 
-int applyPatch(cJSON *const object, const cJSON *const patches, ValkeyModuleString **jerr) {
-    int ret = cJSONUtils_ApplyPatchesCaseSensitive(object, patches);
+/* The document of key for a write command, which may change any of its
+ * nodes, so the cached text goes. */
+static TairDocObj *getDocForWrite(ValkeyModuleKey *key) {
+    TairDocObj *doc = ValkeyModule_ModuleTypeGetValue(key);
+    dropPrintCache(doc);
+    return doc;
+}
+
+static int patchError(int ret, ValkeyModuleString **jerr) {
     if (ret == 0) {
         goto ok;
     }
@@ -115,7 +1248,7 @@ int applyPatch(cJSON *const object, const cJSON *const patches, ValkeyModuleStri
 /* Returns the string representation json node's type. */
 static inline char *jsonNodeType(const int nt) {
     static char *types[] = {"boolean", "null", "number", "string", "array", "object", "raw", "reference", "const"};
-    switch (nt) {
+    switch (nt & ~(cJSON_StringIsConst | cJSON_IsIndexed | cJSON_NumberIsInt)) { /* flags that aren't part of the type */
         case cJSON_False:
         case cJSON_True:
             return types[0];
@@ -140,16 +1273,18 @@ static inline char *jsonNodeType(const int nt) {
     }
 }
 
-int pathToPointer(ValkeyModuleCtx *ctx, const char *jpa, ValkeyModuleString **rpointer) {
-    char *jpo = NULL;
-
+/*
+ * Converts the dotted or bracketed path jpa to a JSON pointer in jpo, which has
+ * room for strlen(jpa) + 1 bytes: the pointer is never longer than the path.
+ */
+static int pathToPointer(const char *jpa, char *jpo) {
     if (jpa[0] != '.' && jpa[0] != '[' && jpa[0] != '$') {
-        *rpointer = ValkeyModule_CreateString(ctx, jpa, strlen(jpa));
+        strcpy(jpo, jpa);
         return 0;
     }
 
     if (!strcmp(jpa, ".") || !strcmp(jpa, "") || !strcmp(jpa, "$")) {
-        *rpointer = ValkeyModule_CreateString(ctx, "", 0);
+        jpo[0] = '\0';
         return 0;
     }
 
@@ -159,13 +1294,11 @@ int pathToPointer(ValkeyModuleCtx *ctx, const char *jpa, ValkeyModuleString **rp
         char c = jpa[i];
         switch (c) {
             case '.':
-                jpo = (char *) ValkeyModule_Realloc(jpo, step + 1);
                 memcpy(jpo + step, "/", 1);
                 step++;
                 break;
 
             case '[':
-                jpo = (char *) ValkeyModule_Realloc(jpo, step + 1);
                 memcpy(jpo + step, "/", 1);
                 step++;
 
@@ -177,7 +1310,6 @@ int pathToPointer(ValkeyModuleCtx *ctx, const char *jpa, ValkeyModuleString **rp
                         goto error;
                     }
                     size = j - i - 2;
-                    jpo = (char *) ValkeyModule_Realloc(jpo, step + size);
                     memcpy(jpo + step, &jpa[i + 2], (size_t) size);
                     step += size;
                     i = j + 1;
@@ -190,7 +1322,6 @@ int pathToPointer(ValkeyModuleCtx *ctx, const char *jpa, ValkeyModuleString **rp
                         goto error;
                     }
                     size = j - i - 1;
-                    jpo = (char *) ValkeyModule_Realloc(jpo, step + size);
                     memcpy(jpo + step, &jpa[i + 1], (size_t) size);
                     step += size;
                     i = j;
@@ -203,24 +1334,35 @@ int pathToPointer(ValkeyModuleCtx *ctx, const char *jpa, ValkeyModuleString **rp
                 j = i + 1;
                 while (j < len && jpa[j] != '.' && jpa[j] != '[') ++j;
                 size = j - i;
-                jpo = (char *) ValkeyModule_Realloc(jpo, step + size);
                 memcpy(jpo + step, &jpa[i], (size_t) size);
                 i += size - 1;
                 step += size;
         }
     }
 
-    jpo = (char *) ValkeyModule_Realloc(jpo, step + 1);
     jpo[step] = '\0';
-    *rpointer = ValkeyModule_CreateString(ctx, jpo, strlen(jpo));
-    ValkeyModule_Free(jpo);
     return 0;
 
     error:
-    if (jpo) ValkeyModule_Free(jpo);
     return -1;
 }
 
+static void *compilePointer(const char *path) {
+    char buf[TAIRDOC_PATH_CACHE_MAX_LEN + 1], *jpo = buf;
+    size_t len = strlen(path);
+    cJSONUtils_Pointer *pointer = NULL;
+
+    if (len >= sizeof(buf)) jpo = ValkeyModule_Alloc(len + 1);
+    if (pathToPointer(path, jpo) == 0) pointer = cJSONUtils_CompilePointer(jpo);
+    if (jpo != buf) ValkeyModule_Free(jpo);
+    return pointer;
+}
+
+/* Returns the JSON pointer, dotted or bracketed path compiled, NULL if it isn't valid. */
+static const cJSONUtils_Pointer *compilePath(const char *path) {
+    return compileCachedPath(&pointerCache, path, strlen(path), compilePointer);
+}
+
 /* ========================== TairDoc commands methods ======================= */
 
 /**
@@ -245,12 +1387,16 @@ int TairDocSet_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, in
 
     ValkeyModuleString *jerr = NULL;
     int flags = EX_OBJ_SET_NO_FLAGS;
-    int isRootPointer = 0, isKeyExists = 0;
-    cJSON *root = NULL, *node = NULL, *patches = NULL, *pnode = NULL;
+    int isRootPointer = 0, isKeyExists = 0, ret = 0;
+    size_t jsonlen = 0;
+    const char *json = NULL;
+    TairDocObj *doc = NULL;
+    cJSON *root = NULL, *node = NULL;
+    cJSONUtils_Location loc;
 
     const char *pointer = ValkeyModule_StringPtrLen(argv[2], NULL);
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
     if (argc == 5) {
         const char *a = ValkeyModule_StringPtrLen(argv[4], NULL);
@@ -277,50 +1423,56 @@ int TairDocSet_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, in
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
-    }
-
-    if (VALKEYMODULE_OK != createNodeFromJson(&node, ValkeyModule_StringPtrLen(argv[3], NULL), &jerr)) {
-        ValkeyModule_ReplyWithError(ctx, ValkeyModule_StringPtrLen(jerr, NULL));
-        ValkeyModule_FreeString(NULL, jerr);
-        goto error;
+        doc = getDocForWrite(key);
+        root = doc->root;
     }
-    debugPrint(ctx, "node", node);
 
-    root = isKeyExists ? root : cJSON_Duplicate(node, 1);
-    isRootPointer = strcasecmp("", ValkeyModule_StringPtrLen(rpointer, NULL)) ? 0 : 1;
+    json = ValkeyModule_StringPtrLen(argv[3], &jsonlen);
+    isRootPointer = IS_ROOT_POINTER(cpointer);
     if (!isKeyExists) {
+        // if key not exists, parse right into a new document.
+        doc = createTairDocObj();
+        if (jsonlen >= TAIRDOC_ARENA_MIN_INPUT) arenaCreate(doc);
+        chargedDoc = doc;
+        if (VALKEYMODULE_OK != createNodeFromJson(&doc->root, json, &jerr)) {
+            releaseTairDocObj(doc);
+            ValkeyModule_ReplyWithError(ctx, ValkeyModule_StringPtrLen(jerr, NULL));
+            ValkeyModule_FreeString(NULL, jerr);
+            return VALKEYMODULE_ERR;
+        }
+        chargedDoc = NULL;
+        debugPrint(ctx, "node", doc->root);
         if (!isRootPointer) {
-            if (root) cJSON_Delete(root);
+            releaseTairDocObj(doc);
             ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_NEW_NOT_ROOT);
-            goto error;
+            return VALKEYMODULE_ERR;
         }
-        // if key not exists, add it.
-        ValkeyModule_ModuleTypeSetValue(key, TairDocType, root);
+        ValkeyModule_ModuleTypeSetValue(key, TairDocType, doc);
+        root = doc->root;
         goto ok;
     }
 
-    // make a patch and apply
-    patches = cJSON_CreateArray();
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
-    if (pnode == NULL) {
-        if (flags & EX_OBJ_SET_XX) goto null;
-        if (VALKEYMODULE_OK !=
-            composePatch(patches, (const unsigned char *) "add", ValkeyModule_StringPtrLen(rpointer, NULL), node)) {
-            ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_JSONOBJECT_ERROR);
-            goto error;
-        }
-    } else {
-        if (flags & EX_OBJ_SET_NX) goto null;
-        if (VALKEYMODULE_OK !=
-            composePatch(patches, (const unsigned char *) "replace", ValkeyModule_StringPtrLen(rpointer, NULL), node)) {
-            ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_JSONOBJECT_ERROR);
-            goto error;
-        }
+    // the value is parsed for doc and moved into it, everything is charged to doc
+    chargedDoc = doc;
+    if (VALKEYMODULE_OK != createNodeFromJson(&node, json, &jerr)) {
+        ValkeyModule_ReplyWithError(ctx, ValkeyModule_StringPtrLen(jerr, NULL));
+        ValkeyModule_FreeString(NULL, jerr);
+        goto error;
+    }
+    debugPrint(ctx, "node", node);
+
+    // one walk finds both whether the path exists and where to put the value
+    ret = cJSONUtils_LocateCompiledPointer(root, cpointer, &loc);
+    if (ret == 0) {
+        if ((loc.item == NULL) && (flags & EX_OBJ_SET_XX)) goto null;
+        if ((loc.item != NULL) && (flags & EX_OBJ_SET_NX)) goto null;
+        ret = cJSONUtils_SetAtLocation(root, &loc, node);
+        node = NULL;
+    } else if (flags & EX_OBJ_SET_XX) {
+        goto null;
     }
-    debugPrint(ctx, "patch", patches);
 
-    if (VALKEYMODULE_OK != applyPatch(root, patches, &jerr)) {
+    if (VALKEYMODULE_OK != patchError(ret, &jerr)) {
         ValkeyModule_ReplyWithError(ctx, ValkeyModule_StringPtrLen(jerr, NULL));
         ValkeyModule_FreeString(NULL, jerr);
         goto error;
@@ -329,20 +1481,19 @@ int TairDocSet_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, in
 ok:
     debugPrint(ctx, "root", root);
     ValkeyModule_ReplyWithSimpleString(ctx, "OK");
-    if (node) cJSON_Delete(node);
-    if (patches) cJSON_Delete(patches);
+    chargedDoc = NULL;
     ValkeyModule_ReplicateVerbatim(ctx);
     return VALKEYMODULE_OK;
 
 null:
     ValkeyModule_ReplyWithNull(ctx);
     if (node) cJSON_Delete(node);
-    if (patches) cJSON_Delete(patches);
+    chargedDoc = NULL;
     return VALKEYMODULE_OK;
 
 error:
     if (node) cJSON_Delete(node);
-    if (patches) cJSON_Delete(patches);
+    chargedDoc = NULL;
     return VALKEYMODULE_ERR;
 }
 
@@ -363,8 +1514,10 @@ int TairDocGet_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, in
     }
     ValkeyModule_AutoMemory(ctx);
 
-    int type = 0, needFree = 0;
-    const char *print = NULL, *input = NULL;
+    int type = 0;
+    const char *input = NULL;
+    size_t inputlen = 0;
+    TairDocObj *doc = NULL;
     cJSON *root = NULL, *pnode = NULL;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ);
@@ -377,46 +1530,39 @@ int TairDocGet_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, in
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = ValkeyModule_ModuleTypeGetValue(key);
+        root = doc->root;
     }
 
     if (argc >= 3) {
-        input = ValkeyModule_StringPtrLen(argv[2], NULL);
+        input = ValkeyModule_StringPtrLen(argv[2], &inputlen);
         if (input[0] == TAIRDOC_JSONPATH_START_DOLLAR) {
-            pnode = cJSONUtils_GetPath(root, input);
-            needFree = 1;
-        } else if (input[0] == TAIRDOC_JSONPOINTER_START) {
-            pnode = cJSONUtils_GetPointerCaseSensitive(root, input);
-        } else {
-            if (!strcmp(input, TAIRDOC_JSONPOINTER_ROOT)) {
-                pnode = cJSONUtils_GetPointerCaseSensitive(root, "");
-            } else if (input[0] == TAIRDOC_JSONPATH_START_DOT || input[0] == TAIRDOC_JSONPATH_START_SQUARE_BRACKETS) {
-                ValkeyModuleString *rpointer = NULL;
-                PATH_TO_POINTER(ctx, input, rpointer)
-                pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
-            } else {
-                ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_PATH_OR_POINTER_ILLEGAL);
+            const Selector *selector = compileJsonPath(input, inputlen);
+            if (selector == NULL) {
+                ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_PARSE_POINTER);
                 return VALKEYMODULE_ERR;
             }
+            replyWithJsonPath(ctx, root, selector);
+            return VALKEYMODULE_OK;
+        } else if (inputlen == 0 || input[0] == TAIRDOC_JSONPOINTER_START || input[0] == TAIRDOC_JSONPATH_START_DOT
+                   || input[0] == TAIRDOC_JSONPATH_START_SQUARE_BRACKETS) {
+            const cJSONUtils_Pointer *cpointer = NULL;
+            COMPILE_PATH(ctx, input, cpointer)
+            pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
+        } else {
+            ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_PATH_OR_POINTER_ILLEGAL);
+            return VALKEYMODULE_ERR;
         }
     } else {
         pnode = cJSONUtils_GetPointerCaseSensitive(root, TAIRDOC_JSONPOINTER_ROOT);
     }
     if (pnode == NULL) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_PARSE_POINTER);
-        goto error;
+        return VALKEYMODULE_ERR;
     }
 
-    print = cJSON_PrintUnformatted(pnode);
-    assert(print != NULL);
-    ValkeyModule_ReplyWithStringBuffer(ctx, print, strlen(print));
-    if (print) ValkeyModule_Free((void *) print);
-    if (needFree) cJSON_Delete(pnode);
+    replyWithJson(ctx, doc, pnode);
     return VALKEYMODULE_OK;
-
-error:
-    if (needFree) cJSON_Delete(pnode);
-    return VALKEYMODULE_ERR;
 }
 
 /**
@@ -438,7 +1584,9 @@ int TairDocDel_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, in
     ValkeyModuleString *jerr = NULL;
     int isRootPointer = 0, type;
     char *pointer = NULL;
-    cJSON *root = NULL, *patches = NULL;
+    TairDocObj *doc = NULL;
+    cJSON *root = NULL, *node = NULL;
+    cJSONUtils_Location loc;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ | VALKEYMODULE_WRITE);
     type = ValkeyModule_KeyType(key);
@@ -450,14 +1598,15 @@ int TairDocDel_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, in
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = getDocForWrite(key);
+        root = doc->root;
     }
 
     pointer = argc == 3 ? (char *) ValkeyModule_StringPtrLen(argv[2], NULL) : "";
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
-    isRootPointer = strcasecmp("", ValkeyModule_StringPtrLen(rpointer, NULL)) ? 0 : 1;
+    isRootPointer = IS_ROOT_POINTER(cpointer);
 
     if (isRootPointer) {
         ValkeyModule_DeleteKey(key);
@@ -466,32 +1615,24 @@ int TairDocDel_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, in
         return VALKEYMODULE_OK;
     }
 
-    // make a patch and apply
-    patches = cJSON_CreateArray();
-    if (VALKEYMODULE_OK !=
-        composePatch(patches, (const unsigned char *) "remove", ValkeyModule_StringPtrLen(rpointer, NULL), NULL)) {
-        ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_JSONOBJECT_ERROR);
-        goto error;
-    }
-    debugPrint(ctx, "patch", patches);
-
-    if (VALKEYMODULE_OK != applyPatch(root, patches, &jerr)) {
+    // detach in place, the node was allocated for doc so it is freed for doc
+    if (cJSONUtils_LocateCompiledPointer(root, cpointer, &loc) != 0 ||
+        (node = cJSONUtils_DetachAtLocation(&loc)) == NULL) {
+        patchError(13, &jerr);
         ValkeyModule_ReplyWithError(ctx, ValkeyModule_StringPtrLen(jerr, NULL));
         ValkeyModule_FreeString(NULL, jerr);
-        goto error;
+        return VALKEYMODULE_ERR;
     }
+    chargedDoc = doc;
+    cJSON_Delete(node);
+    chargedDoc = NULL;
 
     ValkeyModule_ReplyWithLongLong(ctx, 1);
-    if (patches) cJSON_Delete(patches);
-    if (!root->next && !root->prev && !root->child) {
+    if (!root->next && !root->prev && cJSON_Child(root) == NULL) {
         ValkeyModule_DeleteKey(key);
     }
     ValkeyModule_ReplicateVerbatim(ctx);
     return VALKEYMODULE_OK;
-
-error:
-    if (patches) cJSON_Delete(patches);
-    return VALKEYMODULE_ERR;
 }
 
 /**
@@ -509,6 +1650,7 @@ int TairDocType_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, i
 
     int type = 0;
     char *print = NULL, *pointer = NULL;
+    TairDocObj *doc = NULL;
     cJSON *root = NULL, *pnode = NULL;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ);
@@ -521,14 +1663,15 @@ int TairDocType_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, i
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = ValkeyModule_ModuleTypeGetValue(key);
+        root = doc->root;
     }
 
     pointer = argc == 3 ? (char *) ValkeyModule_StringPtrLen(argv[2], NULL) : "";
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+    pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
     if (pnode == NULL) {
         ValkeyModule_ReplyWithNull(ctx);
         return VALKEYMODULE_ERR;
@@ -539,55 +1682,67 @@ int TairDocType_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, i
     return VALKEYMODULE_OK;
 }
 
-int incrGenericCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, int argc, double incr) {
+/* The number JSON.INCRBY and JSON.INCRBYFLOAT add to, NULL after replying with an error. */
+static cJSON *incrGenericLookup(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, int argc) {
     char *pointer = NULL;
+    TairDocObj *doc = NULL;
     cJSON *root = NULL, *pnode = NULL;
-    double newvalue = 0;
     int type = 0;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ | VALKEYMODULE_WRITE);
     type = ValkeyModule_KeyType(key);
     if (VALKEYMODULE_KEYTYPE_EMPTY == type) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_NO_SUCKKEY_ERROR);
-        return VALKEYMODULE_ERR;
+        return NULL;
     } else {
         if (ValkeyModule_ModuleTypeGetType(key) != TairDocType) {
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
-            return VALKEYMODULE_ERR;
+            return NULL;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = getDocForWrite(key);
+        root = doc->root;
     }
 
     pointer = argc == 4 ? (char *) ValkeyModule_StringPtrLen(argv[2], NULL) : "";
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = compilePath(pointer);
+    if (cpointer == NULL) {
+        ValkeyModule_ReplyWithError(ctx, TAIRDOC_PATH_TO_POINTER_ERROR);
+        return NULL;
+    }
 
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+    pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
     if (pnode == NULL || !cJSON_IsNumber(pnode)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_NOT_NUMBER);
-        return VALKEYMODULE_ERR;
+        return NULL;
     }
+    return pnode;
+}
+
+/* Replies with the number after the increment and replicates the command. */
+static int incrGenericReply(ValkeyModuleCtx *ctx, const cJSON *pnode) {
+    replyWithJson(ctx, NULL, pnode);
+
+    ValkeyModule_ReplicateVerbatim(ctx);
+    return VALKEYMODULE_OK;
+}
 
-    newvalue = pnode->valuedouble + incr;
+static int incrGenericDouble(ValkeyModuleCtx *ctx, cJSON *pnode, double incr) {
+    double newvalue = cJSON_ValueDouble(pnode) + incr;
     if (isnan(newvalue) || isinf(newvalue)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_INCR_OVERFLOW);
         return VALKEYMODULE_ERR;
     }
 
     cJSON_SetNumberHelper(pnode, newvalue);
-    char *print = cJSON_PrintUnformatted(pnode);
-    ValkeyModule_ReplyWithStringBuffer(ctx, print, strlen(print));
-    ValkeyModule_Free(print);
-
-    ValkeyModule_ReplicateVerbatim(ctx);
-    return VALKEYMODULE_OK;
+    return incrGenericReply(ctx, pnode);
 }
 
 /**
  * JSON.INCRBY <key> [path] <value>
- * value range: [-2^53, 2^53] [-9007199254740992, 9007199254740992]
+ * value range: [-2^63, 2^63-1]
  * Increments the value stored under `path` by `value`.
  * `path` must exist path and must be a number value.
+ * Integers are added exactly, a result out of the 64 bit range is an error.
  * Reply: int number, specifically the resulting.
  */
 int TairDocIncrBy_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, int argc) {
@@ -597,13 +1752,29 @@ int TairDocIncrBy_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv,
     }
     ValkeyModule_AutoMemory(ctx);
 
-    long long incr = 0;
+    long long incr = 0, value;
+    cJSON *pnode;
     if (VALKEYMODULE_OK != ValkeyModule_StringToLongLong(argc == 4 ? argv[3] : argv[2], &incr)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_VALUE_OUTOF_RANGE);
         return VALKEYMODULE_ERR;
     }
 
-    return incrGenericCommand(ctx, argv, argc, (double) incr);
+    if ((pnode = incrGenericLookup(ctx, argv, argc)) == NULL) return VALKEYMODULE_ERR;
+    if (pnode->type & cJSON_NumberIsInt) {
+        value = pnode->valueint64;
+    } else if (pnode->valuedouble == floor(pnode->valuedouble) && fabs(pnode->valuedouble) <= 9007199254740992.0 /* 2^53 */) {
+        /* a double holding an integer, like the result of JSON.INCRBYFLOAT, turns into one */
+        value = (long long) pnode->valuedouble;
+    } else {
+        return incrGenericDouble(ctx, pnode, (double) incr);
+    }
+
+    if ((incr < 0 && value < LLONG_MIN - incr) || (incr > 0 && value > LLONG_MAX - incr)) {
+        ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_INCR_INT_OVERFLOW);
+        return VALKEYMODULE_ERR;
+    }
+    cJSON_SetInt64Value(pnode, value + incr);
+    return incrGenericReply(ctx, pnode);
 }
 
 /**
@@ -621,12 +1792,14 @@ int TairDocIncrByFloat_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **
     ValkeyModule_AutoMemory(ctx);
 
     double incr = 0.0;
+    cJSON *pnode;
     if (VALKEYMODULE_OK != ValkeyModule_StringToDouble(argc == 4 ? argv[3] : argv[2], &incr)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_VALUE_OUTOF_RANGE);
         return VALKEYMODULE_ERR;
     }
 
-    return incrGenericCommand(ctx, argv, argc, incr);
+    if ((pnode = incrGenericLookup(ctx, argv, argc)) == NULL) return VALKEYMODULE_ERR;
+    return incrGenericDouble(ctx, pnode, incr);
 }
 
 /**
@@ -645,6 +1818,7 @@ int TairDocStrAppend_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **ar
     int type;
     ValkeyModuleString *appendArg = NULL;
     char *pointer = NULL, *appendStr = NULL;
+    TairDocObj *doc = NULL;
     cJSON *root = NULL, *pnode = NULL;
     size_t oldlen, appendlen, newlen;
 
@@ -658,14 +1832,15 @@ int TairDocStrAppend_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **ar
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = getDocForWrite(key);
+        root = doc->root;
     }
 
     pointer = argc == 4 ? (char *) ValkeyModule_StringPtrLen(argv[2], NULL) : "";
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+    pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
     if (pnode == NULL || !cJSON_IsString(pnode)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_NOT_STRING);
         return VALKEYMODULE_ERR;
@@ -678,7 +1853,9 @@ int TairDocStrAppend_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **ar
         ValkeyModule_ReplyWithLongLong(ctx, (long) oldlen);
     } else {
         newlen = oldlen + appendlen;
-        pnode->valuestring = ValkeyModule_Realloc(pnode->valuestring, newlen + 1);
+        chargedDoc = doc;
+        pnode->valuestring = cJSON_realloc(pnode->valuestring, newlen + 1);
+        chargedDoc = NULL;
         memcpy(pnode->valuestring + oldlen, appendStr, appendlen);
         pnode->valuestring[newlen] = '\0';
         ValkeyModule_ReplyWithLongLong(ctx, (long) newlen);
@@ -705,6 +1882,7 @@ int TairDocStrLen_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv,
 
     int type = 0;
     char *pointer = NULL;
+    TairDocObj *doc = NULL;
     cJSON *root = NULL, *pnode = NULL;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ);
@@ -717,14 +1895,15 @@ int TairDocStrLen_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv,
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = ValkeyModule_ModuleTypeGetValue(key);
+        root = doc->root;
     }
 
     pointer = argc == 3 ? (char *) ValkeyModule_StringPtrLen(argv[2], NULL) : "";
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+    pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
     if (pnode == NULL || !cJSON_IsString(pnode)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_NOT_STRING);
         return VALKEYMODULE_ERR;
@@ -749,6 +1928,7 @@ int TairDocArrPush_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv
     int i, type;
     ValkeyModuleString *jerr = NULL;
     char *pointer = NULL;
+    TairDocObj *doc = NULL;
     cJSON *root = NULL, *pnode = NULL, *node = NULL;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ | VALKEYMODULE_WRITE);
@@ -761,19 +1941,21 @@ int TairDocArrPush_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = getDocForWrite(key);
+        root = doc->root;
     }
 
     pointer = (char *) ValkeyModule_StringPtrLen(argv[2], NULL);
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+    pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
     if (pnode == NULL || !cJSON_IsArray(pnode)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_NOT_ARRAY);
         return VALKEYMODULE_ERR;
     }
 
+    chargedDoc = doc;
     for (i = 4; i <= argc; ++i) {
         if (VALKEYMODULE_OK != createNodeFromJson(&node, ValkeyModule_StringPtrLen(argv[i - 1], NULL), &jerr)) {
             // jerr will be free in addReplyErrorSds
@@ -785,12 +1967,14 @@ int TairDocArrPush_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv
         cJSON_AddItemToArray(pnode, node);
     }
 
+    chargedDoc = NULL;
     ValkeyModule_ReplyWithLongLong(ctx, cJSON_GetArraySize(pnode));
     ValkeyModule_ReplicateVerbatim(ctx);
     return VALKEYMODULE_OK;
 
     error:
     if (node) cJSON_Delete(node);
+    chargedDoc = NULL;
     return VALKEYMODULE_ERR;
 }
 
@@ -814,6 +1998,7 @@ int TairDocArrPop_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv,
     int type = 0;
     char *pointer = NULL;
     long long index, arrlen;
+    TairDocObj *doc = NULL;
     cJSON *root = NULL, *pnode = NULL, *node = NULL;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ | VALKEYMODULE_WRITE);
@@ -826,14 +2011,15 @@ int TairDocArrPop_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv,
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = getDocForWrite(key);
+        root = doc->root;
     }
 
     pointer = (char *) ValkeyModule_StringPtrLen(argv[2], NULL);
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+    pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
     if (pnode == NULL || !cJSON_IsArray(pnode)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_NOT_ARRAY);
         return VALKEYMODULE_ERR;
@@ -854,12 +2040,12 @@ int TairDocArrPop_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv,
 
     node = cJSON_DetachItemFromArray(pnode, (int) index);
     if (node != NULL && jsonNodeType(node->type) != NULL) {
-        char *print = cJSON_PrintUnformatted(node);
-        ValkeyModule_ReplyWithStringBuffer(ctx, print, strlen(print));
-        ValkeyModule_Free(print);
+        replyWithJson(ctx, NULL, node);
+        chargedDoc = doc;
         cJSON_Delete(node);
+        chargedDoc = NULL;
 
-        if (!root->next && !root->prev && !root->child) {
+        if (!root->next && !root->prev && cJSON_Child(root) == NULL) {
             ValkeyModule_DeleteKey(key);
         }
         ValkeyModule_ReplicateVerbatim(ctx);
@@ -892,7 +2078,8 @@ int TairDocArrInsert_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **ar
     ValkeyModuleString *jerr = NULL;
     char *pointer = NULL;
     long long index, arrlen;
-    cJSON *root = NULL, *pnode = NULL, *node = NULL;
+    TairDocObj *doc = NULL;
+    cJSON *root = NULL, *pnode = NULL, *node = NULL, *items = NULL, *last = NULL;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ | VALKEYMODULE_WRITE);
     type = ValkeyModule_KeyType(key);
@@ -904,14 +2091,15 @@ int TairDocArrInsert_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **ar
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = getDocForWrite(key);
+        root = doc->root;
     }
 
     pointer = (char *) ValkeyModule_StringPtrLen(argv[2], NULL);
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+    pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
     if (pnode == NULL || !cJSON_IsArray(pnode)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_NOT_ARRAY);
         return VALKEYMODULE_ERR;
@@ -930,6 +2118,8 @@ int TairDocArrInsert_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **ar
         return VALKEYMODULE_ERR;
     }
 
+    /* parse every value first, then splice them in at once */
+    chargedDoc = doc;
     for (i = 5; i <= argc; ++i) {
         if (VALKEYMODULE_OK != createNodeFromJson(&node, ValkeyModule_StringPtrLen(argv[i - 1], NULL), &jerr)) {
             ValkeyModule_ReplyWithError(ctx, ValkeyModule_StringPtrLen(jerr, NULL));
@@ -937,16 +2127,29 @@ int TairDocArrInsert_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **ar
             goto error;
         }
 
-        cJSON_InsertItemInArray(pnode, (int) index, node);
-        index++;
+        if (items == NULL) {
+            items = node;
+        } else {
+            last->next = node;
+            node->prev = last;
+        }
+        last = node;
+        node = NULL;
     }
 
+    if (!cJSON_InsertItemsInArray(pnode, (int) index, items)) {
+        ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_ARRAY_OUTFLOW);
+        goto error;
+    }
+    chargedDoc = NULL;
     ValkeyModule_ReplyWithLongLong(ctx, cJSON_GetArraySize(pnode));
     ValkeyModule_ReplicateVerbatim(ctx);
     return VALKEYMODULE_OK;
 
     error:
     if (node) cJSON_Delete(node);
+    if (items) cJSON_Delete(items);
+    chargedDoc = NULL;
     return VALKEYMODULE_ERR;
 }
 
@@ -966,6 +2169,7 @@ int TairDocArrLen_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv,
     ValkeyModule_AutoMemory(ctx);
 
     char *pointer = NULL;
+    TairDocObj *doc = NULL;
     cJSON *root = NULL, *pnode = NULL;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ);
@@ -978,14 +2182,15 @@ int TairDocArrLen_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv,
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = ValkeyModule_ModuleTypeGetValue(key);
+        root = doc->root;
     }
 
     pointer = argc == 3 ? (char *) ValkeyModule_StringPtrLen(argv[2], NULL) : "";
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+    pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
     if (pnode == NULL || !cJSON_IsArray(pnode)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_NOT_ARRAY);
         return VALKEYMODULE_ERR;
@@ -1009,8 +2214,9 @@ int TairDocArrTrim_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv
     ValkeyModule_AutoMemory(ctx);
 
     char *pointer = NULL;
-    long long i, start, stop, arrlen, index;
-    cJSON *root = NULL, *pnode = NULL;
+    long long start, stop, arrlen;
+    TairDocObj *doc = NULL;
+    cJSON *root = NULL, *pnode = NULL, *head = NULL, *tail = NULL;
 
     ValkeyModuleKey *key = ValkeyModule_OpenKey(ctx, argv[1], VALKEYMODULE_READ | VALKEYMODULE_WRITE);
     int type = ValkeyModule_KeyType(key);
@@ -1022,14 +2228,15 @@ int TairDocArrTrim_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv
             ValkeyModule_ReplyWithError(ctx, VALKEYMODULE_ERRORMSG_WRONGTYPE);
             return VALKEYMODULE_ERR;
         }
-        root = ValkeyModule_ModuleTypeGetValue(key);
+        doc = getDocForWrite(key);
+        root = doc->root;
     }
 
     pointer = (char *) ValkeyModule_StringPtrLen(argv[2], NULL);
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
-    pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+    pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
     if (pnode == NULL || !cJSON_IsArray(pnode)) {
         ValkeyModule_ReplyWithError(ctx, TAIRDOC_ERROR_NOT_ARRAY);
         return VALKEYMODULE_ERR;
@@ -1047,18 +2254,15 @@ int TairDocArrTrim_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv
         return VALKEYMODULE_ERR;
     }
 
-    index = 0;
-    for (i = index; i < start; ++i) {
-        cJSON_DeleteItemFromArray(pnode, (int) index);
-    }
-
-    arrlen -= start;
-    index = stop - start + 1;
-    for (i = index; i < arrlen; ++i) {
-        cJSON_DeleteItemFromArray(pnode, (int) index);
-    }
+    /* cut both ends off first, then free them */
+    chargedDoc = doc;
+    tail = cJSON_DetachItemsFromArray(pnode, (int) (stop + 1), (int) (arrlen - stop - 1));
+    head = cJSON_DetachItemsFromArray(pnode, 0, (int) start);
+    cJSON_Delete(tail);
+    cJSON_Delete(head);
+    chargedDoc = NULL;
 
-    if (!root->next && !root->prev && !root->child) {
+    if (!root->next && !root->prev && cJSON_Child(root) == NULL) {
         ValkeyModule_DeleteKey(key);
     }
 
@@ -1082,13 +2286,13 @@ int TairDocMget_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, i
     ValkeyModule_AutoMemory(ctx);
 
     int j;
-    char *print = NULL;
     char *pointer = NULL;
+    TairDocObj *doc = NULL;
     cJSON *root = NULL, *pnode = NULL;
 
     pointer = (char *) ValkeyModule_StringPtrLen(argv[argc - 1], NULL);
-    ValkeyModuleString *rpointer = NULL;
-    PATH_TO_POINTER(ctx, pointer, rpointer)
+    const cJSONUtils_Pointer *cpointer = NULL;
+    COMPILE_PATH(ctx, pointer, cpointer)
 
     ValkeyModule_ReplyWithArray(ctx, argc - 2);
     for (j = 1; j < argc - 1; ++j) {
@@ -1100,75 +2304,765 @@ int TairDocMget_ValkeyCommand(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, i
             if (ValkeyModule_ModuleTypeGetType(key) != TairDocType) {
                 ValkeyModule_ReplyWithNull(ctx);
             } else {
-                root = ValkeyModule_ModuleTypeGetValue(key);
-                pnode = cJSONUtils_GetPointerCaseSensitive(root, ValkeyModule_StringPtrLen(rpointer, NULL));
+                doc = ValkeyModule_ModuleTypeGetValue(key);
+                root = doc->root;
+                pnode = cJSONUtils_GetCompiledPointer(root, cpointer);
                 if (pnode == NULL || jsonNodeType(pnode->type) == NULL) {
                     ValkeyModule_ReplyWithNull(ctx);
                     continue;
                 }
-                print = cJSON_PrintUnformatted(pnode);
-                ValkeyModule_ReplyWithStringBuffer(ctx, print, strlen(print));
-                ValkeyModule_Free(print);
+                replyWithJson(ctx, doc, pnode);
             }
         }
     }
     return VALKEYMODULE_OK;
 }
 
-/* ========================== TairDoc type methods ======================= */
+/* ========================== TairDoc binary encoding ======================= */
 
-void *TairDocTypeRdbLoad(ValkeyModuleIO *rdb, int encver) {
-    if (encver != TAIRDOC_ENC_VER) {
-        return NULL;
+/*
+ * Starting from TAIRDOC_ENC_VER 1 a document is persisted as a tagged binary
+ * tree instead of JSON text, so that loading a key does not have to format,
+ * escape and re-parse every number and string again. Every node starts with a
+ * one byte tag:
+ *
+ *   NULL / FALSE / TRUE            no payload
+ *   INT                            zigzag varint, integers and the doubles that
+ *                                  hold one exactly (|n| <= 2^53), loaded as
+ *                                  integers
+ *   DOUBLE                         8 bytes, IEEE 754 little endian
+ *   STRING / RAW                   varint length + bytes (no terminator)
+ *   ARRAY                          varint count + count nodes
+ *   OBJECT                         varint count + count (varint keylen + key + node)
+ *
+ * TAIRDOC_ENC_VER 2 keeps the same tree encoding but streams it: the writer
+ * flushes it to the RDB as a sequence of string buffers of at most
+ * TAIRDOC_BIN_CHUNK_SIZE bytes and the loader pulls the next one only when the
+ * current one is used up, so neither BGSAVE nor loading ever holds more than
+ * one chunk of a document in memory. Values may span chunk boundaries. A
+ * version 1 payload is simply a single chunk.
+ */
+#define TAIRDOC_BIN_NULL 0
+#define TAIRDOC_BIN_FALSE 1
+#define TAIRDOC_BIN_TRUE 2
+#define TAIRDOC_BIN_INT 3
+#define TAIRDOC_BIN_DOUBLE 4
+#define TAIRDOC_BIN_STRING 5
+#define TAIRDOC_BIN_ARRAY 6
+#define TAIRDOC_BIN_OBJECT 7
+#define TAIRDOC_BIN_RAW 8
+
+#define TAIRDOC_BIN_MAX_SAFE_INT 9007199254740992.0 /* 2^53 */
+#define TAIRDOC_BIN_CHUNK_SIZE (64 * 1024)
+
+typedef struct binWriter {
+    ValkeyModuleIO *rdb;
+    unsigned char *buf; /* TAIRDOC_BIN_CHUNK_SIZE bytes */
+    size_t len;
+} binWriter;
+
+typedef struct binReader {
+    ValkeyModuleIO *rdb;
+    char *chunk;        /* current chunk, owned by the reader */
+    size_t len;
+    size_t pos;
+} binReader;
+
+static void binWriterFlush(binWriter *w) {
+    if (w->len == 0) return;
+    ValkeyModule_SaveStringBuffer(w->rdb, (const char *) w->buf, w->len);
+    w->len = 0;
+}
+
+static void binWriteBytes(binWriter *w, const void *p, size_t n) {
+    const unsigned char *src = p;
+    while (n > 0) {
+        size_t room = TAIRDOC_BIN_CHUNK_SIZE - w->len;
+        size_t step = n < room ? n : room;
+        memcpy(w->buf + w->len, src, step);
+        w->len += step;
+        src += step;
+        n -= step;
+        if (w->len == TAIRDOC_BIN_CHUNK_SIZE) binWriterFlush(w);
+    }
+}
+
+static void binWriteVarint(binWriter *w, uint64_t v) {
+    unsigned char tmp[10];
+    size_t n = 0;
+    while (v >= 0x80) {
+        tmp[n++] = (unsigned char) (v | 0x80);
+        v >>= 7;
+    }
+    tmp[n++] = (unsigned char) v;
+    binWriteBytes(w, tmp, n);
+}
+
+static void binWriteTag(binWriter *w, unsigned char tag) {
+    binWriteBytes(w, &tag, 1);
+}
+
+static void binWriteString(binWriter *w, const char *s) {
+    size_t n = strlen(s);
+    binWriteVarint(w, n);
+    binWriteBytes(w, s, n);
+}
+
+static void binWriteInt(binWriter *w, int64_t i) {
+    binWriteTag(w, TAIRDOC_BIN_INT);
+    binWriteVarint(w, ((uint64_t) i << 1) ^ (uint64_t) (i >> 63));
+}
+
+static void binWriteNumber(binWriter *w, double d) {
+    if (d >= -TAIRDOC_BIN_MAX_SAFE_INT && d <= TAIRDOC_BIN_MAX_SAFE_INT
+        && d == (double) (int64_t) d && !(d == 0 && signbit(d))) {
+        binWriteInt(w, (int64_t) d);
+    } else {
+        unsigned char tmp[8];
+        uint64_t u;
+        memcpy(&u, &d, sizeof(u));
+        for (int i = 0; i < 8; i++) tmp[i] = (unsigned char) (u >> (8 * i));
+        binWriteTag(w, TAIRDOC_BIN_DOUBLE);
+        binWriteBytes(w, tmp, 8);
+    }
+}
+
+static int binWriteNode(binWriter *w, const cJSON *node) {
+    const cJSON *child = NULL;
+    uint64_t count = 0;
+
+    switch (node->type & 0xFF) {
+        case cJSON_NULL:
+            binWriteTag(w, TAIRDOC_BIN_NULL);
+            break;
+        case cJSON_False:
+            binWriteTag(w, TAIRDOC_BIN_FALSE);
+            break;
+        case cJSON_True:
+            binWriteTag(w, TAIRDOC_BIN_TRUE);
+            break;
+        case cJSON_Number:
+            if (node->type & cJSON_NumberIsInt) {
+                binWriteInt(w, node->valueint64);
+            } else {
+                binWriteNumber(w, node->valuedouble);
+            }
+            break;
+        case cJSON_String:
+        case cJSON_Raw:
+            if (node->valuestring == NULL) return VALKEYMODULE_ERR;
+            binWriteTag(w, (node->type & 0xFF) == cJSON_String ? TAIRDOC_BIN_STRING : TAIRDOC_BIN_RAW);
+            binWriteString(w, node->valuestring);
+            break;
+        case cJSON_Array:
+        case cJSON_Object:
+            for (child = node->child; child != NULL; child = child->next) count++;
+            binWriteTag(w, (node->type & 0xFF) == cJSON_Array ? TAIRDOC_BIN_ARRAY : TAIRDOC_BIN_OBJECT);
+            binWriteVarint(w, count);
+            for (child = node->child; child != NULL; child = child->next) {
+                if ((node->type & 0xFF) == cJSON_Object) {
+                    if (child->string == NULL) return VALKEYMODULE_ERR;
+                    binWriteString(w, child->string);
+                }
+                if (binWriteNode(w, child) != VALKEYMODULE_OK) return VALKEYMODULE_ERR;
+            }
+            break;
+        default:
+            return VALKEYMODULE_ERR;
+    }
+    return VALKEYMODULE_OK;
+}
+
+/* Drops the exhausted chunk and loads the next one from the RDB. */
+static int binReaderFill(binReader *r) {
+    if (r->chunk != NULL) {
+        ValkeyModule_Free(r->chunk);
+        r->chunk = NULL;
+    }
+    r->len = r->pos = 0;
+    r->chunk = ValkeyModule_LoadStringBuffer(r->rdb, &r->len);
+    if (r->chunk == NULL || r->len == 0) return VALKEYMODULE_ERR;
+    return VALKEYMODULE_OK;
+}
+
+static int binReadBytes(binReader *r, void *p, size_t n) {
+    unsigned char *dst = p;
+    while (n > 0) {
+        if (r->pos == r->len && binReaderFill(r) != VALKEYMODULE_OK) return VALKEYMODULE_ERR;
+        size_t avail = r->len - r->pos;
+        size_t step = n < avail ? n : avail;
+        memcpy(dst, r->chunk + r->pos, step);
+        r->pos += step;
+        dst += step;
+        n -= step;
+    }
+    return VALKEYMODULE_OK;
+}
+
+static int binReadByte(binReader *r, unsigned char *c) {
+    if (r->pos < r->len) {
+        *c = (unsigned char) r->chunk[r->pos++];
+        return VALKEYMODULE_OK;
+    }
+    return binReadBytes(r, c, 1);
+}
+
+static int binReadVarint(binReader *r, uint64_t *v) {
+    unsigned char c;
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (binReadByte(r, &c) != VALKEYMODULE_OK) return VALKEYMODULE_ERR;
+        result |= (uint64_t) (c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            *v = result;
+            return VALKEYMODULE_OK;
+        }
+    }
+    return VALKEYMODULE_ERR;
+}
+
+/* Returns a NUL terminated copy of the next length prefixed string, allocated
+ * with cJSON_malloc so that it can be handed over to a cJSON node as is. The
+ * length comes from the payload, so nothing is allocated ahead of the bytes
+ * that actually arrived: a string that runs past its chunk is gathered in a
+ * buffer grown as the next chunks are read, and a corrupt length fails once
+ * the payload runs short. */
+static char *binReadString(binReader *r) {
+    uint64_t n;
+    size_t got = 0, size = 0, step;
+    char *s = NULL, *tmp = NULL;
+
+    if (binReadVarint(r, &n) != VALKEYMODULE_OK || n >= SIZE_MAX) return NULL;
+    if (n <= r->len - r->pos) {
+        s = cJSON_malloc(n + 1);
+        if (s == NULL) return NULL;
+        memcpy(s, r->chunk + r->pos, n);
+        r->pos += n;
+        s[n] = '\0';
+        return s;
+    }
+
+    while (got < n) {
+        if (r->pos == r->len && binReaderFill(r) != VALKEYMODULE_OK) goto error;
+        step = r->len - r->pos;
+        if (step > n - got) step = n - got;
+        if (got + step > size) {
+            size = got + step > size * 2 ? got + step : size * 2;
+            if (size > n) size = n;
+            tmp = ValkeyModule_Realloc(tmp, size);
+        }
+        memcpy(tmp + got, r->chunk + r->pos, step);
+        r->pos += step;
+        got += step;
+    }
+    s = cJSON_malloc(n + 1);
+    if (s != NULL) {
+        memcpy(s, tmp, n);
+        s[n] = '\0';
+    }
+
+error:
+    if (tmp) ValkeyModule_Free(tmp);
+    return s;
+}
+
+/* depth is the number of containers around the node, limited like the text
+ * parser's nesting so a crafted payload can't run the stack out. */
+static cJSON *binReadNode(binReader *r, int depth) {
+    unsigned char tag, tmp[8];
+    uint64_t u = 0, count = 0, members;
+    double d;
+    cJSON *node = NULL, *child = NULL;
+
+    if (binReadByte(r, &tag) != VALKEYMODULE_OK) return NULL;
+
+    switch (tag) {
+        case TAIRDOC_BIN_NULL:
+            return cJSON_CreateNull();
+        case TAIRDOC_BIN_FALSE:
+            return cJSON_CreateFalse();
+        case TAIRDOC_BIN_TRUE:
+            return cJSON_CreateTrue();
+        case TAIRDOC_BIN_INT:
+            if (binReadVarint(r, &u) != VALKEYMODULE_OK) return NULL;
+            return cJSON_CreateInt64((int64_t) ((u >> 1) ^ (~(u & 1) + 1)));
+        case TAIRDOC_BIN_DOUBLE:
+            if (binReadBytes(r, tmp, 8) != VALKEYMODULE_OK) return NULL;
+            for (int i = 0; i < 8; i++) u |= (uint64_t) tmp[i] << (8 * i);
+            memcpy(&d, &u, sizeof(d));
+            return cJSON_CreateNumber(d);
+        case TAIRDOC_BIN_STRING:
+        case TAIRDOC_BIN_RAW:
+            node = cJSON_CreateNull();
+            if (node == NULL) return NULL;
+            node->type = tag == TAIRDOC_BIN_STRING ? cJSON_String : cJSON_Raw;
+            node->valuestring = binReadString(r);
+            if (node->valuestring == NULL) goto error;
+            return node;
+        case TAIRDOC_BIN_ARRAY:
+        case TAIRDOC_BIN_OBJECT:
+            if (depth >= CJSON_NESTING_LIMIT) return NULL;
+            node = tag == TAIRDOC_BIN_ARRAY ? cJSON_CreateArray() : cJSON_CreateObject();
+            if (node == NULL || binReadVarint(r, &count) != VALKEYMODULE_OK) goto error;
+            members = count;
+            while (count--) {
+                char *key = NULL, *shared;
+                if (tag == TAIRDOC_BIN_OBJECT && (key = binReadString(r)) == NULL) goto error;
+                child = binReadNode(r, depth + 1);
+                if (child == NULL) {
+                    cJSON_free(key);
+                    goto error;
+                }
+                child->string = key;
+                if (key && (shared = tairDocInternKey(key)) != NULL) {
+                    cJSON_free(key);
+                    child->string = shared;
+                    child->type |= cJSON_StringIsConst;
+                }
+                cJSON_AddItemToArray(node, child);
+            }
+            if (members >= CJSON_INDEX_MIN_MEMBERS) tairDocIndexBuild(node);
+            return node;
+        default:
+            return NULL;
+    }
+
+error:
+    cJSON_Delete(node);
+    return NULL;
+}
+
+/* ========================== TairDoc AOF rewrite ======================= */
+
+/*
+ * A document whose JSON text stays below TAIRDOC_AOF_CHUNK_SIZE is rewritten
+ * as a single JSON.SET, as before. Bigger ones are rebuilt piecewise so that
+ * neither the rewrite nor the replay of any single command has to deal with
+ * the whole document:
+ *
+ *   - a big container is created empty and then filled in, objects with one
+ *     JSON.SET per member, arrays with JSON.ARRAPPEND batches of at most
+ *     TAIRDOC_AOF_CHUNK_SIZE bytes;
+ *   - a big string is created empty and grown with JSON.STRAPPEND chunks;
+ *   - a big object with two members of the same name is still rewritten
+ *     whole, setting its members one by one would merge them.
+ *
+ * Sizes are estimated from the tree (escaping is not accounted for), so the
+ * bound is approximate.
+ */
+#define TAIRDOC_AOF_CHUNK_SIZE (64 * 1024)
+
+typedef struct aofRewriter {
+    ValkeyModuleIO *aof;
+    ValkeyModuleString *key;
+    char *pointer;      /* JSON pointer of the node being emitted */
+    size_t len;
+    size_t cap;
+} aofRewriter;
+
+/* Estimates the length of node's JSON text, stops counting once it goes
+ * beyond limit. */
+static size_t jsonLengthEstimate(const cJSON *node, size_t limit) {
+    const cJSON *child;
+    size_t size = 0;
+
+    switch (node->type & 0xFF) {
+        case cJSON_String:
+            return strlen(node->valuestring) + 2;
+        case cJSON_Raw:
+            return strlen(node->valuestring);
+        case cJSON_Number:
+            return 24;
+        case cJSON_Array:
+        case cJSON_Object:
+            size = 2;
+            for (child = node->child; child != NULL && size <= limit; child = child->next) {
+                if (child->string) size += strlen(child->string) + 3;
+                size += jsonLengthEstimate(child, limit - size) + 1;
+            }
+            return size;
+        default:
+            return 5;
+    }
+}
+
+static size_t aofPointerPush(aofRewriter *rw, const char *token, size_t tokenlen) {
+    size_t oldlen = rw->len, i;
+    /* worst case every character is escaped, plus '/' and '\0' */
+    if (rw->len + tokenlen * 2 + 2 > rw->cap) {
+        rw->cap = (rw->len + tokenlen * 2 + 2) * 2;
+        rw->pointer = ValkeyModule_Realloc(rw->pointer, rw->cap);
+    }
+    rw->pointer[rw->len++] = '/';
+    for (i = 0; i < tokenlen; i++) {
+        if (token[i] == '~' || token[i] == '/') {
+            rw->pointer[rw->len++] = '~';
+            rw->pointer[rw->len++] = token[i] == '~' ? '0' : '1';
+        } else {
+            rw->pointer[rw->len++] = token[i];
+        }
+    }
+    rw->pointer[rw->len] = '\0';
+    return oldlen;
+}
+
+static void aofPointerPop(aofRewriter *rw, size_t oldlen) {
+    rw->len = oldlen;
+    rw->pointer[rw->len] = '\0';
+}
+
+static const char *jsonEmptyValue(const cJSON *node) {
+    if (cJSON_IsArray(node)) return "[]";
+    if (cJSON_IsObject(node)) return "{}";
+    return "\"\"";
+}
+
+static int compareMemberNames(const void *a, const void *b) {
+    return strcmp(*(const char *const *) a, *(const char *const *) b);
+}
+
+/* Whether each member of object can be rewritten with a JSON.SET of its own.
+ * Not when two members share a name, the pointer only reaches the first. */
+static int aofMembersSettable(const cJSON *object) {
+    const cJSON *child;
+    const char **names;
+    size_t count = 0, i;
+    int settable = 1;
+
+    // an object with duplicate names is never indexed
+    if (object->type & cJSON_IsIndexed) return 1;
+    for (child = object->child; child != NULL; child = child->next) count++;
+    if (count < 2) return 1;
+    names = ValkeyModule_Alloc(count * sizeof(*names));
+    for (child = object->child, i = 0; child != NULL; child = child->next) names[i++] = child->string;
+    qsort(names, count, sizeof(*names), compareMemberNames);
+    for (i = 1; i < count && settable; i++) {
+        if (!strcmp(names[i - 1], names[i])) settable = 0;
+    }
+    ValkeyModule_Free(names);
+    return settable;
+}
+
+static void aofFillNode(aofRewriter *rw, const cJSON *node);
+
+static void aofSetNode(aofRewriter *rw, const cJSON *node) {
+    if ((!cJSON_IsString(node) && !cJSON_IsArray(node) && !cJSON_IsObject(node))
+        || jsonLengthEstimate(node, TAIRDOC_AOF_CHUNK_SIZE) <= TAIRDOC_AOF_CHUNK_SIZE
+        || (cJSON_IsObject(node) && !aofMembersSettable(node))) {
+        printJson(node, 0);
+        ValkeyModule_EmitAOF(rw->aof, "JSON.SET", "scc", rw->key, rw->pointer, printBuffer);
+        printDone();
+        return;
+    }
+    ValkeyModule_EmitAOF(rw->aof, "JSON.SET", "scc", rw->key, rw->pointer, jsonEmptyValue(node));
+    aofFillNode(rw, node);
+}
+
+/* Emits the array batch collected so far. */
+static void aofFlushArrAppend(aofRewriter *rw, ValkeyModuleString **batch, size_t *count, size_t *bytes) {
+    size_t i;
+    if (*count == 0) return;
+    ValkeyModule_EmitAOF(rw->aof, "JSON.ARRAPPEND", "scv", rw->key, rw->pointer, batch, *count);
+    for (i = 0; i < *count; i++) ValkeyModule_FreeString(NULL, batch[i]);
+    *count = 0;
+    *bytes = 0;
+}
+
+static void aofFillArray(aofRewriter *rw, const cJSON *node) {
+    ValkeyModuleString *batch[128];
+    size_t count = 0, bytes = 0, index = 0, oldlen;
+    char token[32];
+    const cJSON *child;
+
+    for (child = node->child; child != NULL; child = child->next, index++) {
+        if ((cJSON_IsString(child) || cJSON_IsArray(child) || cJSON_IsObject(child))
+            && jsonLengthEstimate(child, TAIRDOC_AOF_CHUNK_SIZE) > TAIRDOC_AOF_CHUNK_SIZE) {
+            aofFlushArrAppend(rw, batch, &count, &bytes);
+            ValkeyModule_EmitAOF(rw->aof, "JSON.ARRAPPEND", "scc", rw->key, rw->pointer, jsonEmptyValue(child));
+            oldlen = aofPointerPush(rw, token, (size_t) snprintf(token, sizeof(token), "%zu", index));
+            aofFillNode(rw, child);
+            aofPointerPop(rw, oldlen);
+            continue;
+        }
+
+        size_t len = printJson(child, 0);
+        if (count == sizeof(batch) / sizeof(batch[0]) || (count > 0 && bytes + len > TAIRDOC_AOF_CHUNK_SIZE)) {
+            aofFlushArrAppend(rw, batch, &count, &bytes);
+        }
+        batch[count++] = ValkeyModule_CreateString(NULL, printBuffer, len);
+        bytes += len;
+        printDone();
     }
+    aofFlushArrAppend(rw, batch, &count, &bytes);
+}
+
+/* Fills in the contents of node, which was already emitted empty. */
+static void aofFillNode(aofRewriter *rw, const cJSON *node) {
+    const cJSON *child;
+    size_t oldlen, len, off, step;
+
+    if (cJSON_IsString(node)) {
+        len = strlen(node->valuestring);
+        for (off = 0; off < len; off += step) {
+            step = len - off < TAIRDOC_AOF_CHUNK_SIZE ? len - off : TAIRDOC_AOF_CHUNK_SIZE;
+            ValkeyModule_EmitAOF(rw->aof, "JSON.STRAPPEND", "scb", rw->key, rw->pointer,
+                                 node->valuestring + off, step);
+        }
+    } else if (cJSON_IsArray(node)) {
+        aofFillArray(rw, node);
+    } else if (cJSON_IsObject(node)) {
+        for (child = node->child; child != NULL; child = child->next) {
+            oldlen = aofPointerPush(rw, child->string, strlen(child->string));
+            aofSetNode(rw, child);
+            aofPointerPop(rw, oldlen);
+        }
+    }
+}
+
+/* ========================== TairDoc type methods ======================= */
 
+/* Loads a document saved by TAIRDOC_ENC_VER 0, which was plain JSON text. */
+static cJSON *rdbLoadJsonText(ValkeyModuleIO *rdb, TairDocObj *doc) {
     cJSON *root = NULL;
     char *json = NULL;
     size_t len = 0;
 
     json = ValkeyModule_LoadStringBuffer(rdb, &len);
     if (json != NULL && len != 0) {
-        root = cJSON_Parse((const char *) json);
+        if (len >= TAIRDOC_ARENA_MIN_INPUT) arenaCreate(doc);
+        chargedDoc = doc;
+        root = parseJson((const char *) json, 0);
+        chargedDoc = NULL;
         ValkeyModule_Free(json);
         return root;
     } else {
         ValkeyModule_LogIOError(
                 rdb, "warning",
-                "TairDocTypeRdbLoad load json return NULL, TAIRDOC_ENC_VER: %d", TAIRDOC_ENC_VER);
+                "TairDocTypeRdbLoad load json return NULL, encver: 0");
     }
     return NULL;
 }
 
+/* Loads a document saved by TAIRDOC_ENC_VER 1 or 2, version 1 is just a
+ * single chunk. A full first chunk is enough to tell a large document. */
+static cJSON *rdbLoadBinary(ValkeyModuleIO *rdb, TairDocObj *doc) {
+    cJSON *root = NULL;
+    binReader r = {rdb, NULL, 0, 0};
+
+    if (binReaderFill(&r) == VALKEYMODULE_OK) {
+        if (r.len >= TAIRDOC_ARENA_MIN_INPUT) arenaCreate(doc);
+        chargedDoc = doc;
+        root = binReadNode(&r, 0);
+        if (root != NULL && r.pos != r.len) {
+            cJSON_Delete(root);
+            root = NULL;
+        }
+        chargedDoc = NULL;
+    }
+    if (r.chunk != NULL) ValkeyModule_Free(r.chunk);
+    if (root == NULL) {
+        ValkeyModule_LogIOError(
+                rdb, "warning",
+                "TairDocTypeRdbLoad decode json return NULL, TAIRDOC_ENC_VER: %d", TAIRDOC_ENC_VER);
+    }
+    return root;
+}
+
+void *TairDocTypeRdbLoad(ValkeyModuleIO *rdb, int encver) {
+    if (encver > TAIRDOC_ENC_VER) {
+        return NULL;
+    }
+
+    TairDocObj *doc = createTairDocObj();
+    doc->root = encver == 0 ? rdbLoadJsonText(rdb, doc) : rdbLoadBinary(rdb, doc);
+    if (doc->root == NULL) {
+        releaseTairDocObj(doc);
+        return NULL;
+    }
+    return doc;
+}
+
 void TairDocTypeRdbSave(ValkeyModuleIO *rdb, void *value) {
-    cJSON *root = value;
-    char *serialize = cJSON_PrintUnformatted(root);
-    if (serialize != NULL) {
-        ValkeyModule_SaveStringBuffer(rdb, serialize, strlen(serialize) + 1);
-        ValkeyModule_Free(serialize);
+    cJSON *root = ((TairDocObj *) value)->root;
+    binWriter w = {rdb, ValkeyModule_Alloc(TAIRDOC_BIN_CHUNK_SIZE), 0};
+    if (binWriteNode(&w, root) == VALKEYMODULE_OK) {
+        binWriterFlush(&w);
     } else {
         ValkeyModule_LogIOError(
                 rdb, "warning",
-                "TairDocTypeRdbSave serialize json return NULL, TAIRDOC_ENC_VER: %d", TAIRDOC_ENC_VER);
+                "TairDocTypeRdbSave encode json return error, TAIRDOC_ENC_VER: %d", TAIRDOC_ENC_VER);
     }
+    ValkeyModule_Free(w.buf);
 }
 
 void TairDocTypeAofRewrite(ValkeyModuleIO *aof, ValkeyModuleString *key, void *value) {
-    cJSON *root = value;
+    cJSON *root = ((TairDocObj *) value)->root;
     if (root != NULL) {
-        char *serialize = cJSON_PrintUnformatted(root);
-        ValkeyModule_EmitAOF(aof, "JSON.SET", "scc", key, "", serialize);
-        ValkeyModule_Free(serialize);
+        aofRewriter rw = {aof, key, ValkeyModule_Alloc(64), 0, 64};
+        rw.pointer[0] = '\0';
+        aofSetNode(&rw, root);
+        ValkeyModule_Free(rw.pointer);
     }
 }
 
 size_t TairDocTypeMemUsage(const void *value) {
-    VALKEYMODULE_NOT_USED(value);
-    return 0;
+    const TairDocObj *doc = value;
+    return sizeof(*doc) + doc->memory + (doc->cachedText ? ValkeyModule_MallocSize(doc->cachedText) : 0);
 }
 
+/* May run in the lazyfree thread, see TairDocTypeFreeEffort(). */
 void TairDocTypeFree(void *value) {
-    cJSON *root = value;
-    cJSON_Delete(root);
+    releaseTairDocObj(value);
+}
+
+/*
+ * Active defrag walks the tree in pre-order and moves every node, key and
+ * value string with ValkeyModule_DefragAlloc. Large documents are handled by
+ * Valkey's late defrag: when DefragShouldStop() asks us to yield, the walk
+ * stack is kept in the document and the next call resumes from it. Any write
+ * to the document in between drops the stack (see tairDocAlloc()) and the
+ * walk starts over, so it never follows a pointer that may have been freed.
+ *
+ * A relocated block keeps its size class, so the memory counters do not
+ * change. Slots of an arena never move, a document in an arena only walks
+ * its tree when it holds large blocks.
+ */
+typedef struct tairDocDefragState {
+    cJSON **parents;    /* containers being walked, outermost first */
+    cJSON **next;       /* next child to move in each of them */
+    size_t depth;
+    size_t cap;
+} tairDocDefragState;
+
+static void dropDefragState(TairDocObj *doc) {
+    tairDocDefragState *state = doc->defrag;
+    if (state == NULL) return;
+    ValkeyModule_Free(state->parents);
+    ValkeyModule_Free(state->next);
+    ValkeyModule_Free(state);
+    doc->defrag = NULL;
+}
+
+static void defragStatePush(tairDocDefragState *state, cJSON *parent) {
+    if (state->depth == state->cap) {
+        state->cap = state->cap ? state->cap * 2 : 16;
+        state->parents = ValkeyModule_Realloc(state->parents, sizeof(cJSON *) * state->cap);
+        state->next = ValkeyModule_Realloc(state->next, sizeof(cJSON *) * state->cap);
+    }
+    state->parents[state->depth] = parent;
+    state->next[state->depth] = parent->child;
+    state->depth++;
+}
+
+/* Moves a block owned by doc, returns its new address or NULL if it stays. */
+static void *defragBlock(ValkeyModuleDefragCtx *ctx, TairDocObj *doc, void *ptr) {
+    arenaLarge *large;
+    if (doc->arena == NULL) return ValkeyModule_DefragAlloc(ctx, ptr);
+    if (arenaFindSlab(doc->arena, ptr) != NULL) return NULL;
+    large = ValkeyModule_DefragAlloc(ctx, (arenaLarge *) ptr - 1);
+    return large ? arenaRelink(doc->arena, large) : NULL;
+}
+
+/* Moves the strings owned by node. */
+static void defragItemStrings(ValkeyModuleDefragCtx *ctx, TairDocObj *doc, cJSON *node) {
+    char *moved;
+    if (node->type & cJSON_IsReference) return;
+    if (cJSON_ValueString(node) && (moved = defragBlock(ctx, doc, node->valuestring))) {
+        node->valuestring = moved;
+    }
+    if (node->string && !(node->type & cJSON_StringIsConst)
+        && (moved = defragBlock(ctx, doc, node->string))) {
+        node->string = moved;
+    }
+}
+
+/* Moves child, a member of parent, and relinks its neighbours. */
+static cJSON *defragChild(ValkeyModuleDefragCtx *ctx, TairDocObj *doc, cJSON *parent, cJSON *child) {
+    int first = parent->child == child, last = child->next == NULL;
+    cJSON *moved = defragBlock(ctx, doc, child);
+    if (moved != NULL) {
+        if ((parent->type | moved->type) & cJSON_IsIndexed) nodeIndexMoved(parent, child, moved);
+        child = moved;
+        if (first) {
+            parent->child = child;
+        } else {
+            child->prev->next = child;
+        }
+        if (!last) child->next->prev = child;
+        /* the head's prev points at the tail */
+        if (last) parent->child->prev = child;
+    }
+    defragItemStrings(ctx, doc, child);
+    return child;
+}
+
+int TairDocTypeDefrag(ValkeyModuleDefragCtx *ctx, ValkeyModuleString *key, void **value) {
+    VALKEYMODULE_NOT_USED(key);
+    TairDocObj *doc = *value, *moved;
+    tairDocDefragState *state;
+    unsigned long cursor = 0;
+    cJSON *node;
+
+    ValkeyModule_DefragCursorGet(ctx, &cursor);
+    if (cursor == 0 || doc->defrag == NULL) {
+        /* Start a new walk with the document and the root itself. The
+         * cached node is about to move, its text goes. */
+        dropDefragState(doc);
+        dropPrintCache(doc);
+        if ((moved = ValkeyModule_DefragAlloc(ctx, doc))) {
+            nodeIndex *idx;
+            *value = doc = moved;
+            for (idx = doc->indexes; idx != NULL; idx = idx->docnext) idx->doc = doc;
+        }
+        if (doc->keys) {
+            tairDocKeys *keys;
+            if ((keys = ValkeyModule_DefragAlloc(ctx, doc->keys))) doc->keys = keys;
+        }
+        if (doc->arena) {
+            tairDocArena *arena;
+            arenaSlab *slabs;
+            if ((arena = ValkeyModule_DefragAlloc(ctx, doc->arena))) doc->arena = arena;
+            if (doc->arena->slabs && (slabs = ValkeyModule_DefragAlloc(ctx, doc->arena->slabs))) {
+                doc->arena->slabs = slabs;
+            }
+            if (doc->arena->large == NULL) return 0;
+        }
+        if ((node = defragBlock(ctx, doc, doc->root))) {
+            if (node->type & cJSON_IsIndexed) nodeIndexMoved(NULL, doc->root, node);
+            doc->root = node;
+        }
+        defragItemStrings(ctx, doc, doc->root);
+
+        state = ValkeyModule_Alloc(sizeof(*state));
+        state->parents = state->next = NULL;
+        state->depth = state->cap = 0;
+        doc->defrag = state;
+        if (!(doc->root->type & cJSON_IsReference) && cJSON_Child(doc->root)) defragStatePush(state, doc->root);
+        cursor = 0;
+    }
+    state = doc->defrag;
+
+    while (state->depth > 0) {
+        if ((++cursor & 63) == 0 && ValkeyModule_DefragShouldStop(ctx)) {
+            ValkeyModule_DefragCursorSet(ctx, cursor);
+            return 1;
+        }
+
+        size_t top = state->depth - 1;
+        if (state->next[top] == NULL) {
+            state->depth--;
+            continue;
+        }
+        node = defragChild(ctx, doc, state->parents[top], state->next[top]);
+        state->next[top] = node->next;
+        if ((cJSON_IsArray(node) || cJSON_IsObject(node)) && node->child != NULL
+            && !(node->type & cJSON_IsReference)) {
+            defragStatePush(state, node);
+        }
+    }
+
+    dropDefragState(doc);
+    return 0;
 }
 
 void TairDocTypeDigest(ValkeyModuleDigest *md, void *value) {
@@ -1176,10 +3070,55 @@ void TairDocTypeDigest(ValkeyModuleDigest *md, void *value) {
     VALKEYMODULE_NOT_USED(value);
 }
 
+/* The effort of freeing a document is the number of blocks to release: every
+ * node and string, or the slabs and large blocks of its arena. Large documents
+ * are then handed to the lazyfree thread. */
 static size_t TairDocTypeFreeEffort(ValkeyModuleString * key, const void *value) {
     VALKEYMODULE_NOT_USED(key);
-    VALKEYMODULE_NOT_USED(value);
-    return 0;
+    const TairDocObj *doc = value;
+    return doc->allocs;
+}
+
+/* The cache counters, in the printcache, selectorcache and pointercache sections of INFO. */
+static void TairDocInfo(ValkeyModuleInfoCtx *ctx, int for_crash_report) {
+    VALKEYMODULE_NOT_USED(for_crash_report);
+    ValkeyModule_InfoAddSection(ctx, "printcache");
+    ValkeyModule_InfoAddFieldULongLong(ctx, "print_cache_hits", printCacheHits);
+    ValkeyModule_InfoAddFieldULongLong(ctx, "print_cache_misses", printCacheMisses);
+    ValkeyModule_InfoAddSection(ctx, "selectorcache");
+    ValkeyModule_InfoAddFieldULongLong(ctx, "selector_cache_hits", selectorCache.hits);
+    ValkeyModule_InfoAddFieldULongLong(ctx, "selector_cache_misses", selectorCache.misses);
+    ValkeyModule_InfoAddFieldULongLong(ctx, "selector_cache_paths", selectorCache.count);
+    ValkeyModule_InfoAddSection(ctx, "pointercache");
+    ValkeyModule_InfoAddFieldULongLong(ctx, "pointer_cache_hits", pointerCache.hits);
+    ValkeyModule_InfoAddFieldULongLong(ctx, "pointer_cache_misses", pointerCache.misses);
+    ValkeyModule_InfoAddFieldULongLong(ctx, "pointer_cache_paths", pointerCache.count);
+}
+
+/* Load arguments come in name value pairs: print-cache-max <bytes>,
+ * selector-cache-max <paths> and pointer-cache-max <paths>. */
+static int parseModuleArgs(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, int argc) {
+    long long value;
+    int j;
+
+    for (j = 0; j < argc; j += 2) {
+        const char *name = ValkeyModule_StringPtrLen(argv[j], NULL);
+        if (j + 1 >= argc || ValkeyModule_StringToLongLong(argv[j + 1], &value) != VALKEYMODULE_OK || value < 0) {
+            ValkeyModule_Log(ctx, "warning", "invalid value for module argument '%s'", name);
+            return VALKEYMODULE_ERR;
+        }
+        if (!strcasecmp(name, "print-cache-max")) {
+            printCacheMax = (size_t) value;
+        } else if (!strcasecmp(name, "selector-cache-max")) {
+            selectorCache.max = (size_t) value;
+        } else if (!strcasecmp(name, "pointer-cache-max")) {
+            pointerCache.max = (size_t) value;
+        } else {
+            ValkeyModule_Log(ctx, "warning", "invalid module argument '%s'", name);
+            return VALKEYMODULE_ERR;
+        }
+    }
+    return VALKEYMODULE_OK;
 }
 
 int Module_CreateCommands(ValkeyModuleCtx *ctx) {
@@ -1222,12 +3161,10 @@ int Module_CreateCommands(ValkeyModuleCtx *ctx) {
 /* This function must be present on each Valkey module. It is used in order to
  * register the commands into the Valkey server. */
 int ValkeyModule_OnLoad(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, int argc) {
-    VALKEYMODULE_NOT_USED(argv);
-    VALKEYMODULE_NOT_USED(argc);
-
     if (ValkeyModule_Init(ctx, "tair-json", 1, VALKEYMODULE_APIVER_1)
         == VALKEYMODULE_ERR)
         return VALKEYMODULE_ERR;
+    if (parseModuleArgs(ctx, argv, argc) == VALKEYMODULE_ERR) return VALKEYMODULE_ERR;
 
     ValkeyModuleTypeMethods tm = {
             .version = VALKEYMODULE_TYPE_METHOD_VERSION,
@@ -1238,20 +3175,33 @@ int ValkeyModule_OnLoad(ValkeyModuleCtx *ctx, ValkeyModuleString **argv, int arg
             .free = TairDocTypeFree,
             .digest = TairDocTypeDigest,
             .free_effort = TairDocTypeFreeEffort,
+            .defrag = TairDocTypeDefrag,
     };
-    TairDocType = ValkeyModule_CreateDataType(ctx, "tair-json", 0, &tm);
+    TairDocType = ValkeyModule_CreateDataType(ctx, "tair-json", TAIRDOC_ENC_VER, &tm);
     if (TairDocType == NULL) return VALKEYMODULE_ERR;
 
     // Init cJSON_Hooks
     cJSON_Hooks TairDoc_hooks = {
-            ValkeyModule_Alloc,
-            ValkeyModule_Free,
-            ValkeyModule_Realloc,
+            tairDocAlloc,
+            tairDocFree,
+            tairDocRealloc,
     };
     cJSON_InitHooks(&TairDoc_hooks);
+    cJSON_InitInternHook(tairDocInternKey);
+    cJSON_IndexHooks TairDoc_index_hooks = {
+            tairDocIndexBuild,
+            tairDocIndexFind,
+            tairDocIndexAt,
+            tairDocIndexSize,
+            tairDocIndexLink,
+            tairDocIndexUnlink,
+            tairDocIndexDrop,
+    };
+    cJSON_InitIndexHooks(&TairDoc_index_hooks);
 
     // Create Commands
     if (VALKEYMODULE_ERR == Module_CreateCommands(ctx)) return VALKEYMODULE_ERR;
+    if (ValkeyModule_RegisterInfoFunc(ctx, TairDocInfo) == VALKEYMODULE_ERR) return VALKEYMODULE_ERR;
 
     return VALKEYMODULE_OK;
 }
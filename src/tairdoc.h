@@ -1,6 +1,8 @@
 #ifndef TAIRDOC_H
 #define TAIRDOC_H
 
+#include <stddef.h>
+
 #define EX_OBJ_SET_NO_FLAGS 0
 #define EX_OBJ_SET_NX (1<<0)            /* Set if key not exists. */
 #define EX_OBJ_SET_XX (1<<1)            /* Set if key exists. */
@@ -15,6 +17,7 @@
 #define TAIRDOC_ERROR_NOT_STRING "ERR node not exists or not string type"
 #define TAIRDOC_ERROR_NOT_ARRAY "ERR node not exists or not array type"
 #define TAIRDOC_ERROR_INCR_OVERFLOW "ERR increment would produce NaN or Infinity"
+#define TAIRDOC_ERROR_INCR_INT_OVERFLOW "ERR increment or decrement would overflow"
 #define TAIRDOC_ERROR_CREATR_NODE "ERR create node error (probably OOM)"
 #define TAIRDOC_ERROR_ARRAY_OUTFLOW "ERR array index outflow"
 #define TAIRDOC_ERROR_GET_FROMAT_ERROR "ERR format error, must be yaml or xml"
@@ -30,4 +33,19 @@
 #define TAIRDOC_JSONPATH_ROOT "$"
 #define TAIRDOC_JSONPOINTER_ROOT ""
 
+/* The value of a tair-json key. */
+typedef struct TairDocObj {
+    struct cJSON *root;
+    size_t memory;      /* bytes allocated for root, see tairDocAlloc() */
+    size_t allocs;      /* number of live allocations owned by root */
+    struct tairDocDefragState *defrag; /* walk in progress, see TairDocTypeDefrag() */
+    struct tairDocArena *arena;        /* NULL when nodes are allocated one by one */
+    struct tairDocKeys *keys;          /* member names shared with other documents */
+    struct nodeIndex *indexes;         /* member indexes of the wide arrays and objects of root */
+    size_t printed;                    /* length root printed to last time, sizes the next print */
+    const struct cJSON *cached;        /* node printed last, see replyWithJson() */
+    char *cachedText;                  /* its text once it was printed twice with no write in between */
+    size_t cachedLen;
+} TairDocObj;
+
 #endif // TAIRDOC_H
@@ -36,6 +36,24 @@ start_server {tags {"tairdoc"} overrides {bind 0.0.0.0}} {
         assert_match {*ERR json lexer error at*} $err
     }
 
+    test {json.set large json} {
+        r del tairdockey
+        set items {}
+        for {set i 0} {$i < 20000} {incr i} {
+            lappend items "{\"id\": $i, \"name\": \"item \\\"$i\\\"\",\n  \"tags\": \[\"a\", \"b\"\]}"
+        }
+        assert_equal "OK" [r json.set tairdockey "" "\[[join $items ,\n]\]"]
+        assert_equal 20000 [r json.arrlen tairdockey ""]
+        assert_equal {"item \"19999\""} [r json.get tairdockey /19999/name]
+        assert_equal {{"id":7,"name":"item \"7\"","tags":["a","b"]}} [r json.get tairdockey /7]
+
+        catch {r json.set tairdockey "" "\[[join $items ,\n], 1x, 2\]"} err
+        assert_match {*ERR json lexer error at position 'x, 2\]'*} $err
+        catch {r json.set tairdockey "" "\[[join $items ,\n]"} err
+        assert_match {*ERR json lexer error at position ''*} $err
+        assert_equal 20000 [r json.arrlen tairdockey ""]
+    }
+
     test {json.set key not exists} {
         r del tairdockey
         assert_equal "" [r json.get tairdockey]
@@ -53,6 +71,7 @@ start_server {tags {"tairdoc"} overrides {bind 0.0.0.0}} {
         assert_equal "OK" [r json.set tairdockey "" {{"foo": null}}]
         assert_equal "OK" [r json.set tairdockey {/foo} {1}]
         assert_equal {{"foo":1}} [r json.get tairdockey]
+        assert_equal {{"foo":1}} [r json.get tairdockey ""]
     }
 
     test {add replaces any existing field nx} {
@@ -277,6 +296,27 @@ start_server {tags {"tairdoc"} overrides {bind 0.0.0.0}} {
         assert_equal {{"foo":"bar","FOO":"BAR"}} [r json.get tairdockey]
     }
 
+    test {json.set resolves the path once for xx, nx and indexed members} {
+        r del tairdockey
+        set members {}
+        for {set i 0} {$i < 100} {incr i} {
+            lappend members "\"k$i\":$i"
+        }
+        assert_equal "OK" [r json.set tairdockey "" "{[join $members ,],\"a/b\":{}}"]
+        assert_equal "" [r json.set tairdockey /nope/k {1} xx]
+        assert_equal "" [r json.set tairdockey /k7 {"x"} nx]
+        assert_equal "OK" [r json.set tairdockey /k7 {"x"} xx]
+        assert_equal {"x"} [r json.get tairdockey /k7]
+        assert_equal "OK" [r json.set tairdockey /a~1b/c~0 {1} nx]
+        assert_equal {{"c~":1}} [r json.get tairdockey /a~1b]
+        assert_equal 1 [r json.del tairdockey /k7]
+        assert_equal "OK" [r json.set tairdockey /k7 {7} nx]
+        assert_equal 7 [r json.get tairdockey /k7]
+        assert_equal 99 [r json.get tairdockey /k99]
+        catch {r json.set tairdockey /nope/k {1}} err
+        assert_match {*ERR could not find object to add*} $err
+    }
+
     # replace
     test {tairdoc} {
         r del tairdockey
@@ -542,24 +582,41 @@ start_server {tags {"tairdoc"} overrides {bind 0.0.0.0}} {
     }
 
     test {json.incrby max} {
-        # range is [-2^53, 2^53] [-9007199254740992, 9007199254740992]
+        # range is [-2^63, 2^63-1] [-9223372036854775808, 9223372036854775807]
         r del tairdockey
         assert_equal "OK" [r json.set tairdockey "" {9007199254740991}]
-        assert_equal "9.00719925474099e+15" [r json.incrby tairdockey 1]
+        assert_equal "9007199254740992" [r json.incrby tairdockey 1]
+        assert_equal "9007199254740993" [r json.incrby tairdockey 1]
+        assert_equal "OK" [r json.set tairdockey "" {9223372036854775806}]
+        assert_equal "9223372036854775807" [r json.incrby tairdockey 1]
     }
 
     test {json.incrby min} {
-        # range is [-2^53, 2^53] [-9007199254740992, 9007199254740992]
+        # range is [-2^63, 2^63-1] [-9223372036854775808, 9223372036854775807]
         r del tairdockey
         assert_equal "OK" [r json.set tairdockey "" {-9007199254740991}]
-        assert_equal "-9.00719925474099e+15" [r json.incrby tairdockey -1]
+        assert_equal "-9007199254740992" [r json.incrby tairdockey -1]
+        assert_equal "OK" [r json.set tairdockey "" {-9223372036854775807}]
+        assert_equal "-9223372036854775808" [r json.incrby tairdockey -1]
     }
 
-    test {json.incrby min} {
-        # range is [-2^53, 2^53] [-9007199254740992, 9007199254740992]
+    test {json.incrby overflow} {
         r del tairdockey
-        assert_equal "OK" [r json.set tairdockey "" {-9007199254740991}]
-        assert_equal "-9.00719925474099e+15" [r json.incrby tairdockey -1]
+        assert_equal "OK" [r json.set tairdockey "" {9223372036854775807}]
+        catch {r json.incrby tairdockey 1} err
+        assert_match {*ERR increment or decrement would overflow*} $err
+        assert_equal "OK" [r json.set tairdockey "" {-9223372036854775808}]
+        catch {r json.incrby tairdockey -1} err
+        assert_match {*ERR increment or decrement would overflow*} $err
+        assert_equal "-9223372036854775808" [r json.get tairdockey]
+    }
+
+    test {json.incrby keeps large integers exact} {
+        r del tairdockey
+        assert_equal "OK" [r json.set tairdockey "" {{"id":1234567890123456789}}]
+        assert_equal "1234567890123456790" [r json.incrby tairdockey /id 1]
+        assert_equal {{"id":1234567890123456790}} [r json.get tairdockey]
+        assert_equal "1.2345678901234568e+18" [r json.incrbyfloat tairdockey /id 0.5]
     }
 
     test {json.incrbyfloat zero} {
@@ -767,6 +824,27 @@ start_server {tags {"tairdoc"} overrides {bind 0.0.0.0}} {
         assert_equal {[2,3]} [r json.get tairdockey]
     }
 
+    test {json.arrinsert is all or nothing} {
+        r del tairdockey
+        assert_equal "OK" [r json.set tairdockey "" {[1, 2, 3]}]
+        catch {r json.arrinsert tairdockey "" 1 4 {"bad} 5} err
+        assert_match {*ERR*} $err
+        assert_equal {[1,2,3]} [r json.get tairdockey]
+    }
+
+    test {json.arrtrim long array} {
+        r del tairdockey
+        set items {}
+        for {set i 0} {$i < 100000} {incr i} {
+            lappend items $i
+        }
+        assert_equal "OK" [r json.set tairdockey "" "\[[join $items ,]\]"]
+        assert_equal 10 [r json.arrtrim tairdockey "" 50000 50009]
+        assert_equal {[50000,50001,50002,50003,50004,50005,50006,50007,50008,50009]} [r json.get tairdockey]
+        assert_equal 12 [r json.arrinsert tairdockey "" 5 {"a"} {"b"}]
+        assert_equal {"b"} [r json.get tairdockey /6]
+    }
+
     # -------------------------------------------------
     # tairdoc rdb and aof
     # -------------------------------------------------
@@ -781,6 +859,53 @@ start_server {tags {"tairdoc"} overrides {bind 0.0.0.0}} {
         assert_equal {{"foo":"bar"}} [r json.get tairdockey]
     }
 
+    test {tairdoc rdb all types} {
+        r del tairdockey
+        set json {{"n":null,"t":true,"f":false,"i":[0,1,-1,127,128,-129,9007199254740992,-9007199254740992,9007199254740993,-9223372036854775808,9223372036854775807],"d":[1.5,-0.0,1e+300,9007199254740994,-3.14159],"s":["","a\"b\\c\n","中文"],"o":{"":{},"x":[]}}}
+        assert_equal "OK" [r json.set tairdockey "" $json]
+        set before [r json.get tairdockey]
+
+        r bgsave
+        waitForBgsave r
+        r debug reload
+
+        assert_equal $before [r json.get tairdockey]
+        assert_equal {number} [r json.type tairdockey /d/1]
+        assert_equal {object} [r json.type tairdockey /o/]
+        assert_equal {array} [r json.type tairdockey /o/x]
+    }
+
+    test {tairdoc rdb document nested to the parser limit} {
+        r del tairdockey
+        set json "[string repeat {[} 1000]1[string repeat {]} 1000]"
+        assert_equal "OK" [r json.set tairdockey "" $json]
+
+        r bgsave
+        waitForBgsave r
+        r debug reload
+
+        assert_equal $json [r json.get tairdockey]
+    }
+
+    test {tairdoc rdb large document} {
+        r del tairdockey
+        set items {}
+        for {set i 0} {$i < 20000} {incr i} {
+            lappend items "{\"id\":$i,\"score\":[expr {$i + 0.25}],\"name\":\"item-$i\"}"
+        }
+        set big [string repeat "abcdefgh" 40000]
+        assert_equal "OK" [r json.set tairdockey "" "{\"big\":\"$big\",\"items\":\[[join $items ,]\]}"]
+        set before [r json.get tairdockey]
+
+        r bgsave
+        waitForBgsave r
+        r debug reload
+
+        assert_equal $before [r json.get tairdockey]
+        assert_equal 320000 [r json.strlen tairdockey /big]
+        assert_equal 20000 [r json.arrlen tairdockey /items]
+    }
+
     test {tairdoc aof} {
         r config set aof-use-rdb-preamble no
         r del tairdockey
@@ -794,6 +919,289 @@ start_server {tags {"tairdoc"} overrides {bind 0.0.0.0}} {
         assert_equal {{"foo":"car"}} [r json.get tairdockey]
     }
 
+    test {tairdoc aof large document} {
+        r config set aof-use-rdb-preamble no
+        r del tairdockey
+        set items {}
+        for {set i 0} {$i < 20000} {incr i} {
+            lappend items "{\"id\":$i,\"name\":\"item-$i\"}"
+        }
+        set members {}
+        for {set i 0} {$i < 3000} {incr i} {
+            lappend members "\"k/~$i\":\[$i,\"v$i\"\]"
+        }
+        set big [string repeat "abc\\\"def" 30000]
+        set json "{\"items\":\[[join $items ,]\],\"big\":\"$big\",\"wide\":{[join $members ,]},\"arr\":\[1,\"$big\",{\"x\":\"$big\"},\[\[\]\],{}\],\"\":{\"/\":\[\]}}"
+        assert_equal "OK" [r json.set tairdockey "" $json]
+        set before [r json.get tairdockey]
+
+        r bgrewriteaof
+        waitForBgrewriteaof r
+        r debug loadaof
+
+        assert_equal $before [r json.get tairdockey]
+        assert_equal 20000 [r json.arrlen tairdockey /items]
+        assert_equal {array} [r json.type tairdockey /wide/k~1~07]
+
+        # members of the same name are kept apart
+        set members {}
+        for {set i 0} {$i < 5000} {incr i} {
+            lappend members "\"k$i\":\"v$i\""
+        }
+        assert_equal "OK" [r json.set tairdockey "" "{\"dup\":{[join $members ,],\"k1\":\"again\"}}"]
+        set before [r json.get tairdockey]
+        r bgrewriteaof
+        waitForBgrewriteaof r
+        r debug loadaof
+        assert_equal $before [r json.get tairdockey]
+        assert_equal 1 [r json.del tairdockey /dup/k1]
+        assert_equal {"again"} [r json.get tairdockey /dup/k1]
+
+        assert_equal "OK" [r json.set tairdockey "" "\"$big\""]
+        r bgrewriteaof
+        waitForBgrewriteaof r
+        r debug loadaof
+
+        assert_equal [expr {[string length $big] - 30000}] [r json.strlen tairdockey ""]
+    }
+
+    # -------------------------------------------------
+    # tairdoc memory usage
+    # -------------------------------------------------
+    test {memory usage} {
+        r del tairdockey
+        assert_equal "OK" [r json.set tairdockey "" {{"arr":[1,2,3]}}]
+        set base [r memory usage tairdockey]
+        assert {$base > 0}
+
+        assert_equal "OK" [r json.set tairdockey /big [format {"%s"} [string repeat x 10000]]]
+        assert {[r memory usage tairdockey] > $base + 10000}
+        assert_equal 1 [r json.del tairdockey /big]
+        assert_equal $base [r memory usage tairdockey]
+
+        assert_equal "OK" [r json.set tairdockey /foo {"bar"}]
+        assert_equal 10003 [r json.strappend tairdockey /foo [string repeat x 10000]]
+        assert {[r memory usage tairdockey] > $base + 10000}
+        assert_equal 1 [r json.del tairdockey /foo]
+        assert_equal $base [r memory usage tairdockey]
+
+        assert_equal 6 [r json.arrpush tairdockey /arr 4 5 6]
+        assert {[r memory usage tairdockey] > $base}
+        assert_equal 3 [r json.arrtrim tairdockey /arr 0 2]
+        assert_equal $base [r memory usage tairdockey]
+
+        r debug reload
+        assert_equal $base [r memory usage tairdockey]
+    }
+
+    test {memory usage json.set moves the value in} {
+        r del tairdockey
+        assert_equal "OK" [r json.set tairdockey "" {{"arr":[1,2,3]}}]
+        set base [r memory usage tairdockey]
+        set big [format {{"s":"%s","a":[1,{"b":2}]}} [string repeat x 10000]]
+
+        assert_equal "OK" [r json.set tairdockey /big $big]
+        set grown [r memory usage tairdockey]
+        assert {$grown > $base + 10000}
+        # the old value is gone, the new one isn't kept twice
+        assert_equal "OK" [r json.set tairdockey /big $big xx]
+        assert {[r memory usage tairdockey] < $grown + 1000}
+        assert_equal "" [r json.set tairdockey /big $big nx]
+        assert {[r memory usage tairdockey] < $grown + 1000}
+
+        assert_equal "OK" [r json.set tairdockey /arr/1 {{"b":3}}]
+        assert_equal {[1,{"b":3},3]} [r json.get tairdockey /arr]
+        catch {r json.set tairdockey /arr/9 {1}} err
+        assert_match {*ERR insert item in array error, index error*} $err
+        catch {r json.set tairdockey /arr/1 {[}} err
+        assert_match {*ERR json lexer error*} $err
+        assert_equal {[1,{"b":3},3]} [r json.get tairdockey /arr]
+
+        assert_equal "OK" [r json.set tairdockey "" $big]
+        assert_equal 10000 [r json.strlen tairdockey /s]
+        assert_equal "OK" [r json.set tairdockey "" {{"arr":[1,2,3]}}]
+        assert_equal $base [r memory usage tairdockey]
+    }
+
+    test {unlink large document is freed lazily} {
+        r del tairdockey
+        set items {}
+        for {set i 0} {$i < 1000} {incr i} {
+            lappend items "{\"id\":$i}"
+        }
+        # grown one node at a time, so every node is a block of its own
+        assert_equal "OK" [r json.set tairdockey "" {[]}]
+        assert_equal 1000 [r json.arrpush tairdockey "" {*}$items]
+
+        set lazyfreed [s lazyfreed_objects]
+        assert_equal 1 [r unlink tairdockey]
+        wait_for_condition 50 100 {
+            [s lazyfreed_objects] == $lazyfreed + 1
+        } else {
+            fail "large document was not freed by the lazyfree thread"
+        }
+    }
+
+    test {unlink large document built in an arena} {
+        r del tairdockey
+        set items {}
+        for {set i 0} {$i < 1000} {incr i} {
+            lappend items "{\"id\":$i}"
+        }
+        assert_equal "OK" [r json.set tairdockey "" "\[[join $items ,]\]"]
+        set before [r memory usage tairdockey]
+        assert_equal 1 [r json.del tairdockey /0]
+        assert_equal $before [r memory usage tairdockey]
+        assert_equal 1000 [r json.arrpush tairdockey "" {{"id":1000}}]
+        assert_equal $before [r memory usage tairdockey]
+
+        # a handful of slabs is cheap enough to be freed right away
+        set lazyfreed [s lazyfreed_objects]
+        assert_equal 1 [r unlink tairdockey]
+        assert_equal $lazyfreed [s lazyfreed_objects]
+    }
+
+    test {member names shared between documents} {
+        r del tairdockey tairdockey2
+        assert_equal "OK" [r json.set tairdockey "" {{"id":1,"name":"a","tags":{"name":"t"}}}]
+        assert_equal "OK" [r json.set tairdockey2 "" {[{"id":2,"name":"b"},{"id":3,"name":"c"}]}]
+        assert_equal "string" [r json.type tairdockey /name]
+        assert_equal "number" [r json.type tairdockey2 /1/id]
+        assert_equal {[{"id":3,"name":"c"}]} [r json.get tairdockey2 {$[?(@.id > 2)]}]
+
+        # names outlive the document that used them first
+        assert_equal 1 [r del tairdockey]
+        assert_equal "OK" [r json.set tairdockey2 /0/name {"renamed"}]
+        assert_equal {[{"id":2,"name":"renamed"},{"id":3,"name":"c"}]} [r json.get tairdockey2]
+        assert_equal "OK" [r json.set tairdockey2 "" {{"name":{"id":4}}}]
+        r debug reload
+        assert_equal {{"name":{"id":4}}} [r json.get tairdockey2]
+        assert_equal "object" [r json.type tairdockey2 /name]
+    }
+
+    test {wide object members are found through the index} {
+        r del tairdockey
+        set members {}
+        for {set i 0} {$i < 2000} {incr i} {
+            lappend members "\"k$i\":$i"
+        }
+        assert_equal "OK" [r json.set tairdockey "" "{[join $members ,],\"a/b\":{\"c~d\":1}}"]
+        assert_equal 1999 [r json.get tairdockey /k1999]
+        assert_equal 1 [r json.get tairdockey /a~1b/c~0d]
+        assert_equal "" [r json.type tairdockey /k2000]
+
+        # members added, replaced and deleted keep the index up to date
+        assert_equal "OK" [r json.set tairdockey /k2000 {"new"}]
+        assert_equal {"new"} [r json.get tairdockey /k2000]
+        assert_equal "OK" [r json.set tairdockey /k5 {[5]}]
+        assert_equal {[5]} [r json.get tairdockey /k5]
+        assert_equal 1 [r json.del tairdockey /k7]
+        assert_equal "" [r json.type tairdockey /k7]
+        assert_equal "OK" [r json.set tairdockey /k7 7]
+        assert_equal 7 [r json.get tairdockey /k7]
+        assert_equal {[1500]} [r json.get tairdockey {$.k1500}]
+
+        r debug reload
+        assert_equal {"new"} [r json.get tairdockey /k2000]
+        assert_equal 1 [r json.del tairdockey /k0]
+        assert_equal "" [r json.type tairdockey /k0]
+
+        # the whole document replaced by a wide object
+        assert_equal "OK" [r json.set tairdockey "" "{[join $members ,]}"]
+        assert_equal 42 [r json.get tairdockey /k42]
+        assert_equal "OK" [r json.set tairdockey /k42 43]
+        assert_equal 43 [r json.get tairdockey /k42]
+    }
+
+    test {wide object with duplicate member names} {
+        r del tairdockey
+        set members {}
+        for {set i 0} {$i < 100} {incr i} {
+            lappend members "\"k$i\":$i"
+        }
+        assert_equal "OK" [r json.set tairdockey "" "{[join $members ,],\"k1\":\"again\"}"]
+        assert_equal 1 [r json.get tairdockey /k1]
+        assert_equal 1 [r json.del tairdockey /k1]
+        assert_equal {"again"} [r json.get tairdockey /k1]
+    }
+
+    test {wide array members are found through the index} {
+        r del tairdockey
+        set items {}
+        for {set i 0} {$i < 2000} {incr i} {
+            lappend items $i
+        }
+        assert_equal "OK" [r json.set tairdockey "" "\[[join $items ,]\]"]
+        assert_equal 2000 [r json.arrlen tairdockey]
+        assert_equal 1234 [r json.get tairdockey /1234]
+        assert_equal 1999 [r json.get tairdockey /1999]
+        assert_equal "" [r json.type tairdockey /2000]
+
+        # pushes, pops, inserts and trims keep the index up to date
+        assert_equal 2001 [r json.arrpush tairdockey "" {"end"}]
+        lappend items {"end"}
+        assert_equal 2003 [r json.arrinsert tairdockey "" 0 {"a"} {"b"}]
+        set items [linsert $items 0 {"a"} {"b"}]
+        assert_equal 2005 [r json.arrinsert tairdockey "" 1000 {"c"} {"d"}]
+        set items [linsert $items 1000 {"c"} {"d"}]
+        assert_equal 1500 [r json.arrpop tairdockey "" 1504]
+        set items [lreplace $items 1504 1504]
+        assert_equal {"a"} [r json.arrpop tairdockey "" 0]
+        set items [lreplace $items 0 0]
+        assert_equal {"end"} [r json.arrpop tairdockey ""]
+        set items [lreplace $items end end]
+        assert_equal "OK" [r json.set tairdockey /10 {"x"}]
+        set items [lreplace $items 10 10 {"x"}]
+        assert_equal 1 [r json.del tairdockey /20]
+        set items [lreplace $items 20 20]
+        assert_equal "\[[join $items ,]\]" [r json.get tairdockey]
+        assert_equal {"d"} [r json.get tairdockey /999]
+        assert_equal {[1996]} [r json.get tairdockey {$[1997]}]
+
+        r debug reload
+        assert_equal "\[[join $items ,]\]" [r json.get tairdockey]
+        assert_equal 1900 [r json.arrtrim tairdockey "" 50 1949]
+        set items [lrange $items 50 1949]
+        assert_equal 1900 [r json.arrlen tairdockey]
+        assert_equal [lindex $items 1899] [r json.get tairdockey /1899]
+        assert_equal "\[[join $items ,]\]" [r json.get tairdockey]
+    }
+
+    # activedefrag is only available when the server is built with jemalloc
+    if {[string match {*jemalloc*} [s mem_allocator]] && ![catch {r config set activedefrag no}]} {
+        test {active defrag keeps documents intact} {
+            r del tairdockey
+            set items {}
+            for {set i 0} {$i < 5000} {incr i} {
+                lappend items "{\"id\":$i,\"name\":\"item-$i\",\"tags\":\[\"a\",{\"b\":\[1,2\]}\]}"
+            }
+            assert_equal "OK" [r json.set tairdockey "" "{\"items\":\[[join $items ,]\]}"]
+            # drop every other item so the document's own pages are left sparse
+            for {set i 4999} {$i >= 0} {incr i -2} {
+                assert_equal 1 [r json.del tairdockey /items/$i]
+            }
+            set before [r json.get tairdockey]
+
+            r config set active-defrag-ignore-bytes 1
+            r config set active-defrag-threshold-lower 0
+            r config set active-defrag-cycle-min 65
+            r config set active-defrag-cycle-max 75
+            r config set activedefrag yes
+            wait_for_condition 50 100 {
+                [s active_defrag_hits] > 0 || [s active_defrag_key_hits] > 0
+            } else {
+                fail "active defrag did not move anything"
+            }
+            assert_equal "OK" [r json.set tairdockey /items/0/name {"changed"}]
+            r config set activedefrag no
+
+            assert_equal {"changed"} [r json.get tairdockey /items/0/name]
+            assert_equal 2500 [r json.arrlen tairdockey /items]
+            assert_equal "OK" [r json.set tairdockey /items/0 [lindex $items 0]]
+            assert_equal $before [r json.get tairdockey]
+        }
+    }
+
     # -------------------------------------------------
     # tairdoc dump and restore
     # -------------------------------------------------
@@ -826,6 +1234,61 @@ start_server {tags {"tairdoc"} overrides {bind 0.0.0.0}} {
         assert_equal {{{"foo":"bar"}} {[1,2,3]}} [r json.mget tairdockey tairdockey2 ""]
     }
 
+    test {json.get replies stay whole when the print buffer is reused} {
+        r del tairdockey
+        set big [format {{"s":"%s","a":[1,2]}} [string repeat x 2000000]]
+        assert_equal "OK" [r json.set tairdockey "" $big]
+        assert_equal $big [r json.get tairdockey]
+        assert_equal {[1,2]} [r json.get tairdockey /a]
+        # longer than the length the root was printed to last time
+        assert_equal "OK" [r json.set tairdockey /t [format {"%s"} [string repeat y 300000]]]
+        assert_equal 300002 [string length [r json.get tairdockey /t]]
+        assert_equal [expr {[string length $big] + 300007}] [string length [r json.get tairdockey]]
+        assert_equal {[1,2]} [r json.get tairdockey /a]
+        assert_equal "OK" [r json.set tairdockey "" {{"foo":"bar"}}]
+        assert_equal {{"foo":"bar"}} [r json.get tairdockey]
+        assert_equal {{{"foo":"bar"}}} [r json.mget tairdockey ""]
+    }
+
+    test {json.get caches the text of hot nodes until the next write} {
+        r del tairdockey
+        assert_equal "OK" [r json.set tairdockey "" {{"a":{"n":1},"b":[1,2]}}]
+        set hits [s print_cache_hits]
+        set misses [s print_cache_misses]
+        set mem [r memory usage tairdockey]
+        assert_equal {{"a":{"n":1},"b":[1,2]}} [r json.get tairdockey]
+        assert_equal {{"a":{"n":1},"b":[1,2]}} [r json.get tairdockey]
+        assert_equal $hits [s print_cache_hits]
+        assert {[r memory usage tairdockey] > $mem}
+        assert_equal {{"a":{"n":1},"b":[1,2]}} [r json.get tairdockey]
+        assert_equal {{{"a":{"n":1},"b":[1,2]}}} [r json.mget tairdockey ""]
+        assert_equal [expr {$hits + 2}] [s print_cache_hits]
+        assert_equal [expr {$misses + 2}] [s print_cache_misses]
+
+        # writes that change the tree in place drop the text too
+        assert_equal 2 [r json.incrby tairdockey /a/n 1]
+        assert_equal {{"a":{"n":2},"b":[1,2]}} [r json.get tairdockey]
+        assert_equal $mem [r memory usage tairdockey]
+        assert_equal {{"n":2}} [r json.get tairdockey /a]
+        assert_equal {{"n":2}} [r json.get tairdockey /a]
+        assert_equal 2 [r json.arrpop tairdockey /b]
+        assert_equal {{"n":2}} [r json.get tairdockey /a]
+        assert_equal "OK" [r json.set tairdockey /a/m {true}]
+        assert_equal {{"n":2,"m":true}} [r json.get tairdockey /a]
+        assert_equal {{"n":2,"m":true}} [r json.get tairdockey /a]
+        assert_equal 1 [r json.del tairdockey /a/n]
+        assert_equal {{"m":true}} [r json.get tairdockey /a]
+        assert_equal {{"m":true}} [r json.get tairdockey /a]
+        assert_equal [expr {$hits + 2}] [s print_cache_hits]
+        assert_equal {{"m":true}} [r json.get tairdockey /a]
+        assert_equal [expr {$hits + 3}] [s print_cache_hits]
+
+        # reading another node takes its place
+        assert_equal {[1]} [r json.get tairdockey /b]
+        assert_equal {{"m":true}} [r json.get tairdockey /a]
+        assert_equal [expr {$hits + 3}] [s print_cache_hits]
+    }
+
     # -------------------------------------------------
     # test from RedisJSON
     # -------------------------------------------------
@@ -973,6 +1436,78 @@ start_server {tags {"tairdoc"} overrides {bind 0.0.0.0}} {
         assert_equal {[{"category":"reference","author":"Nigel Rees","title":"Sayings of the Century","price":8.95},{"category":"fiction","author":"Herman Melville","title":"Moby Dick","isbn":"0-553-21311-3","price":8.99}]} [r json.get key "$.store.book\[?(@.price < 10)\]"]
         assert_equal {[{"category":"reference","author":"Nigel Rees","title":"Sayings of the Century","price":8.95},{"category":"fiction","author":"J. R. R. Tolkien","title":"The Lord of the Rings","isbn":"0-395-19395-8","price":22.99},{"category":"fiction","author":"Evelyn Waugh","title":"Sword of Honour","price":12.99}]} [r json.get key "$..book\[?((@.price == 12.99 || $.store.bicycle.price < @.price) || @.category == 'reference')\]"]
     }    
+
+    test {json.get reuses compiled JSONPath selectors} {
+        r del key
+        assert_equal "OK" [r json.set key . {{"book":[{"price":8.95,"isbn":"a"},{"price":12.99}],"bicycle":{"price":19.95}}}]
+        set hits [s selector_cache_hits]
+        set misses [s selector_cache_misses]
+        set path "$.book\[?(@.price < 10 || $.bicycle.price < @.price)\]"
+        assert_equal {[{"price":8.95,"isbn":"a"}]} [r json.get key $path]
+        assert_equal {[{"price":8.95,"isbn":"a"}]} [r json.get key $path]
+        assert_equal "OK" [r json.set key /book/1/price {25}]
+        assert_equal {[{"price":25},{"price":8.95,"isbn":"a"}]} [r json.get key $path]
+        assert_equal {[8.95,25,19.95]} [r json.get key {$..price}]
+        assert_equal [expr {$hits + 2}] [s selector_cache_hits]
+        assert_equal [expr {$misses + 2}] [s selector_cache_misses]
+
+        # paths that don't compile aren't kept
+        set paths [s selector_cache_paths]
+        catch {r json.get key {$.book[?(@.price <)]}} err
+        catch {r json.get key {$.book[?(@.price <)]}} err
+        assert_match {*ERR*} $err
+        assert_equal $paths [s selector_cache_paths]
+        assert_equal [expr {$hits + 2}] [s selector_cache_hits]
+    }
+
+    test {json.get evaluates wide wildcard, descendant and filter queries} {
+        r del key
+        set items {}
+        for {set i 0} {$i < 1000} {incr i} {
+            lappend items "{\"id\":$i,\"tags\":\[\"t$i\"\]}"
+        }
+        assert_equal "OK" [r json.set key . "{\"items\":\[[join $items ,]\],\"id\":-1}"]
+        assert_equal 1000 [llength [split [r json.get key {$.items[*].id}] ,]]
+        assert_equal 1001 [llength [split [r json.get key {$..id}] ,]]
+        assert_equal {[{"id":998,"tags":["t998"]},{"id":999,"tags":["t999"]}]} [r json.get key {$.items[?(@.id > 997)]}]
+        assert_equal {[{"id":0,"tags":["t0"]}]} [r json.get key {$.items[?(@.id < 1 && @.tags)]}]
+        assert_equal {[-1]} [r json.get key {$.id}]
+        assert_equal {[]} [r json.get key {$.items[?(@.id > $.items)]}]
+    }
+
+    test {json.get prints JSONPath results straight from the document} {
+        r del key
+        assert_equal "OK" [r json.set key . {{"a":{"s":"q\"\\u00e9","n":[1.5,-2,1e300,null,true]},"b":[{"a":{}}]}}]
+        set doc [r json.get key]
+        assert_equal "\[$doc\]" [r json.get key {$}]
+        assert_equal "\[{},[r json.get key .a]\]" [r json.get key {$..a}]
+        assert_equal {[]} [r json.get key {$.c}]
+        catch {r json.get key {$.a[}} err
+        assert_match {*ERR*} $err
+        assert_equal $doc [r json.get key]
+    }
+
+    test {json commands reuse compiled JSON pointers} {
+        r del key
+        assert_equal "OK" [r json.set key . {{"a":{"b c":[1,2,3]},"d~e":"x"}}]
+        set hits [s pointer_cache_hits]
+        set misses [s pointer_cache_misses]
+        assert_equal {[1,2,3]} [r json.get key {/a/b c}]
+        assert_equal {[1,2,3]} [r json.get key {.a["b c"]}]
+        assert_equal {3} [r json.arrlen key {/a/b c}]
+        assert_equal {2} [r json.get key {.a['b c'][1]}]
+        assert_equal {"x"} [r json.get key {/d~0e}]
+        assert_equal "OK" [r json.set key {/a/b c/-} 4]
+        assert_equal {[1,2,3,4]} [r json.get key {/a/b c}]
+        assert_equal [expr {$hits + 2}] [s pointer_cache_hits]
+        assert_equal [expr {$misses + 5}] [s pointer_cache_misses]
+
+        # paths that don't convert to a pointer aren't kept
+        set paths [s pointer_cache_paths]
+        catch {r json.get key {.a[b]}} err
+        assert_match {*ERR*} $err
+        assert_equal $paths [s pointer_cache_paths]
+    }
 }
 
 start_server {tags {"ex_json"} overrides {bind 0.0.0.0}} {